@@ -1,12 +1,496 @@
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "core/Graph.h"
+#include "core/Link.h"
+#include "core/Node.h"
+#include "core/Pin.h"
+#include "core/Position.h"
+#include "core/Subgraph.h"
+#include "core/UUID.h"
+#include "python/PythonInterop.h"
+#include "python/PythonNode.h"
+#include "runtime/BuiltinNodes.h"
+#include "runtime/ExecutionStats.h"
+#include "runtime/Executor.h"
+#include "runtime/GraphLayout.h"
+#include "runtime/NodeKernel.h"
+#include "runtime/ResourceCache.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace py = pybind11;
+using namespace MindWeaver;
+
+namespace
+{
+    constexpr size_t kUUIDSize = 16;
+
+    using UUIDArray = py::array_t<uint8_t, py::array::c_style | py::array::forcecast>;
+    using PositionArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+
+    /// @brief Validates an (N, 16) uint8 array of UUID bytes and returns N.
+    size_t CheckUUIDArray(const UUIDArray &ids, const char *arg_name)
+    {
+        if (ids.ndim() != 2 || ids.shape(1) != static_cast<py::ssize_t>(kUUIDSize))
+            throw std::invalid_argument(std::string(arg_name) + " must have shape (N, 16)");
+        return static_cast<size_t>(ids.shape(0));
+    }
+
+    /// @brief Pins of a node in a stable order (by name), used for bulk array layouts.
+    std::vector<std::shared_ptr<Pin>> SortedPins(const PinMap &pins)
+    {
+        std::vector<std::shared_ptr<Pin>> sorted;
+        sorted.reserve(pins.size());
+        for (const auto &pair : pins)
+            sorted.push_back(pair.second);
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const std::shared_ptr<Pin> &a, const std::shared_ptr<Pin> &b) { return a->name.str() < b->name.str(); });
+        return sorted;
+    }
+
+    std::vector<std::string> PinNames(const PinMap &pins)
+    {
+        std::vector<std::string> names;
+        for (const auto &pin : SortedPins(pins))
+            names.push_back(pin->name.str());
+        return names;
+    }
+
+    /// @brief Nodes handed to Python are detached copies: graph nodes are immutable and shared with
+    /// snapshots, so edits must go through the Graph's methods.
+    std::shared_ptr<Node> Detach(const std::shared_ptr<const Node> &node)
+    {
+        return node ? std::make_shared<Node>(*node) : nullptr;
+    }
+
+    /// @brief Creates count instances of a prototype node (same name, type, parameters and pin layout,
+    /// fresh UUIDs) in one call.
+    /// @return (node_ids (N, 16), input_pin_ids (N, I, 16), output_pin_ids (N, O, 16)); pins are in
+    /// the order of prototype.input_pin_names() / output_pin_names().
+    py::tuple AddNodes(Graph &graph, const Node &prototype, const PositionArray &positions)
+    {
+        if (positions.ndim() != 2 || positions.shape(1) != 2)
+            throw std::invalid_argument("positions must have shape (N, 2)");
+        const size_t count = static_cast<size_t>(positions.shape(0));
+
+        const auto proto_inputs = SortedPins(prototype.inputPins);
+        const auto proto_outputs = SortedPins(prototype.outputPins);
+        const py::ssize_t n = static_cast<py::ssize_t>(count);
+        const py::ssize_t uuid_size = static_cast<py::ssize_t>(kUUIDSize);
+
+        UUIDArray node_ids({n, uuid_size});
+        UUIDArray input_ids({n, static_cast<py::ssize_t>(proto_inputs.size()), uuid_size});
+        UUIDArray output_ids({n, static_cast<py::ssize_t>(proto_outputs.size()), uuid_size});
+
+        const float *pos = positions.data();
+        uint8_t *node_out = node_ids.mutable_data();
+        uint8_t *input_out = input_ids.mutable_data();
+        uint8_t *output_out = output_ids.mutable_data();
+
+        // The nodes are built without the GIL (the pool is thread-safe and nothing else sees them
+        // yet), but added with it held: other Python threads may be using the same graph
+        std::vector<std::shared_ptr<Node>> created(count);
+        {
+            py::gil_scoped_release release;
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto node = graph.CreateNode(UUID::generate(), prototype.name, prototype.type);
+                node->parameters = prototype.parameters;
+                node->inputPins.reserve(proto_inputs.size());
+                node->outputPins.reserve(proto_outputs.size());
+                node->SetPosition(Position(pos[2 * i], pos[2 * i + 1]));
+                std::copy_n(node->id.data(), kUUIDSize, node_out + i * kUUIDSize);
+
+                for (size_t p = 0; p < proto_inputs.size(); ++p)
+                {
+                    auto pin = node->AddInputPin(proto_inputs[p]->name, proto_inputs[p]->type);
+                    std::copy_n(pin->id.data(), kUUIDSize, input_out + (i * proto_inputs.size() + p) * kUUIDSize);
+                }
+                for (size_t p = 0; p < proto_outputs.size(); ++p)
+                {
+                    auto pin = node->AddOutputPin(proto_outputs[p]->name, proto_outputs[p]->type);
+                    std::copy_n(pin->id.data(), kUUIDSize, output_out + (i * proto_outputs.size() + p) * kUUIDSize);
+                }
+                created[i] = std::move(node);
+            }
+        }
+        graph.Reserve(graph.GetNodes().size() + count, graph.GetLinks().size());
+        for (auto &node : created)
+            graph.AddNode(std::move(node));
+        return py::make_tuple(node_ids, input_ids, output_ids);
+    }
+
+    /// @brief Creates one link per row of (start_pins, end_pins).
+    /// @return link_ids (N, 16)
+    UUIDArray AddLinks(Graph &graph, const UUIDArray &start_pins, const UUIDArray &end_pins)
+    {
+        const size_t count = CheckUUIDArray(start_pins, "start_pins");
+        if (CheckUUIDArray(end_pins, "end_pins") != count)
+            throw std::invalid_argument("start_pins and end_pins must have the same length");
+
+        UUIDArray link_ids({static_cast<py::ssize_t>(count), static_cast<py::ssize_t>(kUUIDSize)});
+        const uint8_t *starts = start_pins.data();
+        const uint8_t *ends = end_pins.data();
+        uint8_t *out = link_ids.mutable_data();
+        std::vector<std::shared_ptr<Link>> created(count);
+        {
+            // As in AddNodes, only building the links happens without the GIL
+            py::gil_scoped_release release;
+            for (size_t i = 0; i < count; ++i)
+            {
+                created[i] = graph.CreateLink(UUID::generate(), UUID::from_bytes(starts + i * kUUIDSize),
+                                              UUID::from_bytes(ends + i * kUUIDSize));
+                std::copy_n(created[i]->id.data(), kUUIDSize, out + i * kUUIDSize);
+            }
+        }
+        graph.Reserve(graph.GetNodes().size(), graph.GetLinks().size() + count);
+        for (auto &link : created)
+            graph.AddLink(std::move(link));
+        return link_ids;
+    }
+
+    /// @brief Moves many nodes at once. Holds the GIL throughout: the graph is shared with Python.
+    void SetNodePositions(Graph &graph, const UUIDArray &node_ids, const PositionArray &positions)
+    {
+        const size_t count = CheckUUIDArray(node_ids, "node_ids");
+        if (positions.ndim() != 2 || positions.shape(1) != 2 || static_cast<size_t>(positions.shape(0)) != count)
+            throw std::invalid_argument("positions must have shape (N, 2) matching node_ids");
 
-// Expose some functions to Python
-int add(int a, int b) { return a + b; }
+        const uint8_t *ids = node_ids.data();
+        const float *pos = positions.data();
+        for (size_t i = 0; i < count; ++i)
+            graph.SetNodePosition(UUID::from_bytes(ids + i * kUUIDSize), Position(pos[2 * i], pos[2 * i + 1]));
+    }
 
-PYBIND11_MODULE(py_wrapper, m)
+    /// @brief Runs a request against a snapshot of graph; throws on failure.
+    ExecutionResult RunGraph(Executor &executor, const Graph &graph, const std::vector<UUID> &targets,
+                             bool include_side_effects)
+    {
+        ExecutionRequest request;
+        request.targetPins = targets;
+        request.includeSideEffects = include_side_effects;
+        // The snapshot is taken with the GIL held, like any other access to the graph; workers
+        // take the GIL only around batches of Python nodes
+        GraphSnapshot snapshot = graph.Snapshot();
+        ExecutionResult result;
+        {
+            py::gil_scoped_release release;
+            result = executor.Run(snapshot, request);
+        }
+        if (!result.success)
+            throw std::runtime_error(result.error);
+        return result;
+    }
+
+    py::dict OutputsToPython(const ExecutionResult &result)
+    {
+        py::dict outputs;
+        for (const auto &pair : result.outputs)
+            outputs[py::cast(pair.first)] = ToPython(pair.second);
+        return outputs;
+    }
+
+    /// @brief Lays out the graph (or only the nodes in region) and moves its nodes accordingly.
+    void AutoLayout(Graph &graph, const std::vector<UUID> &region)
+    {
+        // Only the computation, on a snapshot, runs without the GIL; the graph is read and moved
+        // with it held
+        GraphSnapshot snapshot = graph.Snapshot();
+        GraphLayout layout;
+        {
+            py::gil_scoped_release release;
+            layout = ComputeGraphLayout(snapshot, region);
+        }
+        ApplyGraphLayout(graph, layout);
+    }
+
+    /// @brief Returns (node_ids (N, 16), positions (N, 2)) in graph order.
+    py::tuple GetNodePositions(const Graph &graph)
+    {
+        const auto &nodes = graph.GetNodes();
+        const py::ssize_t n = static_cast<py::ssize_t>(nodes.size());
+        UUIDArray ids({n, static_cast<py::ssize_t>(kUUIDSize)});
+        PositionArray positions({n, py::ssize_t(2)});
+        uint8_t *id_out = ids.mutable_data();
+        float *pos_out = positions.mutable_data();
+        size_t i = 0;
+        for (const auto &node : nodes)
+        {
+            std::copy_n(node->id.data(), kUUIDSize, id_out + i * kUUIDSize);
+            pos_out[2 * i] = node->position.x;
+            pos_out[2 * i + 1] = node->position.y;
+            ++i;
+        }
+        return py::make_tuple(ids, positions);
+    }
+
+    /// @brief Returns the object cached under (path, params), calling loader() on a miss.
+    /// Objects are accounted at nbytes, else at their nbytes attribute (NumPy arrays, tensors),
+    /// else at sys.getsizeof.
+    py::object AcquireResource(const std::string &path, const py::object &loader, const std::string &params,
+                               size_t nbytes)
+    {
+        std::shared_ptr<py::object> resource;
+        {
+            // Another thread may be running the loader for this key and need the GIL to finish
+            py::gil_scoped_release release;
+            resource = ResourceCache::Instance().Acquire<py::object>(
+                {path, params},
+                [&](size_t &out_bytes)
+                {
+                    py::gil_scoped_acquire gil;
+                    py::object object = loader();
+                    if (nbytes)
+                        out_bytes = nbytes;
+                    else if (py::hasattr(object, "nbytes"))
+                        out_bytes = object.attr("nbytes").cast<size_t>();
+                    else
+                        out_bytes = py::module_::import("sys").attr("getsizeof")(object).cast<size_t>();
+                    // Evictions happen on whichever thread releases the last handle, GIL or not
+                    return std::shared_ptr<py::object>(new py::object(std::move(object)),
+                                                       [](py::object *held)
+                                                       {
+                                                           py::gil_scoped_acquire gil;
+                                                           delete held;
+                                                       });
+                });
+        }
+        return *resource;
+    }
+} // namespace
+
+PYBIND11_MODULE(mindweaver_py, m)
 {
     m.doc() = "Python bindings for Visual Scripting";
-    m.def("add", &add, "A function which adds two numbers");
-    // … expose more of your API/UI as needed …
-}
\ No newline at end of file
+
+    py::class_<UUID>(m, "UUID")
+        .def(py::init<>())
+        .def_static("generate", &UUID::generate)
+        .def_static("from_bytes",
+                    [](py::bytes raw)
+                    {
+                        std::string data = raw;
+                        if (data.size() != kUUIDSize)
+                            throw std::invalid_argument("UUID.from_bytes expects 16 bytes");
+                        return UUID::from_bytes(reinterpret_cast<const uint8_t *>(data.data()));
+                    })
+        .def_property_readonly("bytes", [](const UUID &uuid)
+                               { return py::bytes(reinterpret_cast<const char *>(uuid.data()), kUUIDSize); })
+        .def("__str__", &UUID::to_string)
+        .def("__repr__", [](const UUID &uuid) { return "UUID('" + uuid.to_string() + "')"; })
+        .def("__eq__", [](const UUID &a, const UUID &b) { return a == b; })
+        .def("__hash__", [](const UUID &uuid) { return std::hash<UUID>{}(uuid); });
+
+    py::enum_<PinType>(m, "PinType")
+        .value("Exec", PinType::Exec)
+        .value("Int", PinType::Int)
+        .value("Float", PinType::Float)
+        .value("Bool", PinType::Bool)
+        .value("String", PinType::String)
+        .value("Vector", PinType::Vector)
+        .value("Class", PinType::Class)
+        .value("Buffer", PinType::Buffer);
+
+    py::enum_<PinDirection>(m, "PinDirection").value("Input", PinDirection::Input).value("Output", PinDirection::Output);
+
+    py::enum_<NodeType>(m, "NodeType")
+        .value("ExecutionFlow", NodeType::ExecutionFlow)
+        .value("ControlFlow", NodeType::ControlFlow)
+        .value("Function", NodeType::Function)
+        .value("Variable", NodeType::Variable)
+        .value("Operator", NodeType::Operator);
+
+    py::class_<Position>(m, "Position")
+        .def(py::init<>())
+        .def(py::init<float, float>(), py::arg("x"), py::arg("y"))
+        .def_readwrite("x", &Position::x)
+        .def_readwrite("y", &Position::y);
+
+    py::class_<Pin, std::shared_ptr<Pin>>(m, "Pin")
+        .def_readonly("id", &Pin::id)
+        .def_property_readonly("name", [](const Pin &pin) { return pin.name.str(); })
+        .def_readonly("type", &Pin::type)
+        .def_readonly("direction", &Pin::direction)
+        .def_readonly("owner_node_id", &Pin::ownerNodeID);
+
+    py::class_<Node, std::shared_ptr<Node>>(m, "Node")
+        .def(py::init<UUID, const std::string &, NodeType>(), py::arg("id"), py::arg("name"), py::arg("type"))
+        .def(py::init([](const std::string &name, NodeType type)
+                      { return std::make_shared<Node>(UUID::generate(), name, type); }),
+             py::arg("name"), py::arg("type"))
+        .def_readonly("id", &Node::id)
+        .def_property_readonly("name", [](const Node &node) { return node.name.str(); })
+        .def_readonly("type", &Node::type)
+        .def_readwrite("position", &Node::position)
+        .def_readonly("parameters", &Node::parameters)
+        .def("add_input_pin", [](Node &node, const std::string &name, PinType type) { return node.AddInputPin(name, type); },
+             py::arg("name"), py::arg("type"))
+        .def("add_output_pin", [](Node &node, const std::string &name, PinType type) { return node.AddOutputPin(name, type); },
+             py::arg("name"), py::arg("type"))
+        .def("set_parameter", &Node::SetParameter, py::arg("name"), py::arg("value"))
+        .def_property_readonly("input_pins", [](const Node &node) { return SortedPins(node.inputPins); })
+        .def_property_readonly("output_pins", [](const Node &node) { return SortedPins(node.outputPins); })
+        .def("input_pin_names", [](const Node &node) { return PinNames(node.inputPins); })
+        .def("output_pin_names", [](const Node &node) { return PinNames(node.outputPins); });
+
+    py::class_<Link, std::shared_ptr<Link>>(m, "Link")
+        .def(py::init<UUID, UUID, UUID>(), py::arg("id"), py::arg("start_pin_id"), py::arg("end_pin_id"))
+        .def_readonly("id", &Link::id)
+        .def_readonly("start_pin_id", &Link::startPinID)
+        .def_readonly("end_pin_id", &Link::endPinID);
+
+    py::class_<Graph, std::shared_ptr<Graph>>(m, "Graph")
+        .def(py::init<const std::string &>(), py::arg("name"))
+        .def_property_readonly("name", &Graph::GetName)
+        .def_property_readonly("version", &Graph::GetVersion)
+        // The graph keeps its own copy so later edits to the Python object cannot reach snapshots
+        .def("add_node", [](Graph &graph, const Node &node) { graph.AddNode(std::make_shared<Node>(node)); },
+             py::arg("node"))
+        .def("remove_node", &Graph::RemoveNode, py::arg("node_id"))
+        .def("get_node", [](const Graph &graph, const UUID &id) { return Detach(graph.ResolveNode(graph.GetNode(id))); },
+             py::arg("node_id"))
+        .def("set_node_position", &Graph::SetNodePosition, py::arg("node_id"), py::arg("position"))
+        .def("set_node_parameter", &Graph::SetNodeParameter, py::arg("node_id"), py::arg("name"), py::arg("value"))
+        .def("add_link",
+             [](Graph &graph, const UUID &start, const UUID &end)
+             {
+                 auto link = graph.CreateLink(UUID::generate(), start, end);
+                 graph.AddLink(link);
+                 return link->id;
+             },
+             py::arg("start_pin_id"), py::arg("end_pin_id"))
+        .def("remove_link", &Graph::RemoveLink, py::arg("link_id"))
+        .def_property_readonly("nodes",
+                               [](const Graph &graph)
+                               {
+                                   std::vector<std::shared_ptr<Node>> nodes;
+                                   nodes.reserve(graph.GetNodes().size());
+                                   for (const auto &node : graph.GetNodes())
+                                       nodes.push_back(Detach(graph.ResolveNode(node)));
+                                   return nodes;
+                               })
+        .def_property_readonly("links",
+                               [](const Graph &graph)
+                               {
+                                   std::vector<std::shared_ptr<Link>> links;
+                                   links.reserve(graph.GetLinks().size());
+                                   for (const auto &link : graph.GetLinks())
+                                       links.push_back(std::make_shared<Link>(*link));
+                                   return links;
+                               })
+        .def("__len__", [](const Graph &graph) { return graph.GetNodes().size(); })
+        // Bulk construction: one call per batch instead of one per object
+        .def("add_nodes", &AddNodes, py::arg("prototype"), py::arg("positions"),
+             "Instantiate `prototype` once per row of `positions` (float32, shape (N, 2)).\n"
+             "Returns (node_ids, input_pin_ids, output_pin_ids) as uint8 arrays of shape (N, 16), (N, I, 16)\n"
+             "and (N, O, 16); pin columns follow prototype.input_pin_names() / output_pin_names().")
+        .def("add_links", &AddLinks, py::arg("start_pins"), py::arg("end_pins"),
+             "Create one link per row of the (N, 16) uint8 pin ID arrays. Returns the (N, 16) link IDs.")
+        .def("set_node_positions", &SetNodePositions, py::arg("node_ids"), py::arg("positions"))
+        .def("auto_layout", &AutoLayout, py::arg("region") = std::vector<UUID>(),
+             "Arrange the nodes in left-to-right layers (only the nodes in `region` when given).")
+        .def("collapse_to_subgraph",
+             [](Graph &graph, const std::vector<UUID> &node_ids, const std::string &name) -> py::object
+             {
+                 auto node = CollapseToSubgraph(graph, node_ids, Symbol(name));
+                 return node ? py::cast(node->id) : py::none();
+             },
+             py::arg("node_ids"), py::arg("name") = "Subgraph",
+             "Replace the nodes by one subgraph node wired to the rest of the graph. Returns its ID.")
+        .def("expand_subgraph", &ExpandSubgraph, py::arg("node_id"),
+             "Replace a subgraph node by its body. Returns the IDs of the nodes added.")
+        .def("node_positions", &GetNodePositions, "Returns (node_ids (N, 16), positions (N, 2)) in graph order.");
+
+    py::class_<KernelRegistry, std::shared_ptr<KernelRegistry>>(m, "KernelRegistry")
+        .def(py::init<>())
+        .def("register_builtin_nodes", [](KernelRegistry &registry) { RegisterBuiltinNodes(registry); },
+             "Register the C++ node kinds (Add, Subtract, Multiply, Divide, Concatenate, Load File).")
+        .def("register_python",
+             [](KernelRegistry &registry, const std::string &name, py::object fn, bool side_effects, bool cpu_bound)
+             {
+                 PythonNodeOptions options;
+                 options.sideEffects = side_effects;
+                 options.cpuBound = cpu_bound;
+                 RegisterPythonNode(registry, name, std::move(fn), options);
+             },
+             py::arg("name"), py::arg("fn"), py::arg("side_effects") = false, py::arg("cpu_bound") = false,
+             "Implement nodes named `name` with `fn(**inputs_and_parameters)`. Set cpu_bound=True to run a\n"
+             "picklable `fn` in a worker process so that several such nodes execute in parallel.");
+
+    py::class_<Executor>(m, "Executor")
+        .def(py::init(
+                 [](std::shared_ptr<KernelRegistry> registry, size_t worker_count, bool collect_stats)
+                 {
+                     auto executor = std::make_unique<Executor>(std::move(registry), worker_count);
+                     executor->SetInterpreterLock(std::make_shared<PythonGilLock>());
+                     executor->SetCollectStats(collect_stats);
+                     return executor;
+                 }),
+             py::arg("registry"), py::arg("worker_count") = 0, py::arg("collect_stats") = false)
+        .def("run",
+             [](Executor &executor, const Graph &graph, const std::vector<UUID> &targets, bool include_side_effects)
+             { return OutputsToPython(RunGraph(executor, graph, targets, include_side_effects)); },
+             py::arg("graph"), py::arg("targets") = std::vector<UUID>{}, py::arg("include_side_effects") = true,
+             "Run the graph and return {pin_id: value} for the requested target pins.")
+        .def("profile",
+             [](Executor &executor, const Graph &graph, const std::vector<UUID> &targets, bool include_side_effects)
+             {
+                 ExecutionResult result = RunGraph(executor, graph, targets, include_side_effects);
+                 auto stats = std::make_shared<ExecutionStats>(std::move(result.stats));
+                 return py::make_tuple(OutputsToPython(result), stats);
+             },
+             py::arg("graph"), py::arg("targets") = std::vector<UUID>{}, py::arg("include_side_effects") = true,
+             "Like run(), but returns (outputs, ExecutionStats). The stats are empty unless the executor\n"
+             "was created with collect_stats=True.");
+
+    py::class_<ExecutionStats, std::shared_ptr<ExecutionStats>>(m, "ExecutionStats")
+        .def(py::init<>())
+        .def_property_readonly("runs", &ExecutionStats::GetRunCount)
+        .def("node",
+             [](const ExecutionStats &stats, const UUID &node_id) -> py::object
+             {
+                 const NodeStats *node = stats.Find(node_id);
+                 if (!node)
+                     return py::none();
+                 py::dict out;
+                 out["name"] = node->name.str();
+                 out["calls"] = node->calls;
+                 out["wall_ns"] = node->wallNs;
+                 out["max_wall_ns"] = node->maxWallNs;
+                 out["cpu_ns"] = node->cpuNs;
+                 out["bytes_allocated"] = node->bytesAllocated;
+                 out["cache_hits"] = node->cacheHits;
+                 return out;
+             },
+             py::arg("node_id"), "Totals of one node as a dict, or None if it did not run.")
+        .def("merge", &ExecutionStats::Merge, py::arg("other"), "Add the stats of another run to these.")
+        .def("to_csv", &ExecutionStats::ToCSV)
+        .def("to_json", &ExecutionStats::ToJSON)
+        .def("save", &ExecutionStats::Save, py::arg("path"), "Write JSON if path ends in .json, CSV otherwise.");
+
+    py::class_<ResourceCacheStats>(m, "ResourceCacheStats")
+        .def_readonly("hits", &ResourceCacheStats::hits)
+        .def_readonly("misses", &ResourceCacheStats::misses)
+        .def_readonly("evictions", &ResourceCacheStats::evictions)
+        .def_readonly("bytes_resident", &ResourceCacheStats::bytesResident)
+        .def_readonly("bytes_pinned", &ResourceCacheStats::bytesPinned)
+        .def_readonly("budget_bytes", &ResourceCacheStats::budgetBytes)
+        .def_readonly("entry_count", &ResourceCacheStats::entryCount);
+
+    // The process-wide cache C++ kernels load into (ExecutionContext::GetResourceCache()), so
+    // Python nodes can keep models and tokenizers loaded across runs too
+    m.def("acquire_resource", &AcquireResource, py::arg("path"), py::arg("loader"), py::arg("params") = "",
+          py::arg("nbytes") = 0,
+          "Return the object cached for (path, params), calling loader() to create it on a miss. Later\n"
+          "runs get the same object without calling loader again, until it is evicted.");
+    m.def("resource_cache_stats", [] { return ResourceCache::Instance().GetStats(); });
+    m.def("set_resource_cache_budget", [](size_t bytes) { ResourceCache::Instance().SetBudget(bytes); },
+          py::arg("bytes"), "Change the cache's memory budget, evicting unused entries if now over it.");
+    m.def("trim_resource_cache", [] { ResourceCache::Instance().Trim(); }, "Evict every unused entry.");
+}
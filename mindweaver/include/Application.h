@@ -1,5 +1,10 @@
 #pragma once
 
+#include "runtime/Executor.h"
+#include "runtime/GraphLayout.h"
+#include "runtime/ProcessExecutor.h"
+
+#include <future>
 #include <memory>
 #include <string>
 
@@ -11,6 +16,11 @@ namespace MindWeaver
     // Forward declare your panel and core data structures
     class NodeEditorPanel;
     class Graph;
+    class ExecutionEventChannel;
+    class KernelRegistry;
+    class NodeCatalog;
+    class PythonRuntime;
+    class GraphAutosave;
 
     class Application
     {
@@ -27,6 +37,15 @@ namespace MindWeaver
         bool InitWindow();
         bool InitImGui();
 
+        void AddSampleNodes();
+
+        void StartExecution(bool in_processes = false);
+        void PollExecution();
+        void ExportExecutionStats(bool as_json);
+
+        void StartLayout(std::vector<UUID> region);
+        void PollLayout();
+
         void MainLoop();
         void NewFrame();
         void RenderFrame();
@@ -38,7 +57,19 @@ namespace MindWeaver
         int m_Height;
         const char *m_GlslVersion = "#version 330";
 
+        std::unique_ptr<PythonRuntime> m_PythonRuntime;
         std::shared_ptr<Graph> m_GraphInstance;
+        std::unique_ptr<GraphAutosave> m_Autosave;
+        std::shared_ptr<ExecutionEventChannel> m_ExecutionEvents;
+        std::shared_ptr<KernelRegistry> m_KernelRegistry;
+        std::shared_ptr<NodeCatalog> m_NodeCatalog;
+        std::unique_ptr<Executor> m_Executor;
+        std::unique_ptr<ProcessExecutor> m_ProcessExecutor;
+        std::future<ExecutionResult> m_PendingRun;
+        std::shared_ptr<const ExecutionStats> m_LastRunStats;
+        std::future<GraphLayout> m_PendingLayout;
+        GraphLayout m_Layout;        // Finished layout being applied, a batch per frame
+        size_t m_LayoutApplied = 0;
         std::unique_ptr<NodeEditorPanel> m_NodeEditorPanelInstance;
     };
 
@@ -1,102 +1,354 @@
 #pragma once
 
+#include "GraphMutation.h"
+#include "GraphSnapshot.h"
 #include "Link.h"
 #include "Node.h"
+#include "ObjectPool.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // Project Namespace
 namespace MindWeaver
 {
 
+    /// @brief The editable node graph.
+    ///
+    /// Nodes and links are stored as immutable objects in structurally shared lists, and every
+    /// mutation goes through the Graph so it can copy-on-write whatever a snapshot still references.
+    /// The Graph itself is owned by the UI thread; use Snapshot() to hand a consistent version of
+    /// it to another thread.
     class Graph
     {
     public:
-        Graph(const std::string &graph_name) : name(graph_name) {}
+        Graph(const std::string &graph_name) : name(graph_name), pool(std::make_shared<ObjectPool>()) {}
 
+        /// @brief Creates a graph holding the state of a snapshot (sharing its nodes and links).
+        explicit Graph(const GraphSnapshot &snapshot)
+            : name(snapshot.name), nodes(snapshot.nodes), links(snapshot.links), version(snapshot.version),
+              node_source(snapshot.nodeSource), pool(std::make_shared<ObjectPool>())
+        {
+            node_index.reserve(nodes.size());
+            link_index.reserve(links.size());
+            size_t i = 0;
+            for (const auto &node : nodes)
+                node_index[node->id] = i++;
+            i = 0;
+            for (const auto &link : links)
+                link_index[link->id] = i++;
+        }
+
+        /// @brief Installs the callback notified of every subsequent mutation (one listener; pass
+        /// nullptr to remove it). Used for autosave; the listener must be cheap since it runs on the
+        /// mutating thread.
+        void SetMutationListener(GraphMutationListener listener) { mutation_listener = std::move(listener); }
+
+        /// @brief Allocates a node (and, through it, its pins) from the graph's pool. The node is not
+        /// part of the graph until passed to AddNode().
+        std::shared_ptr<Node> CreateNode(const UUID &node_id, Symbol node_name, NodeType node_type) const
+        {
+            return MakePooled<Node>(pool, node_id, node_name, node_type, pool);
+        }
+
+        /// @brief Allocates a link from the graph's pool; add it with AddLink().
+        std::shared_ptr<Link> CreateLink(const UUID &link_id, const UUID &start_pin_id, const UUID &end_pin_id) const
+        {
+            return MakePooled<Link>(pool, link_id, start_pin_id, end_pin_id);
+        }
+
+        /// @brief The pool backing CreateNode() and CreateLink(), for bulk builders.
+        const std::shared_ptr<ObjectPool> &GetPool() const { return pool; }
+
+        /// @brief Adds a node to the graph. The graph takes ownership of the node; it must not be
+        /// modified through the passed pointer afterwards (use the Graph's mutators instead).
         void AddNode(std::shared_ptr<Node> node)
         {
             if (node)
             {
-                nodes.push_back(node);
-                node_map[node->id] = node;
+                node_index[node->id] = nodes.size();
+                nodes.push_back(std::move(node));
+                ++version;
+                ++topology_version;
+                if (mutation_listener)
+                {
+                    GraphMutation mutation = MakeMutation(GraphMutationKind::AddNode);
+                    mutation.node = nodes.back();
+                    mutation_listener(mutation);
+                }
             }
         }
 
         void RemoveNode(const UUID &node_id)
         {
-            nodes.erase(std::remove_if(nodes.begin(), nodes.end(),
-                                       [&](const std::shared_ptr<Node> &n) { return n && n->id == node_id; }),
-                        nodes.end());
-            node_map.erase(node_id);
-            // Also remove links connected to this node
-            RemoveLinksConnectedToNode(node_id);
+            auto it = node_index.find(node_id);
+            if (it == node_index.end())
+                return;
+
+            // Also remove links connected to this node (a placeholder's pins have to be loaded first)
+            std::unordered_set<UUID> node_pins;
+            CollectPins(*ResolveNode(nodes[it->second]), node_pins);
+            RemoveLinksTouching(node_pins);
+            EraseNode(node_id);
+        }
+
+        /// @brief Removes several nodes and their links, scanning the links once for all of them.
+        void RemoveNodes(const std::vector<UUID> &node_ids)
+        {
+            std::unordered_set<UUID> node_pins;
+            for (const auto &node_id : node_ids)
+            {
+                auto it = node_index.find(node_id);
+                if (it != node_index.end())
+                    CollectPins(*ResolveNode(nodes[it->second]), node_pins);
+            }
+            RemoveLinksTouching(node_pins);
+            for (const auto &node_id : node_ids)
+                EraseNode(node_id);
+        }
+
+        /// @brief Returns the node with the given ID (possibly a placeholder; see ResolveNode()).
+        std::shared_ptr<const Node> GetNode(const UUID &node_id) const
+        {
+            auto it = node_index.find(node_id);
+            return (it != node_index.end()) ? nodes[it->second] : nullptr;
+        }
+
+        /// @brief Returns node itself, or the fully loaded version of a placeholder without storing it.
+        std::shared_ptr<const Node> ResolveNode(const std::shared_ptr<const Node> &node) const
+        {
+            if (!node || !node->placeholder || !node_source)
+                return node;
+            return node_source->Load(*node);
+        }
+
+        /// @brief Replaces a placeholder by its fully loaded node (e.g. when it scrolls into view).
+        /// The topology version is left alone: a view that materializes nodes updates its own data
+        /// for them rather than rebuilding everything.
+        /// @return true if the node was a placeholder.
+        bool MaterializeNode(const UUID &node_id)
+        {
+            auto it = node_index.find(node_id);
+            if (it == node_index.end() || !nodes[it->second]->placeholder || !node_source)
+                return false;
+            nodes.set(it->second, node_source->Load(*nodes[it->second]));
+            ++version; // Not a logical edit, so listeners are not told
+            return true;
+        }
+
+        /// @brief Moves a node. Only the node itself is copied (snapshots keep the old one).
+        void SetNodePosition(const UUID &node_id, const Position &pos2D)
+        {
+            auto it = node_index.find(node_id);
+            if (it == node_index.end())
+                return;
+            nodes.update(it->second, [&](Node &node) { node.SetPosition(pos2D); });
+            ++version;
+            if (mutation_listener)
+            {
+                GraphMutation mutation = MakeMutation(GraphMutationKind::SetNodePosition);
+                mutation.targetID = node_id;
+                mutation.position = pos2D;
+                mutation_listener(mutation);
+            }
+        }
+
+        /// @brief Sets (or replaces) a node parameter on a copy of the node.
+        void SetNodeParameter(const UUID &node_id, const std::string &param_name, const std::string &value)
+        {
+            auto it = node_index.find(node_id);
+            if (it == node_index.end())
+                return;
+            if (nodes[it->second]->placeholder && node_source)
+            {
+                nodes.set(it->second, node_source->Load(*nodes[it->second]));
+                ++topology_version;
+            }
+            nodes.update(it->second, [&](Node &node) { node.SetParameter(param_name, value); });
+            ++version;
+            if (mutation_listener)
+            {
+                GraphMutation mutation = MakeMutation(GraphMutationKind::SetNodeParameter);
+                mutation.targetID = node_id;
+                mutation.paramName = param_name;
+                mutation.paramValue = value;
+                mutation_listener(mutation);
+            }
         }
 
-        std::shared_ptr<Node> GetNode(const UUID &node_id) const
+        /// @brief Pre-allocates lookup tables for bulk construction.
+        void Reserve(size_t node_count, size_t link_count)
         {
-            auto it = node_map.find(node_id);
-            return (it != node_map.end()) ? it->second : nullptr;
+            node_index.reserve(node_count);
+            link_index.reserve(link_count);
         }
 
         void AddLink(std::shared_ptr<Link> link)
         {
             if (link)
             {
-                links.push_back(link);
+                link_index[link->id] = links.size();
+                links.push_back(std::move(link));
+                ++version;
+                ++topology_version;
+                if (mutation_listener)
+                {
+                    GraphMutation mutation = MakeMutation(GraphMutationKind::AddLink);
+                    mutation.link = links.back();
+                    mutation_listener(mutation);
+                }
             }
         }
 
         void RemoveLink(const UUID &link_id)
         {
-            links.erase(std::remove_if(links.begin(), links.end(),
-                                       [&](const std::shared_ptr<Link> &l) { return l && l->id == link_id; }),
-                        links.end());
+            auto it = link_index.find(link_id);
+            if (it == link_index.end())
+                return;
+
+            const size_t index = it->second;
+            link_index.erase(it);
+            if (index + 1 != links.size())
+                link_index[links.back()->id] = index;
+            links.swap_remove(index);
+            ++version;
+            ++topology_version;
+            NotifyTarget(GraphMutationKind::RemoveLink, link_id);
+        }
+
+        /// @brief Re-applies a recorded mutation (crash recovery, replicas) and adopts its version.
+        /// Mutations that no longer apply (e.g. removing a node that is gone) only update the version.
+        void ApplyMutation(const GraphMutation &mutation)
+        {
+            switch (mutation.kind)
+            {
+            case GraphMutationKind::AddNode:
+                if (mutation.node && !node_index.count(mutation.node->id))
+                {
+                    node_index[mutation.node->id] = nodes.size();
+                    nodes.push_back(mutation.node);
+                    ++topology_version;
+                }
+                break;
+            case GraphMutationKind::RemoveNode:
+                RemoveNode(mutation.targetID);
+                break;
+            case GraphMutationKind::SetNodePosition:
+                SetNodePosition(mutation.targetID, mutation.position);
+                break;
+            case GraphMutationKind::SetNodeParameter:
+                SetNodeParameter(mutation.targetID, mutation.paramName, mutation.paramValue);
+                break;
+            case GraphMutationKind::AddLink:
+                if (mutation.link && !link_index.count(mutation.link->id))
+                {
+                    link_index[mutation.link->id] = links.size();
+                    links.push_back(mutation.link);
+                    ++topology_version;
+                }
+                break;
+            case GraphMutationKind::RemoveLink:
+                RemoveLink(mutation.targetID);
+                break;
+            }
+            version = mutation.version;
         }
 
-        const std::vector<std::shared_ptr<Node>> &GetNodes() const { return nodes; }
-        const std::vector<std::shared_ptr<Link>> &GetLinks() const { return links; }
+        /// @brief Returns an immutable view of the current graph state in O(1).
+        GraphSnapshot Snapshot() const
+        {
+            GraphSnapshot snapshot;
+            snapshot.name = name;
+            snapshot.nodes = nodes;
+            snapshot.links = links;
+            snapshot.version = version;
+            snapshot.nodeSource = node_source;
+            return snapshot;
+        }
+
+        const NodeList &GetNodes() const { return nodes; }
+        const LinkList &GetLinks() const { return links; }
         const std::string &GetName() const { return name; }
 
+        /// @brief Monotonic counter bumped by every mutation.
+        uint64_t GetVersion() const { return version; }
+
+        /// @brief Counter bumped when nodes or links are added or removed, but not by moves,
+        /// parameter edits or MaterializeNode(). Lets views keep per-node and per-link data in list
+        /// order until it changes.
+        uint64_t GetTopologyVersion() const { return topology_version; }
+
     private:
-        void RemoveLinksConnectedToNode(const UUID &node_id)
+        GraphMutation MakeMutation(GraphMutationKind kind) const
         {
-            links.erase(std::remove_if(links.begin(), links.end(),
-                                       [&](const std::shared_ptr<Link> &link)
-                                       {
-                                           if (!link)
-                                               return false;
-                                           // Check if either end of the link connects to a pin on the removed node
-                                           std::shared_ptr<Node> start_node_owner = GetNodeOwningPin(link->startPinID);
-                                           std::shared_ptr<Node> end_node_owner = GetNodeOwningPin(link->endPinID);
-                                           return (start_node_owner && start_node_owner->id == node_id) ||
-                                                  (end_node_owner && end_node_owner->id == node_id);
-                                       }),
-                        links.end());
+            GraphMutation mutation;
+            mutation.kind = kind;
+            mutation.version = version;
+            return mutation;
         }
 
-        std::shared_ptr<Node> GetNodeOwningPin(const UUID &pin_id) const
+        void NotifyTarget(GraphMutationKind kind, const UUID &target_id)
         {
-            for (const auto &node : nodes)
+            if (!mutation_listener)
+                return;
+            GraphMutation mutation = MakeMutation(kind);
+            mutation.targetID = target_id;
+            mutation_listener(mutation);
+        }
+
+        static void CollectPins(const Node &node, std::unordered_set<UUID> &pins)
+        {
+            for (const auto &pair : node.inputPins)
+                pins.insert(pair.first);
+            for (const auto &pair : node.outputPins)
+                pins.insert(pair.first);
+        }
+
+        void EraseNode(const UUID &node_id)
+        {
+            auto it = node_index.find(node_id);
+            if (it == node_index.end())
+                return;
+            const size_t index = it->second;
+            node_index.erase(it);
+            if (index + 1 != nodes.size())
+                node_index[nodes.back()->id] = index;
+            nodes.swap_remove(index);
+            ++version;
+            ++topology_version;
+            NotifyTarget(GraphMutationKind::RemoveNode, node_id);
+        }
+
+        void RemoveLinksTouching(const std::unordered_set<UUID> &node_pins)
+        {
+            // Check if either end of the link connects to one of the pins
+            if (node_pins.empty())
+                return;
+            std::vector<UUID> doomed;
+            for (const auto &link : links)
             {
-                if (!node)
-                    continue;
-                if (node->GetInputPin(pin_id) || node->GetOutputPin(pin_id))
-                {
-                    return node;
-                }
+                if (link && (node_pins.count(link->startPinID) || node_pins.count(link->endPinID)))
+                    doomed.push_back(link->id);
             }
-            return nullptr;
+            for (const auto &link_id : doomed)
+                RemoveLink(link_id);
         }
 
         std::string name;
-        std::vector<std::shared_ptr<Node>> nodes;
-        std::vector<std::shared_ptr<Link>> links;
-        std::unordered_map<UUID, std::shared_ptr<Node>> node_map; // For quick lookup
+        NodeList nodes;
+        LinkList links;
+        std::unordered_map<UUID, size_t> node_index; // Node ID -> position in nodes, for quick lookup
+        std::unordered_map<UUID, size_t> link_index; // Link ID -> position in links
+        uint64_t version = 0;
+        uint64_t topology_version = 0;
+        std::shared_ptr<const NodeSource> node_source; // Loads placeholders of lazily opened files
+        std::shared_ptr<ObjectPool> pool; // Freed once the graph and every snapshot object from it are gone
+        GraphMutationListener mutation_listener;
     };
 
 } // namespace MindWeaver
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Link.h"
+#include "Node.h"
+#include "Position.h"
+#include "UUID.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Kind of edit recorded by a GraphMutation.
+    enum class GraphMutationKind : uint8_t
+    {
+        AddNode,
+        RemoveNode,
+        SetNodePosition,
+        SetNodeParameter,
+        AddLink,
+        RemoveLink,
+    };
+
+    /// @brief One edit applied to a Graph, in a form that can be logged and replayed.
+    /// Only the fields relevant to the kind are set. Node and link payloads are the immutable
+    /// objects stored in the graph, so recording a mutation never copies a node.
+    struct GraphMutation
+    {
+        GraphMutationKind kind = GraphMutationKind::AddNode;
+        uint64_t version = 0; /// @brief Graph version after the edit.
+
+        std::shared_ptr<const Node> node; /// @brief AddNode
+        std::shared_ptr<const Link> link; /// @brief AddLink
+        UUID targetID;                    /// @brief RemoveNode, RemoveLink, SetNodePosition, SetNodeParameter
+        Position position;                /// @brief SetNodePosition
+        std::string paramName;            /// @brief SetNodeParameter
+        std::string paramValue;           /// @brief SetNodeParameter
+    };
+
+    /// @brief Receives every mutation right after it has been applied, on the mutating thread.
+    using GraphMutationListener = std::function<void(const GraphMutation &)>;
+
+} // namespace MindWeaver
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Link.h"
+#include "Node.h"
+#include "NodeSource.h"
+#include "PersistentVector.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    using NodeList = PersistentVector<Node>; /// @brief Structurally shared list of immutable nodes.
+    using LinkList = PersistentVector<Link>; /// @brief Structurally shared list of immutable links.
+
+    /// @brief An immutable, consistent view of a Graph at one point in time.
+    /// Snapshots share structure with the graph they were taken from, so taking one is O(1) and
+    /// holding one costs nothing until the graph is edited. They are safe to read from any thread
+    /// while the editor keeps mutating the live Graph.
+    struct GraphSnapshot
+    {
+        std::string name;     /// @brief Name of the source graph.
+        NodeList nodes;       /// @brief Nodes at the time of the snapshot.
+        LinkList links;       /// @brief Links at the time of the snapshot.
+        uint64_t version = 0; /// @brief Graph::GetVersion() at the time of the snapshot.
+
+        /// @brief Loads placeholder nodes (nullptr when the graph has none).
+        std::shared_ptr<const NodeSource> nodeSource;
+
+        /// @brief Returns node itself, or the fully loaded version of a placeholder.
+        std::shared_ptr<const Node> Resolve(const std::shared_ptr<const Node> &node) const
+        {
+            if (!node || !node->placeholder || !nodeSource)
+                return node;
+            return nodeSource->Load(*node);
+        }
+
+        /// @brief Returns a snapshot in which every placeholder has been loaded.
+        /// Nodes loaded by earlier calls are shared for as long as someone holds them (see
+        /// NodeSource::Load()); fully loaded snapshots are returned unchanged.
+        GraphSnapshot Materialized() const
+        {
+            GraphSnapshot result = *this;
+            if (!nodeSource)
+                return result;
+            for (size_t i = 0; i < result.nodes.size(); ++i)
+            {
+                if (result.nodes[i]->placeholder)
+                    result.nodes.set(i, nodeSource->Load(*result.nodes[i]));
+            }
+            return result;
+        }
+
+        /// @brief Linear lookup of a node by ID.
+        /// Consumers that look up many nodes should build their own index once per snapshot.
+        std::shared_ptr<const Node> FindNode(const UUID &node_id) const
+        {
+            for (const auto &node : nodes)
+            {
+                if (node && node->id == node_id)
+                    return node;
+            }
+            return nullptr;
+        }
+    };
+
+} // namespace MindWeaver
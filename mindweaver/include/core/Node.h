@@ -1,17 +1,24 @@
 #pragma once
 
+#include "ObjectPool.h"
 #include "Pin.h"
 #include "Position.h"
+#include "Symbol.h"
 #include "UUID.h"
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 /// @brief Project Namespace
 namespace MindWeaver
 {
 
+    struct SubgraphDefinition;
+
     /// @brief Represents different types of nodes in the visual scripting graph.
     enum class NodeType
     {
@@ -23,32 +30,93 @@ namespace MindWeaver
 
     };
 
+    /// @brief Pins of one side of a node, keyed by pin ID.
+    ///
+    /// A flat vector in insertion order: nodes have a handful of pins, so a linear search beats
+    /// hashing, and the entries take one allocation (from the node's pool) instead of one per pin
+    /// plus a bucket array.
+    class PinMap
+    {
+    public:
+        using value_type = std::pair<UUID, std::shared_ptr<Pin>>;
+        using container_type = std::vector<value_type, PoolAllocator<value_type>>;
+        using iterator = container_type::iterator;
+        using const_iterator = container_type::const_iterator;
+
+        explicit PinMap(std::shared_ptr<ObjectPool> pool = nullptr) : m_Pins(PoolAllocator<value_type>(std::move(pool))) {}
+
+        iterator begin() { return m_Pins.begin(); }
+        iterator end() { return m_Pins.end(); }
+        const_iterator begin() const { return m_Pins.begin(); }
+        const_iterator end() const { return m_Pins.end(); }
+        size_t size() const { return m_Pins.size(); }
+        bool empty() const { return m_Pins.empty(); }
+        void reserve(size_t count) { m_Pins.reserve(count); }
+
+        iterator find(const UUID &pin_id)
+        {
+            return std::find_if(m_Pins.begin(), m_Pins.end(), [&](const value_type &item) { return item.first == pin_id; });
+        }
+        const_iterator find(const UUID &pin_id) const { return const_cast<PinMap *>(this)->find(pin_id); }
+        size_t count(const UUID &pin_id) const { return find(pin_id) != end() ? 1 : 0; }
+
+        /// @brief Adds a pin unless one with the same ID exists.
+        std::pair<iterator, bool> emplace(const UUID &pin_id, std::shared_ptr<Pin> pin)
+        {
+            auto it = find(pin_id);
+            if (it != m_Pins.end())
+                return {it, false};
+            m_Pins.emplace_back(pin_id, std::move(pin));
+            return {m_Pins.end() - 1, true};
+        }
+
+    private:
+        container_type m_Pins;
+    };
+
     /// @brief Represents a node in the visual scripting system.
     /// A node may contain inputs, outputs, and properties that are manipulated in the script.
     struct Node
     {
         UUID id;           /// @brief Unique identifier for the node.
-        std::string name;  /// @brief Display name of the node.
+        Symbol name;       /// @brief Display name of the node (interned; also selects its kernel).
         NodeType type;     /// @brief Type of the node (e.g., ControlFlow, Function, Variable, Operator).
         Position position; /// @brief Node position in Workspace
 
-        std::unordered_map<UUID, std::shared_ptr<Pin>> inputPins;  /// @brief Map of input pins.
-        std::unordered_map<UUID, std::shared_ptr<Pin>> outputPins; /// @brief Map of output pins.
+        PinMap inputPins;  /// @brief Map of input pins.
+        PinMap outputPins; /// @brief Map of output pins.
+
+        /// @brief Node parameters (model path, seed, ...) in serialized form, ordered by name.
+        std::map<std::string, std::string> parameters;
+
+        /// @brief True for a node opened lazily from a file whose name, pins and parameters have not
+        /// been loaded yet (only id, type and position are valid). See NodeSource.
+        bool placeholder = false;
+
+        /// @brief Body of a subgraph (macro) node, inlined before execution; null for ordinary
+        /// nodes. See Subgraph.h.
+        std::shared_ptr<const SubgraphDefinition> subgraph;
+
+        /// @brief Pool the node's pins (and copies of the node) are allocated from; null for the
+        /// global heap. Usually the owning graph's (Graph::CreateNode()).
+        std::shared_ptr<ObjectPool> pool;
 
         /// @brief Constructs a new node with the specified ID, name, and type.
         /// @param id Unique identifier for the node.
         /// @param name Name of the node.
         /// @param type Type of the node (e.g., Operator, Function).
-        Node(UUID id, const std::string &name, NodeType type) : id(id), name(name), type(type) {};
+        /// @param node_pool Pool for the node's pins (optional).
+        Node(UUID id, Symbol name, NodeType type, std::shared_ptr<ObjectPool> node_pool = nullptr)
+            : id(id), name(name), type(type), inputPins(node_pool), outputPins(node_pool), pool(std::move(node_pool)) {};
 
         /// @brief Adds an input pin to the node's backend representation.
         /// @param pin_name Logical name of the input pin.
         /// @param pin_type Logical type of data for the input pin.
         /// @return A shared pointer to the newly created input Pin.
-        std::shared_ptr<Pin> AddInputPin(const std::string &pin_name, PinType pin_type)
+        std::shared_ptr<Pin> AddInputPin(Symbol pin_name, PinType pin_type)
         {
             UUID pinID = UUID::generate(); // Generate UUID using your static method
-            auto pin = std::make_shared<Pin>(pinID, pin_name, pin_type, PinDirection::Input, this->id);
+            auto pin = MakePooled<Pin>(pool, pinID, pin_name, pin_type, PinDirection::Input, this->id);
             inputPins.emplace(pinID, pin);
             return pin;
         }
@@ -57,14 +125,19 @@ namespace MindWeaver
         /// @param pin_name Logical name of the output pin.
         /// @param pin_type Logical type of data for the output pin.
         /// @return A shared pointer to the newly created output Pin.
-        std::shared_ptr<Pin> AddOutputPin(const std::string &pin_name, PinType pin_type)
+        std::shared_ptr<Pin> AddOutputPin(Symbol pin_name, PinType pin_type)
         {
             UUID pinID = UUID::generate(); // Generate UUID using your static method
-            auto pin = std::make_shared<Pin>(pinID, pin_name, pin_type, PinDirection::Output, this->id);
+            auto pin = MakePooled<Pin>(pool, pinID, pin_name, pin_type, PinDirection::Output, this->id);
             outputPins.emplace(pinID, pin);
             return pin;
         }
 
+        /// @brief Sets (or replaces) a parameter value.
+        /// @param param_name Name of the parameter.
+        /// @param value Serialized value of the parameter.
+        void SetParameter(const std::string &param_name, const std::string &value) { parameters[param_name] = value; }
+
         /// @brief Set the stored position of the node
         /// @param pos2D Position of the node in ImNodes grid space
         void SetPosition(const Position pos2D) { position = pos2D; }
@@ -87,4 +160,7 @@ namespace MindWeaver
             return (it != outputPins.end()) ? it->second : nullptr;
         }
     };
+
+    /// @brief Copy of a node allocated from the same pool (used by copy-on-write updates).
+    inline std::shared_ptr<Node> CloneShared(const Node &node) { return MakePooled<Node>(node.pool, node); }
 } // namespace MindWeaver
\ No newline at end of file
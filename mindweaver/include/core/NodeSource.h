@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Node.h"
+
+#include <memory>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Name and pin IDs of a node: enough to follow links through it and find its kernel.
+    struct NodeOutline
+    {
+        Symbol name;
+        std::vector<UUID> pinIDs; /// @brief Inputs, then outputs.
+    };
+
+    /// @brief Supplies the full contents of placeholder nodes (see Node::placeholder) on demand.
+    /// Implemented by lazily opened graph files; shared by a Graph and all of its snapshots.
+    class NodeSource
+    {
+    public:
+        virtual ~NodeSource() = default;
+
+        /// @brief Loads the name, pins and parameters of a placeholder. The returned node takes its
+        /// ID, type and position from the placeholder, so edits made before loading are kept. It may
+        /// be shared with earlier callers (sources cache what they decode).
+        /// Must be safe to call from any thread.
+        /// @throws std::runtime_error if the node's data cannot be read.
+        virtual std::shared_ptr<const Node> Load(const Node &placeholder) const = 0;
+
+        /// @brief Reads the name and pin IDs of a placeholder without loading the rest of it, so
+        /// that callers can find the placeholders they need before loading them.
+        /// Must be safe to call from any thread.
+        /// @return false if the source cannot outline nodes (the default); Load() them instead.
+        /// @throws std::runtime_error if the node's data cannot be read.
+        virtual bool Outline(const Node &placeholder, NodeOutline &outline) const
+        {
+            (void)placeholder;
+            (void)outline;
+            return false;
+        }
+    };
+
+} // namespace MindWeaver
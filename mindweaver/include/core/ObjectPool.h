@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Thread-safe pool of small blocks carved from large chunks.
+    ///
+    /// Blocks are grouped in size classes of kGranularity bytes; freed blocks go on a per-class
+    /// free list and are reused by later allocations of the same class. Chunks are only returned
+    /// when the pool is destroyed, in one pass. A graph owns a pool for its nodes, pins and links
+    /// (see PoolAllocator), so building a large graph makes one heap call per chunk instead of one
+    /// per object, and the objects of a graph sit close together in memory.
+    ///
+    /// Only the chunks are released in bulk. Pooled objects are shared (snapshots, plans and Python
+    /// handles may outlive the graph), so each is still destroyed and its block returned when its
+    /// own last reference goes; tearing down a graph costs one destructor call per object either way.
+    /// Node parameter strings are ordinary std::strings and stay on the global heap.
+    class ObjectPool
+    {
+    public:
+        static constexpr size_t kGranularity = alignof(std::max_align_t);
+        static constexpr size_t kMaxBlockSize = 512; // Larger requests go straight to the heap
+        static constexpr size_t kChunkSize = 64 * 1024;
+
+        ObjectPool() = default;
+        ~ObjectPool();
+
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+        /// @brief Returns size bytes aligned to kGranularity.
+        /// @throws std::bad_alloc when the heap is exhausted.
+        void *Allocate(size_t size);
+
+        /// @brief Returns a block obtained from Allocate() with the same size.
+        void Deallocate(void *block, size_t size) noexcept;
+
+        /// @brief Bytes reserved from the heap (chunks only).
+        size_t GetReservedBytes() const;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        static size_t SizeClass(size_t size) { return (size + kGranularity - 1) / kGranularity; }
+
+        // Allocation is serialized by the mutex; freeing only pushes onto a free list, lock-free.
+        // With a single popper at a time the free lists cannot suffer from ABA.
+        mutable std::mutex m_Mutex;
+        std::vector<void *> m_Chunks;
+        char *m_Cursor = nullptr; // Unused tail of the newest chunk
+        char *m_End = nullptr;
+        std::array<std::atomic<FreeBlock *>, kMaxBlockSize / kGranularity + 1> m_FreeLists{};
+    };
+
+    /// @brief Standard allocator drawing from an ObjectPool, for std::allocate_shared and containers.
+    ///
+    /// Every allocation holds a reference to the pool, so the pool (and its chunks) lives until
+    /// the last object allocated from it is released, however long snapshots keep those objects
+    /// around. A default-constructed allocator uses the global heap.
+    template <typename T> class PoolAllocator
+    {
+    public:
+        using value_type = T;
+
+        PoolAllocator() = default;
+        explicit PoolAllocator(std::shared_ptr<ObjectPool> pool) : m_Pool(std::move(pool)) {}
+        template <typename U> PoolAllocator(const PoolAllocator<U> &other) : m_Pool(other.GetPool()) {}
+
+        T *allocate(size_t count)
+        {
+            if (m_Pool && alignof(T) <= ObjectPool::kGranularity)
+                return static_cast<T *>(m_Pool->Allocate(count * sizeof(T)));
+            return static_cast<T *>(::operator new(count * sizeof(T)));
+        }
+
+        void deallocate(T *block, size_t count) noexcept
+        {
+            if (m_Pool && alignof(T) <= ObjectPool::kGranularity)
+                m_Pool->Deallocate(block, count * sizeof(T));
+            else
+                ::operator delete(block);
+        }
+
+        const std::shared_ptr<ObjectPool> &GetPool() const { return m_Pool; }
+
+        template <typename U> bool operator==(const PoolAllocator<U> &other) const { return m_Pool == other.GetPool(); }
+        template <typename U> bool operator!=(const PoolAllocator<U> &other) const { return m_Pool != other.GetPool(); }
+
+    private:
+        std::shared_ptr<ObjectPool> m_Pool;
+    };
+
+    /// @brief Creates a shared object whose control block and storage come from pool (the global
+    /// heap when pool is null).
+    template <typename T, typename... Args>
+    std::shared_ptr<T> MakePooled(const std::shared_ptr<ObjectPool> &pool, Args &&...args)
+    {
+        return std::allocate_shared<T>(PoolAllocator<T>(pool), std::forward<Args>(args)...);
+    }
+
+} // namespace MindWeaver
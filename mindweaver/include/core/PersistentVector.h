@@ -0,0 +1,296 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Copies an element for PersistentVector::update(). Element types overload it (found by
+    /// argument-dependent lookup) to choose where their copies are allocated.
+    template <typename T> std::shared_ptr<T> CloneShared(const T &value) { return std::make_shared<T>(value); }
+
+    namespace Detail
+    {
+        /// @brief A process-wide unique, non-zero owner token for PersistentVector trie nodes.
+        inline uint64_t NextEditToken()
+        {
+            static std::atomic<uint64_t> next{1};
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // namespace Detail
+
+    /// @brief A persistent (structurally shared) vector of immutable elements.
+    ///
+    /// Elements are stored as std::shared_ptr<const T> in the leaves of a 32-way trie. Copying a
+    /// PersistentVector copies only the root pointer, so taking a snapshot is O(1). A mutation
+    /// copies the O(log32 n) trie nodes on the path to the changed slot, unless this vector created
+    /// them since it was last copied: trie nodes carry the edit token of the vector that created
+    /// them, and copying a vector gives both copies a new token, so nodes reachable from a snapshot
+    /// are never written again. Ownership is decided without looking at reference counts, which are
+    /// not a synchronizing read while another thread may be releasing a snapshot. Elements are
+    /// always copied on write (see update()).
+    ///
+    /// A PersistentVector instance is not itself thread-safe, but distinct copies may be read and
+    /// mutated on different threads: a copy never observes mutations made through another copy.
+    template <typename T> class PersistentVector
+    {
+    public:
+        using value_type = std::shared_ptr<const T>;
+
+        static constexpr unsigned kBits = 5;
+        static constexpr size_t kWidth = size_t(1) << kBits;
+        static constexpr size_t kMask = kWidth - 1;
+
+    private:
+        struct TrieNode
+        {
+            uint64_t edit = 0; /// @brief Token of the vector allowed to modify it in place.
+            std::vector<std::shared_ptr<TrieNode>> children; /// @brief Used by branch nodes.
+            std::vector<value_type> values;                  /// @brief Used by leaf nodes.
+        };
+
+    public:
+        /// @brief Forward iterator that caches the current leaf so a full scan is O(n).
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename PersistentVector::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const value_type *;
+            using reference = const value_type &;
+
+            const_iterator() = default;
+            const_iterator(const PersistentVector *vec, size_t index) : m_Vec(vec), m_Index(index) {}
+
+            reference operator*() const
+            {
+                if (!m_Leaf)
+                    m_Leaf = m_Vec->LeafFor(m_Index);
+                return m_Leaf->values[m_Index & kMask];
+            }
+            pointer operator->() const { return &**this; }
+
+            const_iterator &operator++()
+            {
+                if ((++m_Index & kMask) == 0)
+                    m_Leaf = nullptr;
+                return *this;
+            }
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const const_iterator &other) const { return m_Index == other.m_Index; }
+            bool operator!=(const const_iterator &other) const { return m_Index != other.m_Index; }
+
+        private:
+            const PersistentVector *m_Vec = nullptr;
+            size_t m_Index = 0;
+            mutable const TrieNode *m_Leaf = nullptr;
+        };
+
+        PersistentVector() = default;
+
+        PersistentVector(const PersistentVector &other)
+            : m_Root(other.m_Root), m_Shift(other.m_Shift), m_Size(other.m_Size)
+        {
+            other.m_Edit.store(0, std::memory_order_relaxed); // Its nodes are shared from now on
+        }
+
+        PersistentVector(PersistentVector &&other) noexcept
+            : m_Root(std::move(other.m_Root)), m_Shift(other.m_Shift), m_Size(other.m_Size),
+              m_Edit(other.m_Edit.load(std::memory_order_relaxed))
+        {
+            other.m_Shift = 0;
+            other.m_Size = 0;
+            other.m_Edit.store(0, std::memory_order_relaxed);
+        }
+
+        PersistentVector &operator=(const PersistentVector &other)
+        {
+            if (this != &other)
+            {
+                m_Root = other.m_Root;
+                m_Shift = other.m_Shift;
+                m_Size = other.m_Size;
+                m_Edit.store(0, std::memory_order_relaxed);
+                other.m_Edit.store(0, std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        PersistentVector &operator=(PersistentVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                m_Root = std::move(other.m_Root);
+                m_Shift = other.m_Shift;
+                m_Size = other.m_Size;
+                m_Edit.store(other.m_Edit.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                other.m_Shift = 0;
+                other.m_Size = 0;
+                other.m_Edit.store(0, std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        size_t size() const { return m_Size; }
+        bool empty() const { return m_Size == 0; }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_Size); }
+
+        /// @brief Element access, O(log32 n). No bounds checking.
+        const value_type &operator[](size_t index) const { return LeafFor(index)->values[index & kMask]; }
+        const value_type &back() const { return (*this)[m_Size - 1]; }
+
+        /// @brief Appends an element.
+        void push_back(value_type value)
+        {
+            if (m_Root && m_Size == (size_t(1) << (m_Shift + kBits)))
+            {
+                // Root is full: grow the trie by one level
+                auto new_root = std::make_shared<TrieNode>();
+                new_root->edit = GetEditToken();
+                new_root->children.push_back(std::move(m_Root));
+                m_Root = std::move(new_root);
+                m_Shift += kBits;
+            }
+
+            TrieNode *node = MakeUnique(m_Root);
+            for (unsigned level = m_Shift; level > 0; level -= kBits)
+            {
+                const size_t idx = (m_Size >> level) & kMask;
+                if (idx == node->children.size())
+                    node->children.emplace_back();
+                node = MakeUnique(node->children[idx]);
+            }
+            node->values.push_back(std::move(value));
+            ++m_Size;
+        }
+
+        /// @brief Replaces the element at index.
+        void set(size_t index, value_type value) { MutableSlot(index) = std::move(value); }
+
+        /// @brief Applies fn to a copy of the element at index and stores the copy in its place.
+        /// Elements are never edited in place: readers on other threads may hold them.
+        template <typename Fn> void update(size_t index, Fn &&fn)
+        {
+            value_type &slot = MutableSlot(index);
+            auto copy = CloneShared(*slot);
+            fn(*copy);
+            slot = std::move(copy);
+        }
+
+        /// @brief Removes the last element.
+        void pop_back()
+        {
+            if (m_Size == 0)
+                return;
+            PopRecursive(m_Root, m_Shift, m_Size - 1);
+            --m_Size;
+            if (m_Size == 0)
+            {
+                clear();
+                return;
+            }
+            while (m_Shift > 0 && m_Root->children.size() == 1)
+            {
+                std::shared_ptr<TrieNode> child = m_Root->children[0];
+                m_Root = std::move(child);
+                m_Shift -= kBits;
+            }
+        }
+
+        /// @brief Removes the element at index by moving the last element into its place.
+        /// O(log32 n); does not preserve order.
+        void swap_remove(size_t index)
+        {
+            if (index + 1 != m_Size)
+                set(index, back());
+            pop_back();
+        }
+
+        void clear()
+        {
+            m_Root.reset(); // The token stays: no node carries it anymore
+            m_Shift = 0;
+            m_Size = 0;
+        }
+
+    private:
+        const TrieNode *LeafFor(size_t index) const
+        {
+            const TrieNode *node = m_Root.get();
+            for (unsigned level = m_Shift; level > 0; level -= kBits)
+                node = node->children[(index >> level) & kMask].get();
+            return node;
+        }
+
+        /// @brief This vector's edit token, drawing a new one after a copy.
+        uint64_t GetEditToken()
+        {
+            uint64_t edit = m_Edit.load(std::memory_order_relaxed);
+            if (edit == 0)
+            {
+                edit = Detail::NextEditToken();
+                m_Edit.store(edit, std::memory_order_relaxed);
+            }
+            return edit;
+        }
+
+        /// @brief Ensures slot points to a node this vector may modify, copying it otherwise.
+        TrieNode *MakeUnique(std::shared_ptr<TrieNode> &slot)
+        {
+            const uint64_t edit = GetEditToken();
+            if (!slot)
+                slot = std::make_shared<TrieNode>();
+            else if (slot->edit != edit)
+                slot = std::make_shared<TrieNode>(*slot);
+            else
+                return slot.get();
+            slot->edit = edit;
+            return slot.get();
+        }
+
+        value_type &MutableSlot(size_t index)
+        {
+            TrieNode *node = MakeUnique(m_Root);
+            for (unsigned level = m_Shift; level > 0; level -= kBits)
+                node = MakeUnique(node->children[(index >> level) & kMask]);
+            return node->values[index & kMask];
+        }
+
+        /// @brief Removes the last element below slot. Returns true if slot became empty.
+        bool PopRecursive(std::shared_ptr<TrieNode> &slot, unsigned level, size_t index)
+        {
+            TrieNode *node = MakeUnique(slot);
+            if (level == 0)
+            {
+                node->values.pop_back();
+                return node->values.empty();
+            }
+            const size_t idx = (index >> level) & kMask;
+            if (PopRecursive(node->children[idx], level - kBits, index))
+                node->children.pop_back();
+            return node->children.empty();
+        }
+
+        std::shared_ptr<TrieNode> m_Root;
+        unsigned m_Shift = 0;
+        size_t m_Size = 0;
+        mutable std::atomic<uint64_t> m_Edit{0}; /// @brief 0: none drawn since the last copy.
+    };
+
+} // namespace MindWeaver
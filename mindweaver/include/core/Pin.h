@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Symbol.h"
 #include "UUID.h"
 
 /// @brief Project Namespace
@@ -16,6 +17,7 @@ namespace MindWeaver
         String, /// @brief String data pin.
         Vector, /// @brief Vector data pin
         Class,  /// @brief Class data pin
+        Buffer, /// @brief Typed n-dimensional array pin (images, latents); values are Buffer (runtime/Buffer.h).
     };
 
     /// @brief Indicates whether a pin is used for input or output.
@@ -29,7 +31,7 @@ namespace MindWeaver
     struct Pin
     {
         UUID id;                /// @brief Unique identifier for the pin.
-        std::string name;       /// @brief Display name of the pin.
+        Symbol name;            /// @brief Display name of the pin (interned).
         PinType type;           /// @brief The type of the pin (Exec, Int, Float, etc.).
         PinDirection direction; /// @brief The direction of the pin (Input or Output).
         UUID ownerNodeID;       /// @brief ID of the node this pin belongs to.
@@ -40,7 +42,7 @@ namespace MindWeaver
         /// @param pin_type Type of the pin.
         /// @param pin_dir Direction of the pin.
         /// @param node_id ID of the node that owns this pin.
-        Pin(UUID pin_id, const std::string &pin_name, PinType pin_type, PinDirection pin_dir, UUID node_id)
+        Pin(UUID pin_id, Symbol pin_name, PinType pin_type, PinDirection pin_dir, UUID node_id)
             : id(pin_id), name(pin_name), type(pin_type), direction(pin_dir), ownerNodeID(node_id)
         {
             /// @todo Implement any backend-specific initialization for a pin
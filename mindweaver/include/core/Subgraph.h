@@ -0,0 +1,101 @@
+#pragma once
+
+#include "GraphSnapshot.h"
+#include "Link.h"
+#include "Node.h"
+#include "ObjectPool.h"
+#include "Pin.h"
+#include "Symbol.h"
+#include "UUID.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    class Graph;
+
+    /// @brief A pin of a subgraph node, forwarding to a pin of a node in the body.
+    struct SubgraphPort
+    {
+        Symbol name;     /// @brief Name of the subgraph node's pin.
+        PinType type;    /// @brief Type of both pins.
+        UUID innerPinID; /// @brief The body pin the port connects to.
+    };
+
+    /// @brief Nodes and links with every subgraph node replaced by the nodes of its body.
+    struct FlatGraph
+    {
+        std::vector<std::shared_ptr<const Node>> nodes;
+        std::vector<std::shared_ptr<const Link>> links;
+    };
+
+    /// @brief A subgraph body flattened down to ordinary nodes, with its ports resolved to them.
+    struct FlatSubgraph
+    {
+        FlatGraph body;
+        std::vector<UUID> inputPins;  /// @brief Flattened pin behind each input port.
+        std::vector<UUID> outputPins; /// @brief Flattened pin behind each output port.
+    };
+
+    /// @brief The body of a subgraph (macro) node, shared by all of its instances.
+    ///
+    /// A subgraph node is an ordinary Node whose subgraph member points here. Its input and output
+    /// pins correspond, in order, to the definition's inputs and outputs. Bodies may contain further
+    /// subgraph nodes. Definitions are immutable once shared; an edited body is a new definition
+    /// with the same id and a higher version.
+    struct SubgraphDefinition
+    {
+        UUID id;              /// @brief Identity of the subgraph across versions.
+        uint64_t version = 1; /// @brief Bumped by every edit of the body.
+        Symbol name;          /// @brief Name given to its instances.
+        NodeList nodes;
+        LinkList links;
+        std::vector<SubgraphPort> inputs;
+        std::vector<SubgraphPort> outputs;
+
+        /// @brief The body with nested subgraph nodes inlined; computed on first use and then cached
+        /// for the lifetime of this version. Thread-safe.
+        const FlatSubgraph &GetFlattened() const;
+
+    private:
+        mutable std::once_flag flatten_once;
+        mutable std::shared_ptr<const FlatSubgraph> flattened;
+    };
+
+    /// @brief Copy of node and its pins with IDs derived from scope (see UUID::derive), allocated
+    /// from pool. Copying the same node into the same scope always yields the same IDs.
+    std::shared_ptr<Node> CloneInScope(const Node &node, const UUID &scope, const std::shared_ptr<ObjectPool> &pool);
+
+    /// @brief Replaces every subgraph node by a copy of its flattened body scoped to the subgraph
+    /// node's ID, and reconnects the links of the subgraph node's pins to the ports' body pins.
+    /// Ordinary nodes and links that need no rewiring are shared, not copied.
+    /// @param pin_redirects Receives, for every pin of a replaced node, the body pin now standing in
+    /// for it (optional).
+    /// @param node_owners Receives, for every body node copied in, the ID of the subgraph node in
+    /// nodes it was copied for, at any depth of nesting (optional).
+    /// @throws std::runtime_error if a subgraph node's pins do not match its definition's ports.
+    FlatGraph FlattenSubgraphs(const NodeList &nodes, const LinkList &links,
+                               std::unordered_map<UUID, UUID> *pin_redirects = nullptr,
+                               std::unordered_map<UUID, UUID> *node_owners = nullptr);
+
+    /// @brief Moves the given nodes into a new subgraph and puts a subgraph node in their place.
+    ///
+    /// Links between the nodes move into the body. Each body input pin fed from outside becomes an
+    /// input of the subgraph node, and each body output pin read from outside becomes an output;
+    /// the outside links are reconnected to those pins. Body pins left unconnected become ports
+    /// too, so the results of a collapsed sink stay reachable.
+    /// @return The subgraph node, or nullptr if node_ids names no node of graph.
+    std::shared_ptr<const Node> CollapseToSubgraph(Graph &graph, const std::vector<UUID> &node_ids, Symbol name);
+
+    /// @brief Replaces a subgraph node by a copy of its body, scoped to its ID, and reconnects its
+    /// links. Nested subgraph nodes stay collapsed.
+    /// @return IDs of the nodes added (empty if node_id is not a subgraph node).
+    std::vector<UUID> ExpandSubgraph(Graph &graph, const UUID &node_id);
+
+} // namespace MindWeaver
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief An interned string: a 32-bit index into the process-wide symbol table.
+    ///
+    /// Node and pin names repeat heavily (thousands of "Add" nodes with "a", "b", "result" pins), so
+    /// each distinct text is stored once and nodes and pins carry only its ID. Symbols compare and
+    /// hash as integers; str() is a lock-free table lookup. Interned text is never freed.
+    ///
+    /// IDs are only meaningful within one process. Files store their own table of the symbols they
+    /// use (see WriteGraphFile()).
+    class Symbol
+    {
+    public:
+        /// @brief The empty string (ID 0).
+        Symbol() = default;
+
+        /// @brief Interns text (implicit so names can still be written as string literals).
+        Symbol(std::string_view text) : m_ID(Intern(text)) {}
+        Symbol(const std::string &text) : m_ID(Intern(text)) {}
+        Symbol(const char *text) : m_ID(Intern(text)) {}
+
+        /// @brief Index in the process-wide table.
+        uint32_t GetID() const { return m_ID; }
+
+        /// @brief The interned text; the reference stays valid for the lifetime of the process.
+        const std::string &str() const;
+        const char *c_str() const { return str().c_str(); }
+        bool empty() const { return m_ID == 0; }
+
+        /// @brief Number of distinct symbols interned so far (including the empty string).
+        static size_t TableSize();
+
+        friend bool operator==(Symbol a, Symbol b) { return a.m_ID == b.m_ID; }
+        friend bool operator!=(Symbol a, Symbol b) { return a.m_ID != b.m_ID; }
+
+        // Comparisons with plain text compare characters and do not intern
+        friend bool operator==(Symbol a, const std::string &b) { return a.str() == b; }
+        friend bool operator!=(Symbol a, const std::string &b) { return a.str() != b; }
+        friend bool operator==(Symbol a, const char *b) { return a.str() == b; }
+        friend bool operator!=(Symbol a, const char *b) { return a.str() != b; }
+
+    private:
+        static uint32_t Intern(std::string_view text);
+
+        uint32_t m_ID = 0;
+    };
+
+} // namespace MindWeaver
+
+namespace std
+{
+    template <> struct hash<MindWeaver::Symbol>
+    {
+        std::size_t operator()(MindWeaver::Symbol symbol) const noexcept
+        {
+            return static_cast<std::size_t>(symbol.GetID()) * 0x9E3779B97F4A7C15ull;
+        }
+    };
+} // namespace std
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <iomanip>
 #include <random>
 #include <sstream>
@@ -25,8 +27,9 @@ namespace MindWeaver
         static UUID generate()
         {
             UUID uuid;
-            std::random_device rd;
-            std::mt19937_64 gen(rd());
+            // Seed once per thread; constructing a random_device per call dominates bulk creation
+            thread_local std::mt19937_64 gen(
+                (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}());
             std::uniform_int_distribution<uint64_t> dis;
 
             uint64_t high = dis(gen);
@@ -42,6 +45,45 @@ namespace MindWeaver
             return uuid;
         }
 
+        /// @brief Constructs a UUID from its 16 raw bytes.
+        /// @param raw Pointer to 16 bytes in RFC 4122 byte order.
+        /// @return The UUID holding a copy of those bytes.
+        static UUID from_bytes(const uint8_t *raw)
+        {
+            UUID uuid;
+            std::memcpy(uuid.bytes.data(), raw, uuid.bytes.size());
+            return uuid;
+        }
+
+        /// @brief Deterministic ID for the copy of id made inside scope (e.g. a node of a subgraph
+        /// body inlined into an instance): the same pair always yields the same ID, and different
+        /// pairs yield unrelated IDs.
+        static UUID derive(const UUID &scope, const UUID &id)
+        {
+            auto mix = [](uint64_t x)
+            {
+                x += 0x9E3779B97F4A7C15ull; // splitmix64 finalizer
+                x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+                x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+                return x ^ (x >> 31);
+            };
+            uint64_t scope_half[2], id_half[2];
+            std::memcpy(scope_half, scope.bytes.data(), sizeof(scope_half));
+            std::memcpy(id_half, id.bytes.data(), sizeof(id_half));
+            const uint64_t high = mix(id_half[0] ^ mix(scope_half[0] ^ mix(scope_half[1])));
+            const uint64_t low = mix(id_half[1] ^ mix(high ^ scope_half[1]));
+
+            UUID uuid;
+            std::memcpy(uuid.bytes.data(), &high, sizeof(uint64_t));
+            std::memcpy(uuid.bytes.data() + sizeof(uint64_t), &low, sizeof(uint64_t));
+            uuid.bytes[6] = (uuid.bytes[6] & 0x0F) | 0x40; // version 4
+            uuid.bytes[8] = (uuid.bytes[8] & 0x3F) | 0x80; // variant 1
+            return uuid;
+        }
+
+        /// @brief Raw access to the 16 bytes of the UUID.
+        const uint8_t *data() const { return bytes.data(); }
+
         /// @brief Converts the UUID to a standard string representation.
         /// Format: 8-4-4-4-12 hexadecimal characters (e.g., "f47ac10b-58cc-4372-a567-0e02b2c3d479").
         /// @return A human-readable string representation of the UUID.
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "core/UUID.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Appends binary data to a growable byte buffer.
+    /// Used by the graph file and mutation log formats. Values are written in host byte order;
+    /// all supported platforms are little-endian.
+    class BinaryWriter
+    {
+    public:
+        template <typename T> void Write(const T &value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter::Write needs a trivially copyable type");
+            m_Bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void WriteString(const std::string &value)
+        {
+            Write<uint32_t>(static_cast<uint32_t>(value.size()));
+            m_Bytes.append(value);
+        }
+
+        void WriteUUID(const UUID &id) { m_Bytes.append(reinterpret_cast<const char *>(id.data()), 16); }
+
+        /// @brief Appends everything written to another writer.
+        void Append(const BinaryWriter &other) { m_Bytes.append(other.m_Bytes); }
+
+        /// @brief Appends size zero bytes to be filled in later with Patch(); returns their offset.
+        size_t Skip(size_t size)
+        {
+            const size_t offset = m_Bytes.size();
+            m_Bytes.append(size, '\0');
+            return offset;
+        }
+
+        /// @brief Overwrites a previously written value at a byte offset (for back-patched offsets).
+        template <typename T> void Patch(size_t offset, const T &value)
+        {
+            std::memcpy(&m_Bytes[offset], &value, sizeof(T));
+        }
+
+        size_t Size() const { return m_Bytes.size(); }
+        const std::string &Bytes() const { return m_Bytes; }
+        void Clear() { m_Bytes.clear(); }
+
+    private:
+        std::string m_Bytes;
+    };
+
+    /// @brief Bounds-checked reader over a byte range written by BinaryWriter.
+    /// Every read throws std::runtime_error instead of running past the end, so truncated or
+    /// corrupted files are reported rather than crashing.
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const uint8_t *data, size_t size) : m_Data(data), m_Size(size) {}
+
+        template <typename T> T Read()
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "BinaryReader::Read needs a trivially copyable type");
+            T value;
+            std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const uint32_t size = Read<uint32_t>();
+            const uint8_t *bytes = Take(size);
+            return std::string(reinterpret_cast<const char *>(bytes), size);
+        }
+
+        UUID ReadUUID() { return UUID::from_bytes(Take(16)); }
+
+        /// @brief Returns the next size bytes and advances past them.
+        const uint8_t *Take(size_t size)
+        {
+            if (size > m_Size - m_Offset)
+                throw std::runtime_error("Unexpected end of data");
+            const uint8_t *at = m_Data + m_Offset;
+            m_Offset += size;
+            return at;
+        }
+
+        void Seek(size_t offset)
+        {
+            if (offset > m_Size)
+                throw std::runtime_error("Seek past end of data");
+            m_Offset = offset;
+        }
+
+        size_t Offset() const { return m_Offset; }
+        size_t Remaining() const { return m_Size - m_Offset; }
+
+    private:
+        const uint8_t *m_Data;
+        size_t m_Size;
+        size_t m_Offset = 0;
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "core/Graph.h"
+#include "core/GraphMutation.h"
+#include "core/GraphSnapshot.h"
+#include "runtime/MpscQueue.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Tuning of GraphAutosave.
+    struct AutosaveOptions
+    {
+        /// @brief Longest time an edit waits before it is written (edits arriving in the meantime
+        /// are written together).
+        std::chrono::milliseconds flushInterval{500};
+
+        /// @brief Log size that triggers compaction into a fresh graph file.
+        size_t compactAfterBytes = 8 * 1024 * 1024;
+    };
+
+    /// @brief Continuously saves a Graph as a graph file plus an append-only mutation log.
+    ///
+    /// On the UI thread every mutation costs one queue push; a background thread batches them,
+    /// appends them to `<path>.log` and keeps a replica of the graph up to date. When the log grows
+    /// past the compaction threshold the replica is written to `<path>` as a full graph file and the
+    /// log restarts empty. Saving therefore costs in proportion to the size of the edits, not of the
+    /// graph, and the editor never waits for the disk.
+    ///
+    /// Recover() rebuilds the latest saved state from the graph file plus the intact part of its log.
+    class GraphAutosave
+    {
+    public:
+        explicit GraphAutosave(std::string path, AutosaveOptions options = {});
+
+        /// @brief Writes any pending edits and detaches.
+        ~GraphAutosave();
+
+        GraphAutosave(const GraphAutosave &) = delete;
+        GraphAutosave &operator=(const GraphAutosave &) = delete;
+
+        /// @brief Starts saving a graph (UI thread). Its current state is written in the background
+        /// as the new base file, then every later mutation is logged. The graph must outlive the
+        /// autosave or be detached first.
+        /// @param recovered The graph is the unedited result of Recover() for this path. The base file
+        /// is then kept as it is, and later mutations extend its log, so placeholders stay unloaded.
+        void Attach(Graph &graph, bool recovered = false);
+
+        /// @brief Stops observing the graph after writing everything queued so far (UI thread).
+        void Detach();
+
+        /// @brief Blocks until every mutation queued so far is on disk.
+        void Flush();
+
+        /// @brief True if an autosave exists at path.
+        static bool Exists(const std::string &path);
+
+        /// @brief Rebuilds the saved graph: the graph file plus every intact log record made after it.
+        /// A log left over from an older base file is ignored. Nodes the log does not touch come back
+        /// as placeholders that load on demand (see OpenGraphFileLazily()).
+        /// @throws std::runtime_error if the graph file is missing or malformed.
+        static GraphSnapshot Recover(const std::string &path);
+
+        /// @brief Moves an autosave that cannot be recovered out of the way, to `<path>.corrupt`
+        /// (and its log to `<path>.log.corrupt`), so that attaching a graph does not overwrite it.
+        /// @return The path the graph file was moved to.
+        /// @throws std::runtime_error if the files cannot be moved.
+        static std::string SetAside(const std::string &path);
+
+        const std::string &GetPath() const { return m_Path; }
+        std::string GetLogPath() const { return m_Path + ".log"; }
+
+    private:
+        void ThreadMain();
+        void WriteBatch();
+        void Compact();
+        void Resume();
+
+        std::string m_Path;
+        AutosaveOptions m_Options;
+        Graph *m_Graph = nullptr;
+        bool m_Resume = false;
+        MpscQueue<GraphMutation> m_Queue;
+
+        // Owned by the background thread
+        std::unique_ptr<Graph> m_Replica;
+        FILE *m_Log = nullptr;
+        size_t m_LogBytes = 0;
+
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        std::condition_variable m_Flushed;
+        uint64_t m_FlushRequests = 0; // Guarded by m_Mutex
+        uint64_t m_FlushesDone = 0;   // Guarded by m_Mutex
+        bool m_Stop = false;          // Guarded by m_Mutex
+    };
+
+} // namespace MindWeaver
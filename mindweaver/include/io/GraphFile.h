@@ -0,0 +1,146 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+#include "core/Node.h"
+#include "core/NodeSource.h"
+#include "core/Symbol.h"
+#include "core/UUID.h"
+#include "io/BinaryStream.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Layout of a .mwgraph file (all offsets in bytes from the start of the file):
+    ///
+    ///     GraphFileHeader
+    ///     graph name                      (u32 length + bytes)
+    ///     NodeTableEntry x nodeCount      (fixed size, sorted as in the graph)
+    ///     node records                    (name, parameters, pins, subgraph body; see WriteNodeRecord)
+    ///     LinkRecord x linkCount          (fixed size)
+    ///     symbol table                    (u32 count, then count strings)
+    ///
+    /// The node table carries everything needed to place a node (ID, type, position) plus the
+    /// offset of its variable-size record, so a reader can index a file without touching the
+    /// records themselves. Records refer to node and pin names by their index in the file's symbol
+    /// table, which holds each distinct name once.
+    ///
+    /// Files are always written in kFormatVersion; older versions stay readable. Format 1 has no
+    /// symbol table (nor its header field) and spells names out in the records; formats before 3
+    /// have no subgraph bodies.
+    struct GraphFileHeader
+    {
+        static constexpr uint32_t kMagic = 0x4757574D; // "MWWG"
+        static constexpr uint32_t kFormatVersion = 3;
+        static constexpr uint32_t kOldestFormatVersion = 1;
+
+        uint32_t magic = kMagic;
+        uint32_t formatVersion = kFormatVersion;
+        uint64_t fileID = 0; /// @brief Random per write; lets a mutation log name the file it extends.
+        uint64_t graphVersion = 0;
+        uint64_t nodeCount = 0;
+        uint64_t linkCount = 0;
+        uint64_t nodeTableOffset = 0;
+        uint64_t linkTableOffset = 0;
+        uint64_t symbolTableOffset = 0;
+    };
+
+    /// @brief Fixed-size per-node entry of the node table.
+    struct NodeTableEntry
+    {
+        uint8_t id[16];
+        uint32_t type;
+        float x;
+        float y;
+        uint32_t reserved;
+        uint64_t recordOffset;
+        uint64_t recordSize;
+    };
+
+    /// @brief Fixed-size link entry.
+    struct LinkRecord
+    {
+        uint8_t id[16];
+        uint8_t startPinID[16];
+        uint8_t endPinID[16];
+    };
+
+    /// @brief Assigns file-local indices to the symbols written to one file, in first-use order.
+    class SymbolTableWriter
+    {
+    public:
+        uint32_t IndexOf(Symbol symbol)
+        {
+            auto inserted = m_Indices.emplace(symbol, static_cast<uint32_t>(m_Symbols.size()));
+            if (inserted.second)
+                m_Symbols.push_back(symbol);
+            return inserted.first->second;
+        }
+
+        /// @brief Writes the table (u32 count, then each symbol's text).
+        void Write(BinaryWriter &out) const;
+
+    private:
+        std::unordered_map<Symbol, uint32_t> m_Indices;
+        std::vector<Symbol> m_Symbols;
+    };
+
+    /// @brief Reads a table written by SymbolTableWriter::Write, interning every entry.
+    /// @throws std::runtime_error on malformed data.
+    std::vector<Symbol> ReadSymbolTable(BinaryReader &in);
+
+    /// @brief Serializes a node's variable-size data: name, parameters, pins and, for a subgraph
+    /// node, its whole body (nested records included). Names are written as indices allocated from
+    /// symbols.
+    void WriteNodeRecord(BinaryWriter &out, const Node &node, SymbolTableWriter &symbols);
+
+    /// @brief Reads a record written by WriteNodeRecord into a node whose ID, type and position
+    /// are already set. Pins are allocated from node.pool.
+    /// @param symbols The table of the file the record comes from (unused for format 1).
+    /// @param format_version The format of that file.
+    /// @throws std::runtime_error on malformed data.
+    void ReadNodeRecord(BinaryReader &in, Node &node, const std::vector<Symbol> &symbols,
+                        uint32_t format_version = GraphFileHeader::kFormatVersion);
+
+    /// @brief Reads only the name and pin IDs of a record written by WriteNodeRecord, skipping the
+    /// parameters, pin names and any subgraph body (see NodeSource::Outline()).
+    /// @throws std::runtime_error on malformed data.
+    void ReadNodeOutline(BinaryReader &in, NodeOutline &outline, const std::vector<Symbol> &symbols,
+                         uint32_t format_version = GraphFileHeader::kFormatVersion);
+
+    /// @brief Serializes a complete node (ID, type, position, its own symbol table and record), for
+    /// streams without a shared table such as the mutation log.
+    void WriteNode(BinaryWriter &out, const Node &node);
+
+    /// @brief Reads a node written by WriteNode in the given format, allocating it and its pins from
+    /// pool (optional).
+    std::shared_ptr<Node> ReadNode(BinaryReader &in, const std::shared_ptr<ObjectPool> &pool = nullptr,
+                                   uint32_t format_version = GraphFileHeader::kFormatVersion);
+
+    /// @brief Reads the header of a graph file of any readable format. Fields a format lacks are
+    /// left zero.
+    /// @throws std::runtime_error if the data is not a graph file or its format is not supported.
+    GraphFileHeader ReadGraphFileHeader(BinaryReader &in, const std::string &path);
+
+    /// @brief Writes a snapshot to path atomically: the data goes to a temporary file which is
+    /// flushed to disk and then renamed over path, so readers never see a partial file.
+    /// @return The random file ID stored in the header.
+    /// @throws std::runtime_error if the file cannot be written.
+    uint64_t WriteGraphFile(const std::string &path, const GraphSnapshot &snapshot);
+
+    /// @brief Reads a whole graph file.
+    /// @param file_id Receives the file ID from the header (optional).
+    /// @throws std::runtime_error if the file is missing or malformed.
+    GraphSnapshot ReadGraphFile(const std::string &path, uint64_t *file_id = nullptr);
+
+    /// @brief Writes bytes to path through a temporary file and an atomic rename, flushing to disk.
+    /// @throws std::runtime_error on failure.
+    void WriteFileAtomically(const std::string &path, const std::string &bytes);
+
+} // namespace MindWeaver
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+
+#include <cstdint>
+#include <string>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Opens a graph file without decoding its node records.
+    ///
+    /// The file is memory-mapped and only its fixed-size node table is read: every node comes back
+    /// as a placeholder carrying its ID, type and position, and the snapshot's nodeSource decodes
+    /// a node's name, pins and parameters from the mapping when asked (Graph::MaterializeNode(),
+    /// GraphSnapshot::Materialized()). Links are read eagerly; they are small and fixed-size.
+    /// Opening therefore costs time and memory proportional to the node count, not to the size of
+    /// the graph's contents, and untouched records never leave the page cache.
+    ///
+    /// @param file_id Receives the file ID from the header (optional).
+    /// @throws std::runtime_error if the file is missing or malformed.
+    GraphSnapshot OpenGraphFileLazily(const std::string &path, uint64_t *file_id = nullptr);
+
+} // namespace MindWeaver
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/GraphMutation.h"
+#include "core/ObjectPool.h"
+#include "io/BinaryStream.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Header of a mutation log file. The log extends exactly one graph file: the one whose
+    /// header carries baseFileID.
+    ///
+    /// After the header the log is a sequence of records, each `u32 size, u32 checksum, payload`,
+    /// where the payload is an encoded GraphMutation. Records are only ever appended, so a crash can
+    /// at worst leave a torn last record, which readers detect by its checksum and ignore.
+    ///
+    /// Log format N stores nodes as WriteNode() does in graph file format N; logs of every format
+    /// since 1 stay readable.
+    struct MutationLogHeader
+    {
+        static constexpr uint32_t kMagic = 0x474C574D; // "MWLG"
+        static constexpr uint32_t kFormatVersion = 3;
+        static constexpr uint32_t kOldestFormatVersion = 1;
+
+        uint32_t magic = kMagic;
+        uint32_t formatVersion = kFormatVersion;
+        uint64_t baseFileID = 0;
+    };
+
+    /// @brief Appends one framed, checksummed record for a mutation.
+    void AppendMutationRecord(BinaryWriter &out, const GraphMutation &mutation);
+
+    /// @brief Decodes the payload of one record of a log in the given format; nodes and links are
+    /// allocated from pool (optional).
+    /// @throws std::runtime_error on malformed data.
+    GraphMutation DecodeMutation(BinaryReader &in, const std::shared_ptr<ObjectPool> &pool = nullptr,
+                                 uint32_t format_version = MutationLogHeader::kFormatVersion);
+
+    /// @brief Reads every intact record of a log, stopping at the first truncated or corrupt one.
+    /// @param base_file_id Receives the header's baseFileID.
+    /// @throws std::runtime_error if the file is missing or is not a mutation log.
+    std::vector<GraphMutation> ReadMutationLog(const std::string &path, uint64_t &base_file_id);
+
+    /// @brief Bytes of a log header for the given base file.
+    std::string MakeMutationLogHeader(uint64_t base_file_id);
+
+} // namespace MindWeaver
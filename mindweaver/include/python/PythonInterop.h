@@ -0,0 +1,53 @@
+#pragma once
+
+#include "runtime/NodeKernel.h"
+#include "runtime/ProcessExecutor.h"
+#include "runtime/Value.h"
+
+#include <pybind11/pybind11.h>
+
+#include <memory>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief A Python object carried as a pin value.
+    /// Copies share one reference and never touch the Python refcount, so values can be copied and
+    /// destroyed on executor threads that do not hold the GIL; the last copy releases the object
+    /// under the GIL.
+    struct PythonObject
+    {
+        std::shared_ptr<pybind11::object> object;
+    };
+
+    /// @brief Wraps a Python object for use as a pin value. Caller holds the GIL.
+    PythonObject MakePythonObject(pybind11::object obj);
+
+    /// @brief Converts a pin value to a Python object. Caller holds the GIL.
+    /// Int, Float, Bool and String values map to the Python builtins and Vectors to lists of
+    /// floats; PythonObject values are returned as-is. Buffers become read-only NumPy arrays that view the buffer's
+    /// memory and keep its owner alive, without copying.
+    /// @throws std::runtime_error for values with no Python representation.
+    pybind11::object ToPython(const Value &value);
+
+    /// @brief Converts a Python object to a pin value. Caller holds the GIL.
+    /// bool, int, float and str become native values. NumPy arrays with a native-endian dtype that
+    /// Buffer supports are adopted as Buffers that reference the array instead of copying it, and the
+    /// array is made read-only (writeable views of memory the array does not own are copied); anything
+    /// else is kept as a PythonObject.
+    Value FromPython(const pybind11::handle &value);
+
+    /// @brief InterpreterLock backed by the Python GIL (PyGILState_Ensure/Release).
+    class PythonGilLock : public InterpreterLock
+    {
+    public:
+        void Acquire() override;
+        void Release() override;
+    };
+
+    /// @brief Fork hooks that keep the interpreter usable in ProcessExecutor workers
+    /// (PyOS_BeforeFork / PyOS_AfterFork_*). Each worker then runs Python nodes under its own GIL.
+    ProcessForkHooks MakePythonForkHooks();
+
+} // namespace MindWeaver
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "runtime/NodeKernel.h"
+
+#include <pybind11/pybind11.h>
+
+#include <string>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief How a Python-implemented node is scheduled.
+    struct PythonNodeOptions
+    {
+        /// @brief Run even when none of the node's outputs are requested.
+        bool sideEffects = false;
+
+        /// @brief Run the callable in a worker process (concurrent.futures.ProcessPoolExecutor) instead
+        /// of the embedded interpreter. The GIL is held only to submit the call and unpack the result,
+        /// so several CPU-bound nodes run truly in parallel. The callable and its arguments must be
+        /// picklable (e.g. a module-level function); Buffer inputs are pickled, i.e. copied, on the way.
+        bool cpuBound = false;
+    };
+
+    /// @brief Builds the kernel for a node implemented by a Python callable.
+    ///
+    /// The callable is invoked with the node's connected data inputs and its parameters as keyword
+    /// arguments (inputs win on name clashes). It may return a dict mapping output names to values,
+    /// a single value when the node has exactly one data output, a tuple of values in output-name
+    /// order, or None when the node has no data outputs.
+    ///
+    /// In-process nodes get ExecutionAffinity::Interpreter, so the executor batches them under one
+    /// GIL acquisition and runs everything else without the GIL. Caller holds the GIL.
+    KernelInfo MakePythonKernel(pybind11::object callable, const PythonNodeOptions &options = {});
+
+    /// @brief Forgets the process pool of CPU-bound nodes in a forked child, where the pool's threads
+    /// no longer exist; the next such node starts a new pool. Called by MakePythonForkHooks()' child
+    /// hook with the GIL held.
+    void ResetPythonProcessPoolAfterFork();
+
+    /// @brief Registers a Python callable as the implementation of nodes named node_name.
+    /// Caller holds the GIL.
+    void RegisterPythonNode(KernelRegistry &registry, const std::string &node_name, pybind11::object callable,
+                            const PythonNodeOptions &options = {});
+
+} // namespace MindWeaver
@@ -0,0 +1,25 @@
+#pragma once
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Owns the editor's embedded Python interpreter.
+    ///
+    /// The interpreter is started in the constructor and the GIL is released immediately, so no
+    /// thread holds it by default: executor workers and UI code take it only around Python calls
+    /// (py::gil_scoped_acquire / PythonGilLock). Only one instance may exist per process.
+    class PythonRuntime
+    {
+    public:
+        PythonRuntime();
+        ~PythonRuntime();
+
+        PythonRuntime(const PythonRuntime &) = delete;
+        PythonRuntime &operator=(const PythonRuntime &) = delete;
+
+    private:
+        void *m_MainThreadState = nullptr; /// @brief PyThreadState saved when the GIL was released.
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Element type of a Buffer.
+    enum class ElementType
+    {
+        Bool,
+        UInt8,
+        UInt16,
+        Int32,
+        Int64,
+        Float16,
+        Float32,
+        Float64,
+    };
+
+    /// @brief Size in bytes of one element of the given type.
+    size_t ElementSize(ElementType type);
+
+    /// @brief A typed n-dimensional array carried by PinType::Buffer pins.
+    ///
+    /// A Buffer is a view (data pointer, shape, byte strides) plus a shared owner that keeps the
+    /// memory alive. Copying a Buffer copies the view, never the elements, so passing one along
+    /// links, storing it in several slots or handing it to Python costs no allocation. The owner can
+    /// be anything: memory from Allocate, a memory-mapped file, or a NumPy array adopted from a
+    /// Python node (see python/PythonInterop.h).
+    ///
+    /// Once a Buffer has been set as a node output, consumers may share it, so its elements must
+    /// not be modified anymore.
+    struct Buffer
+    {
+        std::shared_ptr<const void> owner; /// @brief Keeps the elements alive.
+        const void *data = nullptr;        /// @brief First element.
+        ElementType dtype = ElementType::Float32;
+        std::vector<int64_t> shape;
+        std::vector<int64_t> strides; /// @brief Byte strides, one per dimension.
+
+        /// @brief Allocates an uninitialized C-contiguous buffer.
+        /// Write the elements through MutableData() before publishing it.
+        static Buffer Allocate(ElementType dtype, std::vector<int64_t> shape);
+
+        /// @brief Wraps existing memory without copying; owner keeps it alive.
+        /// Empty strides mean C-contiguous.
+        static Buffer Wrap(std::shared_ptr<const void> owner, const void *data, ElementType dtype,
+                           std::vector<int64_t> shape, std::vector<int64_t> strides = {});
+
+        /// @brief Writable access for the producer of a freshly allocated buffer.
+        void *MutableData() const { return const_cast<void *>(data); }
+
+        template <typename T> const T *Data() const { return static_cast<const T *>(data); }
+
+        size_t ElementCount() const;
+        size_t ByteSize() const { return ElementCount() * ElementSize(dtype); }
+        bool IsContiguous() const;
+
+        /// @brief Copies the elements into ByteSize() bytes at destination, in C-contiguous order.
+        void CopyTo(void *destination) const;
+
+        /// @brief C-contiguous byte strides for a shape.
+        static std::vector<int64_t> ContiguousStrides(ElementType dtype, const std::vector<int64_t> &shape);
+    };
+
+} // namespace MindWeaver
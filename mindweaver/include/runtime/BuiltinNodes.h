@@ -0,0 +1,96 @@
+#pragma once
+
+#include "runtime/NodeKernel.h"
+#include "runtime/Operators.h"
+#include "runtime/TypedNode.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    // Integer arithmetic wraps around on overflow, like the unsigned types.
+
+    /// @brief Adds numbers (elementwise for vectors) or joins strings.
+    struct AddNode : BinaryOperator<AddNode>
+    {
+        static constexpr const char *kName = "Add";
+        static int64_t Apply(int64_t a, int64_t b)
+        {
+            return static_cast<int64_t>(static_cast<uint64_t>(a) + static_cast<uint64_t>(b));
+        }
+        static double Apply(double a, double b) { return a + b; }
+        static std::string Apply(std::string_view a, std::string_view b)
+        {
+            std::string result;
+            result.reserve(a.size() + b.size());
+            return result.append(a).append(b);
+        }
+    };
+
+    /// @brief Subtracts b from a.
+    struct SubtractNode : BinaryOperator<SubtractNode>
+    {
+        static constexpr const char *kName = "Subtract";
+        static int64_t Apply(int64_t a, int64_t b)
+        {
+            return static_cast<int64_t>(static_cast<uint64_t>(a) - static_cast<uint64_t>(b));
+        }
+        static double Apply(double a, double b) { return a - b; }
+    };
+
+    /// @brief Multiplies two numbers.
+    struct MultiplyNode : BinaryOperator<MultiplyNode>
+    {
+        static constexpr const char *kName = "Multiply";
+        static int64_t Apply(int64_t a, int64_t b)
+        {
+            return static_cast<int64_t>(static_cast<uint64_t>(a) * static_cast<uint64_t>(b));
+        }
+        static double Apply(double a, double b) { return a * b; }
+    };
+
+    /// @brief Divides a by b, always in floating point (IEEE semantics: dividing by zero gives an
+    /// infinity or NaN), so Int operands give a Float.
+    struct DivideNode : BinaryOperator<DivideNode>
+    {
+        static constexpr const char *kName = "Divide";
+        static double Apply(double a, double b) { return a / b; }
+    };
+
+    /// @brief Joins two strings; an unconnected input counts as empty.
+    struct ConcatenateNode
+    {
+        static constexpr const char *kName = "Concatenate";
+        static constexpr NodeType kType = NodeType::Function;
+        static constexpr std::array<const char *, 2> kInputs{"a", "b"};
+        static constexpr std::array<const char *, 1> kOutputs{"result"};
+        static std::string Execute(const std::optional<std::string> &a, const std::optional<std::string> &b)
+        {
+            return a.value_or(std::string()) + b.value_or(std::string());
+        }
+    };
+
+    /// @brief Maps the file named by the "path" parameter as a flat UInt8 buffer. The mapping goes
+    /// through the resource cache, so later runs (and other nodes reading the file) reuse it.
+    struct LoadFileNode
+    {
+        static constexpr const char *kName = "Load File";
+        static constexpr NodeType kType = NodeType::Function;
+        static constexpr std::array<const char *, 0> kInputs{};
+        static constexpr std::array<const char *, 1> kOutputs{"data"};
+        static Buffer Execute(ExecutionContext &context);
+    };
+
+    class NodeCatalog;
+
+    /// @brief Registers the kernels of every node kind above, and lists the kinds in catalog
+    /// (optional) for the editor's palette.
+    void RegisterBuiltinNodes(KernelRegistry &registry, NodeCatalog *catalog = nullptr);
+
+} // namespace MindWeaver
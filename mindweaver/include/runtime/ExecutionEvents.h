@@ -0,0 +1,94 @@
+#pragma once
+
+#include "core/UUID.h"
+#include "runtime/MpscQueue.h"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Lifecycle state of a node within one execution.
+    enum class NodeStatus
+    {
+        Idle,    /// @brief Not part of the current (or any) execution.
+        Queued,  /// @brief Scheduled, waiting for its inputs or a worker.
+        Running, /// @brief Currently executing.
+        Done,    /// @brief Finished successfully.
+        Error,   /// @brief Failed; the event message carries the error text.
+    };
+
+    /// @brief Kind of update carried by an ExecutionEvent.
+    enum class ExecutionEventKind
+    {
+        Status,   /// @brief The node changed NodeStatus.
+        Progress, /// @brief The node reported progress in [0, 1].
+        Preview,  /// @brief The node produced a short textual preview of an output.
+    };
+
+    /// @brief A single update sent from the executor to the UI.
+    struct ExecutionEvent
+    {
+        UUID nodeID;                                          /// @brief Node the event refers to.
+        ExecutionEventKind kind = ExecutionEventKind::Status; /// @brief What changed.
+        NodeStatus status = NodeStatus::Idle;                 /// @brief New status (Status events).
+        float progress = 0.0f;                                /// @brief Progress in [0, 1] (Progress events).
+        std::string message;                                  /// @brief Error text or output preview.
+    };
+
+    /// @brief Executor -> UI event stream.
+    /// Any number of executor threads post events without locking; the UI thread drains them once
+    /// per frame. Neither side ever waits on the other.
+    class ExecutionEventChannel
+    {
+    public:
+        void PostStatus(const UUID &node_id, NodeStatus status, std::string message = {})
+        {
+            ExecutionEvent event;
+            event.nodeID = node_id;
+            event.kind = ExecutionEventKind::Status;
+            event.status = status;
+            event.message = std::move(message);
+            m_Queue.Push(std::move(event));
+        }
+
+        void PostProgress(const UUID &node_id, float progress)
+        {
+            ExecutionEvent event;
+            event.nodeID = node_id;
+            event.kind = ExecutionEventKind::Progress;
+            event.progress = progress;
+            m_Queue.Push(std::move(event));
+        }
+
+        void PostPreview(const UUID &node_id, std::string preview)
+        {
+            ExecutionEvent event;
+            event.nodeID = node_id;
+            event.kind = ExecutionEventKind::Preview;
+            event.message = std::move(preview);
+            m_Queue.Push(std::move(event));
+        }
+
+        /// @brief Passes up to max_events pending events to fn, oldest first. Consumer thread only.
+        /// @return The number of events drained.
+        template <typename Fn> size_t Drain(Fn &&fn, size_t max_events = static_cast<size_t>(-1))
+        {
+            size_t drained = 0;
+            ExecutionEvent event;
+            while (drained < max_events && m_Queue.TryPop(event))
+            {
+                fn(event);
+                ++drained;
+            }
+            return drained;
+        }
+
+    private:
+        MpscQueue<ExecutionEvent> m_Queue;
+    };
+
+} // namespace MindWeaver
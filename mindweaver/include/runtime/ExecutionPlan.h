@@ -0,0 +1,93 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+#include "core/UUID.h"
+#include "runtime/NodeKernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief What an execution should produce.
+    struct ExecutionRequest
+    {
+        /// @brief Pins whose values are wanted. Only the nodes these (transitively) depend on run.
+        /// Empty means "run the whole graph".
+        std::vector<UUID> targetPins;
+
+        /// @brief Also run side-effect nodes (see KernelInfo::sideEffects) and their dependencies
+        /// even if no target depends on them.
+        bool includeSideEffects = true;
+
+        /// @brief Merge structurally identical nodes before planning (see EliminateCommonSubexpressions).
+        bool eliminateCommonSubexpressions = true;
+    };
+
+    /// @brief One node scheduled by an ExecutionPlan.
+    struct PlannedNode
+    {
+        static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+
+        /// @brief A data input and the value slot feeding it (kNoSlot when unconnected).
+        struct InputBinding
+        {
+            Symbol pinName;
+            size_t slot = kNoSlot;
+        };
+
+        /// @brief A data output and the value slot it writes.
+        struct OutputBinding
+        {
+            Symbol pinName;
+            UUID pinID;
+            size_t slot = kNoSlot;
+        };
+
+        std::shared_ptr<const Node> node;   /// @brief The node (kept alive by the plan).
+        const KernelInfo *kernel = nullptr; /// @brief Implementation, or nullptr for a no-op node.
+        std::vector<InputBinding> inputs;   /// @brief Data inputs (Exec pins carry no value).
+        std::vector<OutputBinding> outputs; /// @brief Data outputs.
+        std::vector<size_t> dependents;     /// @brief Plan indices that must wait for this node.
+        size_t dependencyCount = 0;         /// @brief Number of plan nodes this node waits for.
+
+        /// @brief Node whose status and stats this one is reported under: the outermost subgraph
+        /// node for a node inlined from a subgraph body (see NodeStatusReporter), else the node itself.
+        UUID reportID;
+        Symbol reportName; /// @brief Name of the reportID node.
+
+        /// @brief Report IDs and names of nodes merged into this one by common subexpression
+        /// elimination; they show its stats too.
+        std::vector<std::pair<UUID, Symbol>> mergedReports;
+
+        /// @brief For a binary operator whose operand kinds follow from the pins feeding it: the
+        /// entry for them, which executors call on the input slots instead of the kernel.
+        BinaryOperatorFn binaryOperator = nullptr;
+    };
+
+    /// @brief The minimal, topologically ordered set of nodes needed to satisfy an ExecutionRequest.
+    struct ExecutionPlan
+    {
+        std::vector<PlannedNode> nodes;               /// @brief In a valid execution order.
+        size_t slotCount = 0;                         /// @brief Number of value slots needed.
+        std::unordered_map<UUID, size_t> targetSlots; /// @brief Requested pin -> value slot.
+        uint64_t graphVersion = 0;                    /// @brief Version of the planned snapshot.
+    };
+
+    /// @brief Builds the plan for a request by walking backwards over links from the target pins.
+    /// Data links and Exec links are both followed, so a required node also pulls in the execution
+    /// chain leading to it.
+    /// @throws std::runtime_error if a target pin does not exist, the required subgraph has a cycle, a
+    /// node does not match its kernel's signature, or a binary operator is connected to operands of
+    /// kinds it does not apply to (unless they are only known at run time: Empty or Object).
+    ExecutionPlan BuildExecutionPlan(const GraphSnapshot &snapshot, const KernelRegistry &registry,
+                                     const ExecutionRequest &request);
+
+} // namespace MindWeaver
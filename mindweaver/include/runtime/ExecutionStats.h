@@ -0,0 +1,143 @@
+#pragma once
+
+#include "core/Symbol.h"
+#include "core/UUID.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief A quantity recorded per node by the executors.
+    enum class NodeMetric
+    {
+        WallTime,       /// @brief Nanoseconds from the start to the end of the kernel.
+        CpuTime,        /// @brief Nanoseconds of CPU time of the executing thread.
+        BytesAllocated, /// @brief Bytes of Buffers allocated by the kernel.
+        CacheHits,      /// @brief ResourceCache acquires served without loading.
+        Calls,          /// @brief Number of executions.
+    };
+
+    constexpr size_t kNodeMetricCount = 5;
+
+    /// @brief Display name of a metric ("Wall time", ...).
+    const char *GetNodeMetricName(NodeMetric metric);
+
+    /// @brief Counters of the calling thread, bumped by allocation and cache paths and sampled
+    /// around each node by the executors.
+    struct ThreadCounters
+    {
+        uint64_t bytesAllocated = 0;
+        uint64_t cacheHits = 0;
+    };
+
+    inline ThreadCounters &GetThreadCounters()
+    {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    /// @brief Measurements of one node execution.
+    struct NodeSample
+    {
+        uint32_t planIndex = 0; /// @brief Node of the executed plan.
+        uint32_t thread = 0;    /// @brief Worker thread (worker process for ProcessExecutor).
+        uint64_t wallNs = 0;
+        uint64_t cpuNs = 0;
+        uint64_t bytesAllocated = 0;
+        uint64_t cacheHits = 0;
+    };
+
+    /// @brief Measures one node execution on the calling thread: construct it right before the
+    /// kernel runs and call Stop() right after.
+    class NodeSampler
+    {
+    public:
+        NodeSampler();
+
+        NodeSample Stop(uint32_t plan_index, uint32_t thread) const;
+
+    private:
+        std::chrono::steady_clock::time_point m_WallStart;
+        uint64_t m_CpuStart;
+        ThreadCounters m_CountersStart;
+    };
+
+    /// @brief Totals of one node over every sample recorded for it.
+    struct NodeStats
+    {
+        Symbol name;
+        uint64_t calls = 0;
+        uint64_t wallNs = 0;
+        uint64_t maxWallNs = 0; /// @brief Slowest single execution.
+        uint64_t cpuNs = 0;
+        uint64_t bytesAllocated = 0;
+        uint64_t cacheHits = 0;
+
+        double Get(NodeMetric metric) const;
+    };
+
+    /// @brief Totals of one worker thread.
+    struct ThreadStats
+    {
+        uint64_t calls = 0;
+        uint64_t wallNs = 0; /// @brief Time spent in kernels (not waiting for work).
+        uint64_t cpuNs = 0;
+    };
+
+    /// @brief Per-node and per-thread execution statistics of one or more runs.
+    ///
+    /// Executors record NodeSamples into per-thread buffers while a run is in progress and add
+    /// them here once it has finished, so recording takes no locks. Merge() accumulates several
+    /// runs, e.g. to compare averages.
+    class ExecutionStats
+    {
+    public:
+        void Add(const UUID &node_id, Symbol node_name, const NodeSample &sample);
+
+        /// @brief Adds a sample to a node's totals but not to its thread's, for nodes that share
+        /// the execution of another one (e.g. merged into it).
+        void AddToNode(const UUID &node_id, Symbol node_name, const NodeSample &sample);
+        void Reserve(size_t node_count) { m_Nodes.reserve(node_count); }
+        void Merge(const ExecutionStats &other);
+        void Clear();
+
+        bool Empty() const { return m_Nodes.empty(); }
+        size_t GetRunCount() const { return m_RunCount; }
+        void SetRunCount(size_t runs) { m_RunCount = runs; }
+
+        /// @brief Stats of a node, or nullptr if it never ran.
+        const NodeStats *Find(const UUID &node_id) const;
+        const std::unordered_map<UUID, NodeStats> &GetNodes() const { return m_Nodes; }
+        const std::vector<ThreadStats> &GetThreads() const { return m_Threads; }
+
+        /// @brief Largest value of metric over all nodes (0 when empty).
+        double GetMax(NodeMetric metric) const;
+
+        /// @brief One row per node, slowest (by wall time) first:
+        /// node_id,name,calls,wall_ns,max_wall_ns,cpu_ns,bytes_allocated,cache_hits
+        std::string ToCSV() const;
+
+        /// @brief {"runs": n, "nodes": [{"id", "name", "calls", ...}], "threads": [{...}]},
+        /// nodes in the same order as ToCSV().
+        std::string ToJSON() const;
+
+        /// @brief Writes ToJSON() if path ends in ".json", ToCSV() otherwise.
+        /// @throws std::runtime_error if the file cannot be written.
+        void Save(const std::string &path) const;
+
+    private:
+        std::vector<std::pair<UUID, const NodeStats *>> SortedByWallTime() const;
+
+        std::unordered_map<UUID, NodeStats> m_Nodes;
+        std::vector<ThreadStats> m_Threads;
+        size_t m_RunCount = 0;
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+#include "runtime/ExecutionPlan.h"
+#include "runtime/ExecutionStats.h"
+#include "runtime/NodeKernel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    class ExecutionEventChannel;
+
+    /// @brief Posts the status of a plan's nodes to an event channel under their report IDs (see
+    /// PlannedNode::reportID). Nodes sharing one, e.g. the body of an inlined subgraph, count as
+    /// one node: Running once the first of them starts, Done once all of them have finished, Error
+    /// as soon as one fails. Started() and Finished() may be called from any thread.
+    class NodeStatusReporter
+    {
+    public:
+        /// @param events Channel to post to; with nullptr, nothing is posted.
+        NodeStatusReporter(ExecutionEventChannel *events, const ExecutionPlan &plan);
+
+        /// @brief Posts Queued for every reported node.
+        void Queued();
+
+        void Started(size_t plan_index);
+
+        /// @param error Empty on success.
+        void Finished(size_t plan_index, const std::string &error);
+
+        /// @brief Posts Idle for every reported node that has not finished; call after the run.
+        void Stopped();
+
+    private:
+        struct Group
+        {
+            UUID id;
+            size_t size = 0;
+            std::atomic<size_t> started{0};
+            std::atomic<size_t> finished{0};
+            std::atomic<bool> failed{false};
+        };
+
+        ExecutionEventChannel *m_Events;
+        std::unique_ptr<Group[]> m_Groups;
+        size_t m_GroupCount = 0;
+        std::vector<size_t> m_GroupOf; // Plan index -> group
+    };
+
+    /// @brief Adds a sample of a planned node to stats under every node it is shown as: its report
+    /// ID and those of the nodes merged into it.
+    void RecordSample(ExecutionStats &stats, const PlannedNode &planned, const NodeSample &sample);
+
+    /// @brief Outcome of one execution.
+    struct ExecutionResult
+    {
+        bool success = true;                        /// @brief False if any node failed.
+        std::string error;                          /// @brief Message of the first failure.
+        std::unordered_map<UUID, Value> outputs; /// @brief Values of the requested target pins.
+        size_t nodesExecuted = 0;                   /// @brief Nodes that ran to completion.
+        ExecutionStats stats;                       /// @brief Per-node measurements, if the executor collects them.
+    };
+
+    /// @brief Runs execution plans on a set of worker threads.
+    ///
+    /// Nodes become runnable as soon as every node they depend on has finished, so independent
+    /// branches run in parallel. Interpreter-affinity nodes (Python) are the exception: one worker at
+    /// a time drains them in batches, taking the InterpreterLock once per batch, while the other
+    /// workers keep running native nodes without it.
+    ///
+    /// The executor only ever reads GraphSnapshots, never the live Graph, so the editor can keep
+    /// editing while a run is in progress. If a node throws, no further nodes are started and the
+    /// run reports the first error.
+    class Executor
+    {
+    public:
+        /// @param registry Node implementations; must not be modified while runs are in flight.
+        /// @param worker_count Number of threads per run (0 = hardware concurrency).
+        explicit Executor(std::shared_ptr<const KernelRegistry> registry, size_t worker_count = 0);
+
+        Executor(const Executor &) = delete;
+        Executor &operator=(const Executor &) = delete;
+
+        /// @brief Status/progress events of every run are posted here (optional).
+        void SetEventChannel(std::shared_ptr<ExecutionEventChannel> channel);
+
+        /// @brief Lock held around batches of Interpreter-affinity nodes (optional).
+        /// Without one, interpreter nodes are still serialized with each other but take no lock.
+        void SetInterpreterLock(std::shared_ptr<InterpreterLock> lock);
+
+        /// @brief Cache kernels load resources into (ExecutionContext::GetResourceCache()); without
+        /// one, ResourceCache::Instance(). Kept across runs, so later runs find what earlier ones loaded.
+        void SetResourceCache(std::shared_ptr<ResourceCache> cache);
+
+        /// @brief Records wall time, CPU time, allocations and cache hits of every node into
+        /// ExecutionResult::stats. Off by default: reading the thread CPU clock is a system call,
+        /// which adds a fraction of a microsecond per node.
+        void SetCollectStats(bool collect) { m_CollectStats = collect; }
+
+        /// @brief Builds the minimal plan for a request against a snapshot.
+        ExecutionPlan Prepare(const GraphSnapshot &snapshot, const ExecutionRequest &request = {}) const;
+
+        /// @brief Runs a prepared plan to completion on the calling thread plus worker threads.
+        ExecutionResult Run(const ExecutionPlan &plan);
+
+        /// @brief Prepares and runs a request against a snapshot.
+        /// Planning errors (cycles, unknown target pins) are reported through the result.
+        ExecutionResult Run(const GraphSnapshot &snapshot, const ExecutionRequest &request = {});
+
+        /// @brief Runs a request on a background thread. The executor must outlive the returned future.
+        std::future<ExecutionResult> RunAsync(GraphSnapshot snapshot, ExecutionRequest request = {});
+
+        const KernelRegistry &GetRegistry() const { return *m_Registry; }
+
+    private:
+        std::shared_ptr<const KernelRegistry> m_Registry;
+        std::shared_ptr<ExecutionEventChannel> m_Events;
+        std::shared_ptr<InterpreterLock> m_InterpreterLock;
+        std::shared_ptr<ResourceCache> m_Resources;
+        size_t m_WorkerCount;
+        bool m_CollectStats = false;
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+#include "core/Position.h"
+#include "core/UUID.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    class Graph;
+
+    /// @brief Tuning of ComputeGraphLayout(). Distances are in grid units.
+    struct LayoutOptions
+    {
+        float layerSpacing = 260.0f;     /// @brief Horizontal distance between consecutive layers.
+        float nodeSpacing = 140.0f;      /// @brief Vertical distance between nodes of a layer.
+        float componentSpacing = 200.0f; /// @brief Gap between disconnected parts of the graph.
+        size_t orderingSweeps = 8;       /// @brief Barycenter passes (down and up) to reduce crossings.
+        size_t threadCount = 0;          /// @brief Worker threads; 0 uses the hardware concurrency.
+    };
+
+    /// @brief Output of ComputeGraphLayout(): new positions for the laid out nodes.
+    struct GraphLayout
+    {
+        std::vector<std::pair<UUID, Position>> positions;
+        uint64_t graphVersion = 0; /// @brief Version of the snapshot the layout was computed from.
+        size_t layerCount = 0;     /// @brief Layers of the deepest component.
+        size_t componentCount = 0; /// @brief Weakly connected components laid out.
+    };
+
+    /// @brief Computes a layered (Sugiyama-style) left-to-right layout.
+    ///
+    /// Links are followed from output to input pins. Cycles are broken by reversing DFS back
+    /// edges, nodes are put in longest-path layers, links spanning several layers are routed
+    /// through virtual nodes, and barycenter sweeps order each layer to reduce crossings before
+    /// nodes are aligned with their neighbors. The starting order comes from the current
+    /// positions, so laying out an already tidy graph again changes little.
+    ///
+    /// Connected components are laid out in parallel and stacked top to bottom (single nodes are
+    /// packed in a grid below them); placeholders of lazily loaded graphs are loaded in parallel.
+    /// When region is not empty only those nodes are laid out, ignoring links to other nodes, and
+    /// the result keeps the region's top-left corner in place. Runs on any thread.
+    GraphLayout ComputeGraphLayout(const GraphSnapshot &snapshot, const std::vector<UUID> &region = {},
+                                   const LayoutOptions &options = {});
+
+    /// @brief Runs ComputeGraphLayout() on a background thread.
+    std::future<GraphLayout> ComputeGraphLayoutAsync(GraphSnapshot snapshot, std::vector<UUID> region = {},
+                                                     LayoutOptions options = {});
+
+    /// @brief Moves the nodes of layout.positions[begin, begin + max_count) in graph (nodes removed
+    /// since the layout was computed are skipped). Call on the thread owning the graph; a large
+    /// layout can be applied over several frames.
+    /// @return The index of the first position not applied yet.
+    size_t ApplyGraphLayout(Graph &graph, const GraphLayout &layout, size_t begin = 0,
+                            size_t max_count = std::numeric_limits<size_t>::max());
+
+} // namespace MindWeaver
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+#include "core/UUID.h"
+#include "runtime/ExecutionPlan.h"
+#include "runtime/NodeKernel.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Computes a canonical structural hash for every node of a snapshot.
+    ///
+    /// The hash is Merkle-style: it covers the node's name, type, parameters and pin signature plus
+    /// the hashes of whatever feeds each input, but none of the UUIDs. Two nodes with the same hash
+    /// compute the same value from the same upstream computation. Nodes on a cycle hash their own ID
+    /// as well, so they never compare equal to anything else.
+    std::unordered_map<UUID, uint64_t> ComputeStructuralHashes(const GraphSnapshot &snapshot);
+
+    /// @brief Output of EliminateCommonSubexpressions().
+    struct CseResult
+    {
+        GraphSnapshot graph;                     /// @brief The rewritten graph.
+        std::unordered_map<UUID, UUID> pinRemap;  /// @brief Pin of a removed node -> equivalent surviving pin.
+        std::unordered_map<UUID, UUID> nodeRemap; /// @brief Removed node -> the node it was merged into.
+        size_t nodesRemoved = 0;                 /// @brief Number of nodes merged away.
+    };
+
+    /// @brief Merges structurally identical nodes so each distinct computation runs once.
+    ///
+    /// Nodes are considered in dependency order; a node is merged into an earlier one when both have
+    /// the same structural hash and, after earlier merges, exactly the same name, type, parameters,
+    /// pin signature and input sources. Consumers of the removed node are rewired to the survivor.
+    /// Nodes with Exec pins, nodes whose kernel has side effects and nodes on cycles are never merged.
+    CseResult EliminateCommonSubexpressions(const GraphSnapshot &snapshot, const KernelRegistry &registry);
+
+    /// @brief Replaces every subgraph node by its body (see FlattenSubgraphs), so execution sees only
+    /// ordinary nodes and pays nothing for the nesting. Bodies are flattened once per definition
+    /// version and then only copied per instance. Snapshots without subgraph nodes are returned as
+    /// they are. Placeholders must have been loaded (GraphSnapshot::Materialized()).
+    /// @param pin_remap Receives, for every pin of an inlined node, the body pin standing in for it.
+    /// @param node_owners Receives, for every body node, the subgraph node of snapshot it belongs to.
+    /// @throws std::runtime_error if a subgraph node does not match its definition.
+    GraphSnapshot InlineSubgraphs(const GraphSnapshot &snapshot, std::unordered_map<UUID, UUID> *pin_remap = nullptr,
+                                  std::unordered_map<UUID, UUID> *node_owners = nullptr);
+
+    /// @brief Builds the plan for a request: subgraph nodes are inlined, then common subexpressions
+    /// are merged if the request asks for it. Target pins of inlined or merged-away nodes are
+    /// reported under the IDs the caller asked for; body nodes report their status and stats under
+    /// their subgraph node (PlannedNode::reportID), and merged-away nodes show the stats of the node
+    /// they were merged into. Placeholder nodes of lazily opened files are loaded first, only those
+    /// the request needs when it names target pins.
+    /// @throws std::runtime_error as BuildExecutionPlan().
+    ExecutionPlan PrepareExecutionPlan(const GraphSnapshot &snapshot, const KernelRegistry &registry,
+                                       const ExecutionRequest &request);
+
+} // namespace MindWeaver
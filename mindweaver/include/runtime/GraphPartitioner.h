@@ -0,0 +1,52 @@
+#pragma once
+
+#include "core/Pin.h"
+#include "runtime/ExecutionPlan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Estimates used to split an ExecutionPlan across processes.
+    struct PartitionCostModel
+    {
+        /// @brief Estimated size in bytes of a value of the given pin type (what crossing a
+        /// partition boundary costs). Defaults: Buffer 4 MiB, String 256 B, anything else 16 B.
+        std::function<double(PinType)> valueBytes;
+
+        /// @brief Estimated run time of a node, in arbitrary units (default 1 per node).
+        std::function<double(const PlannedNode &)> nodeCost;
+
+        /// @brief Cost of an Exec-only dependency between partitions (one control message).
+        double controlBytes = 64.0;
+
+        /// @brief How far a partition may exceed the average load: at most (1 + imbalance) x average.
+        double imbalance = 0.25;
+    };
+
+    /// @brief Output of PartitionExecutionPlan().
+    struct PartitionResult
+    {
+        std::vector<uint32_t> assignment; /// @brief Plan index -> partition.
+        size_t partitionCount = 0;        /// @brief Number of partitions actually used.
+        std::vector<double> loads;        /// @brief Summed node cost per partition.
+        double cutBytes = 0.0;            /// @brief Estimated bytes crossing partition boundaries.
+    };
+
+    /// @brief Splits the nodes of a plan into at most partition_count groups, and never into more
+    /// than the plan's parallelism (the most nodes on one dependency level).
+    ///
+    /// Minimizes the estimated bytes that cross partition boundaries while keeping every partition's
+    /// load within the model's imbalance bound: nodes are first placed greedily in plan order next to
+    /// the producers of their inputs, then boundary nodes are moved while that shrinks the cut.
+    /// Independent branches end up in different partitions; sequential chains stay in one partition
+    /// even past the bound, as splitting them gains no parallelism.
+    PartitionResult PartitionExecutionPlan(const ExecutionPlan &plan, size_t partition_count,
+                                           const PartitionCostModel &model = {});
+
+} // namespace MindWeaver
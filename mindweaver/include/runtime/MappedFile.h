@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Read-only memory mapping of a file on disk.
+    /// Used for model weights so that loading is a page-table operation rather than a copy, and so
+    /// that multiple cache entries backed by the same file share the OS page cache.
+    class MappedFile
+    {
+    public:
+        /// @brief Maps the whole file at the given path.
+        /// @param path Path of the file to map.
+        /// @throws std::runtime_error if the file cannot be opened or mapped.
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /// @brief Pointer to the first byte of the mapping (nullptr for empty files).
+        const uint8_t *Data() const { return m_Data; }
+
+        /// @brief Size of the mapping in bytes.
+        size_t Size() const { return m_Size; }
+
+        /// @brief Path the mapping was created from.
+        const std::string &GetPath() const { return m_Path; }
+
+    private:
+        std::string m_Path;
+        const uint8_t *m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        void *m_FileHandle = nullptr;
+        void *m_MappingHandle = nullptr;
+#endif
+    };
+
+} // namespace MindWeaver
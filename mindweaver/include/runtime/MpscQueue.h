@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Unbounded lock-free multi-producer / single-consumer queue (Vyukov's node-based design).
+    ///
+    /// Push() is wait-free for producers (one atomic exchange) and never blocks on the consumer.
+    /// TryPop() must only be called from one thread at a time. An element whose producer was
+    /// preempted mid-push becomes visible on a later TryPop(); nothing is ever lost.
+    /// T must be default-constructible (the queue keeps one spare cell as a stub).
+    template <typename T> class MpscQueue
+    {
+    public:
+        MpscQueue() : m_Head(new Cell()), m_Tail(m_Head.load(std::memory_order_relaxed)) {}
+
+        ~MpscQueue()
+        {
+            Cell *cell = m_Tail;
+            while (cell)
+            {
+                Cell *next = cell->next.load(std::memory_order_relaxed);
+                delete cell;
+                cell = next;
+            }
+        }
+
+        MpscQueue(const MpscQueue &) = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+        /// @brief Enqueues a value. Safe to call from any number of threads.
+        void Push(T value)
+        {
+            Cell *cell = new Cell();
+            cell->value = std::move(value);
+            Cell *prev = m_Head.exchange(cell, std::memory_order_acq_rel);
+            prev->next.store(cell, std::memory_order_release);
+        }
+
+        /// @brief Dequeues the oldest visible value. Consumer thread only.
+        /// @return false if no value is currently available.
+        bool TryPop(T &out)
+        {
+            Cell *tail = m_Tail;
+            Cell *next = tail->next.load(std::memory_order_acquire);
+            if (!next)
+                return false;
+            out = std::move(next->value);
+            m_Tail = next; // next becomes the new stub
+            delete tail;
+            return true;
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<Cell *> next{nullptr};
+            T value{};
+        };
+
+        alignas(64) std::atomic<Cell *> m_Head; // Producers append here
+        alignas(64) Cell *m_Tail;               // Consumer reads from here (always a consumed stub)
+    };
+
+} // namespace MindWeaver
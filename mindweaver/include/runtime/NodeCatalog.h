@@ -0,0 +1,72 @@
+#pragma once
+
+#include "core/Node.h"
+#include "core/ObjectPool.h"
+#include "core/Symbol.h"
+#include "runtime/TrigramIndex.h"
+#include "runtime/TypedNode.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief A node type the user can create from the editor's palette.
+    struct NodeCatalogEntry
+    {
+        Symbol name;
+        std::string category; /// @brief e.g. "Math"; searched along with the name.
+
+        /// @brief Creates a fresh node of this type (new IDs) allocated from pool.
+        std::function<std::shared_ptr<Node>(const std::shared_ptr<ObjectPool> &pool)> create;
+    };
+
+    /// @brief The creatable node types, searchable by fuzzy name/category match.
+    /// The search index is updated on every Add/Remove, never rebuilt.
+    class NodeCatalog
+    {
+    public:
+        /// @brief Adds an entry, replacing any entry with the same name.
+        void Add(NodeCatalogEntry entry);
+
+        /// @brief Removes the entry with the given name, if any.
+        void Remove(Symbol name);
+
+        /// @brief Returns the entry with the given name, or nullptr.
+        const NodeCatalogEntry *Find(Symbol name) const;
+
+        /// @brief Best matches for query, best first; a blank query lists the entries by category and
+        /// name. Pointers stay valid until the entry is removed.
+        std::vector<const NodeCatalogEntry *> Search(std::string_view query, size_t max_results) const;
+
+        size_t Size() const { return m_Entries.size(); }
+
+    private:
+        struct Item
+        {
+            NodeCatalogEntry entry;
+            TrigramIndex::EntryID indexID;
+        };
+
+        std::unordered_map<Symbol, Item> m_Entries;
+        std::vector<Symbol> m_NamesByIndexID;
+        TrigramIndex m_Index;
+    };
+
+    /// @brief Adds a typed node kind (see TypedNode.h) under Kind::kName.
+    template <typename Kind> void AddToCatalog(NodeCatalog &catalog, std::string category)
+    {
+        NodeCatalogEntry entry;
+        entry.name = NodeSignature<Kind>::GetName();
+        entry.category = std::move(category);
+        entry.create = [](const std::shared_ptr<ObjectPool> &pool) { return InstantiateNode<Kind>(pool); };
+        catalog.Add(std::move(entry));
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "core/Node.h"
+#include "runtime/Value.h"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    class ExecutionEventChannel;
+    class ResourceCache;
+    struct ExecutionPlan;
+
+    /// @brief View of one node's inputs and outputs during execution.
+    /// Passed to a NodeKernel; only valid for the duration of the call.
+    class ExecutionContext
+    {
+    public:
+        ExecutionContext(const ExecutionPlan &plan, size_t plan_index, std::vector<Value> &values,
+                         ExecutionEventChannel *events, ResourceCache *resources = nullptr)
+            : m_Plan(plan), m_PlanIndex(plan_index), m_Values(values), m_Events(events), m_Resources(resources)
+        {
+        }
+
+        /// @brief The node being executed.
+        const Node &GetNode() const;
+
+        /// @brief Value of a node parameter, or fallback if the node does not set it.
+        std::string GetParameter(const std::string &param_name, const std::string &fallback = {}) const;
+
+        // Pin names are compared as symbols; kernels that run often can keep theirs in statics
+        // rather than interning a string literal on every call.
+
+        /// @brief Returns true if the named input is connected to a value produced in this run.
+        bool HasInput(Symbol pin_name) const;
+
+        /// @brief Value flowing into the named input pin.
+        /// @throws std::runtime_error if the pin does not exist or is not connected.
+        const Value &GetInput(Symbol pin_name) const;
+
+        /// @brief Typed access to an input value (see Value::Get).
+        /// @throws std::runtime_error if the value has a different type.
+        template <typename T> decltype(auto) Input(Symbol pin_name) const { return GetInput(pin_name).Get<T>(); }
+
+        /// @brief Publishes the value of the named output pin.
+        /// @throws std::runtime_error if the node has no such output pin.
+        void SetOutput(Symbol pin_name, Value value);
+
+        // Positional access for kernels with a KernelSignature: index i is the signature's i-th
+        // input/output, which the planner guarantees; no names are compared.
+
+        /// @brief Value of the index-th data input, or nullptr if it is not connected.
+        const Value *FindInputAt(size_t index) const;
+
+        /// @brief Value of the index-th data input.
+        /// @throws std::runtime_error if it is not connected.
+        const Value &GetInputAt(size_t index) const;
+
+        /// @brief Publishes the value of the index-th data output.
+        void SetOutputAt(size_t index, Value value);
+
+        /// @brief Reports progress in [0, 1] to the UI (no-op when nobody listens).
+        void ReportProgress(float progress);
+
+        /// @brief Sends a short textual preview of an output to the UI.
+        void ReportPreview(std::string preview);
+
+        /// @brief Cache for what loader and model nodes load (weights, tokenizers, ...), which
+        /// outlives the run: the executor's (see Executor::SetResourceCache()), else
+        /// ResourceCache::Instance().
+        ResourceCache &GetResourceCache() const;
+
+    private:
+        const ExecutionPlan &m_Plan;
+        size_t m_PlanIndex;
+        std::vector<Value> &m_Values;
+        ExecutionEventChannel *m_Events;
+        ResourceCache *m_Resources;
+    };
+
+    /// @brief Implementation of a node kind.
+    using NodeKernel = std::function<void(ExecutionContext &)>;
+
+    /// @brief Where a kernel may run.
+    enum class ExecutionAffinity
+    {
+        Any,         /// @brief Any worker thread, in parallel with other nodes.
+        Interpreter, /// @brief Needs the embedded interpreter lock (e.g. the Python GIL); see InterpreterLock.
+    };
+
+    /// @brief Data pins a kernel binds by position (see TypedNode.h), in binding order.
+    struct KernelSignature
+    {
+        struct PinSpec
+        {
+            Symbol name;
+            PinType type;
+        };
+
+        std::vector<PinSpec> inputs;
+        std::vector<PinSpec> outputs;
+    };
+
+    /// @brief out = a (op) b for one pair of operand kinds (see Operators.h).
+    using BinaryOperatorFn = void (*)(const Value &a, const Value &b, Value &out);
+
+    /// @brief An operator's implementation for one pair of operand kinds.
+    struct BinaryOperatorEntry
+    {
+        BinaryOperatorFn apply = nullptr;    /// @brief nullptr if the operator does not apply.
+        ValueKind result = ValueKind::Empty; /// @brief Kind of the value apply produces.
+    };
+
+    /// @brief An operator's entries for every pair of operand kinds.
+    struct BinaryOperatorTable
+    {
+        std::array<BinaryOperatorEntry, kValueKindCount * kValueKindCount> entries;
+
+        const BinaryOperatorEntry &Find(ValueKind a, ValueKind b) const
+        {
+            return entries[static_cast<size_t>(a) * kValueKindCount + static_cast<size_t>(b)];
+        }
+    };
+
+    /// @brief A registered node implementation.
+    struct KernelInfo
+    {
+        /// @brief The implementation.
+        NodeKernel kernel;
+
+        /// @brief Runs even when none of its outputs are requested (saving, logging, ...).
+        bool sideEffects = false;
+
+        /// @brief Threading requirements of the kernel.
+        ExecutionAffinity affinity = ExecutionAffinity::Any;
+
+        /// @brief Set for kernels that use positional access. The planner orders a node's bindings
+        /// to match and rejects nodes whose data pins differ from it.
+        std::shared_ptr<const KernelSignature> signature;
+
+        /// @brief Set for binary operators (see Operators.h). The planner resolves the entry for
+        /// the operand kinds it expects into PlannedNode::binaryOperator, and accepts any pin
+        /// types on the node.
+        const BinaryOperatorTable *binaryOperator = nullptr;
+    };
+
+    /// @brief A global lock that Interpreter-affinity kernels must hold while running (the Python GIL).
+    /// The executor acquires it once per batch of consecutive interpreter nodes and never holds it
+    /// while running native kernels.
+    class InterpreterLock
+    {
+    public:
+        virtual ~InterpreterLock() = default;
+
+        /// @brief Blocks until the calling thread holds the lock.
+        virtual void Acquire() = 0;
+
+        /// @brief Releases the lock previously acquired on the calling thread.
+        virtual void Release() = 0;
+    };
+
+    /// @brief Maps node names to their implementations.
+    /// Populated at startup, then shared read-only with executors.
+    class KernelRegistry
+    {
+    public:
+        /// @brief Registers (or replaces) the implementation of nodes named node_name.
+        void Register(Symbol node_name, NodeKernel kernel, bool has_side_effects = false)
+        {
+            KernelInfo info;
+            info.kernel = std::move(kernel);
+            info.sideEffects = has_side_effects;
+            m_Kernels[node_name] = std::move(info);
+        }
+
+        /// @brief Registers (or replaces) a fully described implementation.
+        void Register(Symbol node_name, KernelInfo info) { m_Kernels[node_name] = std::move(info); }
+
+        /// @brief Returns the implementation for a node name, or nullptr if none is registered.
+        const KernelInfo *Find(Symbol node_name) const
+        {
+            auto it = m_Kernels.find(node_name);
+            return (it != m_Kernels.end()) ? &it->second : nullptr;
+        }
+
+    private:
+        std::unordered_map<Symbol, KernelInfo> m_Kernels;
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,238 @@
+#pragma once
+
+#include "core/Node.h"
+#include "runtime/NodeKernel.h"
+#include "runtime/TypedNode.h"
+#include "runtime/Value.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Applies f to every element of a vector, or to matching elements of two vectors.
+    /// @throws std::runtime_error if two vectors differ in length.
+    template <typename Fn> FloatVector Elementwise(const FloatVector &a, const FloatVector &b, Fn f)
+    {
+        if (a.size() != b.size())
+            throw std::runtime_error("Vectors differ in length (" + std::to_string(a.size()) + " and " +
+                                     std::to_string(b.size()) + ")");
+        FloatVector result(a.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            result[i] = f(a[i], b[i]);
+        return result;
+    }
+
+    template <typename Fn> FloatVector Elementwise(const FloatVector &a, double b, Fn f)
+    {
+        FloatVector result(a.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            result[i] = f(a[i], b);
+        return result;
+    }
+
+    template <typename Fn> FloatVector Elementwise(double a, const FloatVector &b, Fn f)
+    {
+        FloatVector result(b.size());
+        for (size_t i = 0; i < b.size(); ++i)
+            result[i] = f(a, b[i]);
+        return result;
+    }
+
+    namespace Detail
+    {
+        constexpr bool IsNumericKind(ValueKind kind)
+        {
+            return kind == ValueKind::Bool || kind == ValueKind::Int || kind == ValueKind::Float;
+        }
+
+        template <typename T> struct TypeTag
+        {
+            using type = T;
+        };
+
+        /// @brief The implicit conversions: what an operand of kind K is passed to Apply as when the
+        /// other operand is of kind Other. Bool and Int meet as int64_t; a number meeting a Float
+        /// or a Vector becomes a double; strings are passed as views. void: no conversion applies.
+        template <ValueKind K, ValueKind Other> constexpr auto OperandTypeTag()
+        {
+            if constexpr (IsNumericKind(K) && IsNumericKind(Other))
+                return TypeTag<std::conditional_t<K == ValueKind::Float || Other == ValueKind::Float, double, int64_t>>{};
+            else if constexpr (IsNumericKind(K) && Other == ValueKind::Vector)
+                return TypeTag<double>{};
+            else if constexpr (K == ValueKind::Vector && (IsNumericKind(Other) || Other == ValueKind::Vector))
+                return TypeTag<FloatVector>{};
+            else if constexpr (K == ValueKind::String && Other == ValueKind::String)
+                return TypeTag<std::string_view>{};
+            else
+                return TypeTag<void>{};
+        }
+
+        template <ValueKind K, ValueKind Other> using OperandType = typename decltype(OperandTypeTag<K, Other>())::type;
+
+        template <ValueKind K, typename T> decltype(auto) ReadOperand(const Value &value)
+        {
+            if constexpr (std::is_arithmetic_v<T>)
+                return static_cast<T>(value.GetUnchecked<K>());
+            else
+                return value.GetUnchecked<K>();
+        }
+
+        template <typename Kind, typename A, typename B, typename = void> struct HasApply : std::false_type
+        {
+        };
+
+        template <typename Kind, typename A, typename B>
+        struct HasApply<Kind, A, B, std::void_t<decltype(Kind::Apply(std::declval<A>(), std::declval<B>()))>>
+            : std::true_type
+        {
+        };
+
+        template <typename R> constexpr ValueKind ResultKindOf()
+        {
+            if constexpr (std::is_same_v<R, bool>)
+                return ValueKind::Bool;
+            else if constexpr (std::is_integral_v<R>)
+                return ValueKind::Int;
+            else if constexpr (std::is_floating_point_v<R>)
+                return ValueKind::Float;
+            else if constexpr (std::is_convertible_v<const R &, std::string_view>)
+                return ValueKind::String;
+            else if constexpr (std::is_same_v<R, FloatVector>)
+                return ValueKind::Vector;
+            else if constexpr (std::is_same_v<R, Buffer>)
+                return ValueKind::Buffer;
+            else
+                return ValueKind::Object;
+        }
+
+        /// @brief Entry for operands of kinds A and B: converts them as OperandType says and calls
+        /// Kind::Apply. The planner picks it from the kinds the producers' pins promise; a producer
+        /// that breaks that promise (e.g. a Python node) only costs a lookup in the table.
+        template <typename Kind, ValueKind A, ValueKind B> void ApplyScalars(const Value &a, const Value &b, Value &out)
+        {
+            if (a.GetKind() != A || b.GetKind() != B)
+                return Kind::Evaluate(a, b, out);
+            out = Value(Kind::Apply(ReadOperand<A, OperandType<A, B>>(a), ReadOperand<B, OperandType<B, A>>(b)));
+        }
+
+        /// @brief Entry lifting Kind::Apply(double, double) to vectors, elementwise, with numbers
+        /// broadcast to every element.
+        template <typename Kind, ValueKind A, ValueKind B> void ApplyElementwise(const Value &a, const Value &b, Value &out)
+        {
+            if (a.GetKind() != A || b.GetKind() != B)
+                return Kind::Evaluate(a, b, out);
+            auto apply = [](double x, double y) { return static_cast<double>(Kind::Apply(x, y)); };
+            out = Value(Elementwise(ReadOperand<A, OperandType<A, B>>(a), ReadOperand<B, OperandType<B, A>>(b), apply));
+        }
+
+        template <ValueKind A, ValueKind B> constexpr bool kIsElementwise =
+            (A == ValueKind::Vector && (B == ValueKind::Vector || IsNumericKind(B))) ||
+            (B == ValueKind::Vector && IsNumericKind(A));
+
+        template <typename Kind, size_t I> constexpr BinaryOperatorEntry MakeEntry()
+        {
+            constexpr ValueKind a = static_cast<ValueKind>(I / kValueKindCount);
+            constexpr ValueKind b = static_cast<ValueKind>(I % kValueKindCount);
+            using A = OperandType<a, b>;
+            using B = OperandType<b, a>;
+            if constexpr (kIsElementwise<a, b>)
+            {
+                if constexpr (HasApply<Kind, double, double>::value)
+                    return {&ApplyElementwise<Kind, a, b>, ValueKind::Vector};
+                else
+                    return {};
+            }
+            else if constexpr (HasApply<Kind, A, B>::value)
+                return {&ApplyScalars<Kind, a, b>,
+                        ResultKindOf<std::decay_t<decltype(Kind::Apply(std::declval<A>(), std::declval<B>()))>>()};
+            else
+                return {};
+        }
+
+        template <typename Kind, size_t... I> constexpr BinaryOperatorTable MakeTable(std::index_sequence<I...>)
+        {
+            return BinaryOperatorTable{{{MakeEntry<Kind, I>()...}}};
+        }
+    } // namespace Detail
+
+    /// @brief Base of a binary operator node kind, computing "result" from "a" and "b" for
+    /// operands of any kinds it has an Apply overload for:
+    ///
+    ///     struct MultiplyNode : BinaryOperator<MultiplyNode>
+    ///     {
+    ///         static constexpr const char *kName = "Multiply";
+    ///         static int64_t Apply(int64_t a, int64_t b) { return a * b; }
+    ///         static double Apply(double a, double b) { return a * b; }
+    ///     };
+    ///
+    /// A table with one entry per pair of operand kinds is generated at compile time from the
+    /// overloads, after the implicit conversions of Detail::OperandType (Bool + Float calls the
+    /// double overload); an Apply(double, double) also covers vectors, elementwise. The planner
+    /// resolves the entry once per node from the kinds of the connected outputs, so evaluating
+    /// the node is one call to it, without looking at the values' types.
+    ///
+    /// New nodes get pins of type Operand; nodes whose pins have other types are accepted too.
+    template <typename Kind, typename Operand = double> struct BinaryOperator
+    {
+        static constexpr NodeType kType = NodeType::Operator;
+        static constexpr std::array<const char *, 2> kInputs{"a", "b"};
+        static constexpr std::array<const char *, 1> kOutputs{"result"};
+
+        /// @brief Gives the signature (see NodeSignature) its pin types.
+        static Operand Execute(Operand a, Operand b) { return static_cast<Operand>(Kind::Apply(a, b)); }
+
+        static const BinaryOperatorTable &GetTable()
+        {
+            static constexpr BinaryOperatorTable table =
+                Detail::MakeTable<Kind>(std::make_index_sequence<kValueKindCount * kValueKindCount>{});
+            return table;
+        }
+
+        /// @brief out = a (op) b, looking the entry up from the operands' kinds.
+        /// @throws std::runtime_error if the operator does not apply to them.
+        static void Evaluate(const Value &a, const Value &b, Value &out)
+        {
+            const BinaryOperatorEntry &entry = GetTable().Find(a.GetKind(), b.GetKind());
+            if (!entry.apply)
+            {
+                if (!a.HasValue() || !b.HasValue())
+                    throw std::runtime_error("Operand '" + std::string(a.HasValue() ? "b" : "a") + "' has no value");
+                throw std::runtime_error(std::string("Unsupported operands: ") + GetValueKindName(a.GetKind()) +
+                                         " and " + GetValueKindName(b.GetKind()));
+            }
+            entry.apply(a, b, out);
+        }
+    };
+
+    /// @brief Kernel of a BinaryOperator kind: Evaluate on the inputs bound by position. Executors
+    /// call the planned entry instead when the operand kinds were known (PlannedNode::binaryOperator).
+    template <typename Kind> KernelInfo MakeOperatorKernel()
+    {
+        KernelInfo info;
+        info.signature = NodeSignature<Kind>::Get();
+        info.binaryOperator = &Kind::GetTable();
+        info.kernel = [](ExecutionContext &context)
+        {
+            Value result;
+            Kind::Evaluate(context.GetInputAt(0), context.GetInputAt(1), result);
+            context.SetOutputAt(0, std::move(result));
+        };
+        return info;
+    }
+
+    /// @brief Registers Kind's operator kernel under Kind::kName.
+    template <typename Kind> void RegisterOperator(KernelRegistry &registry)
+    {
+        registry.Register(NodeSignature<Kind>::GetName(), MakeOperatorKernel<Kind>());
+    }
+
+} // namespace MindWeaver
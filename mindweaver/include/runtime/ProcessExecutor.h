@@ -0,0 +1,106 @@
+#pragma once
+
+#include "core/GraphSnapshot.h"
+#include "runtime/ExecutionPlan.h"
+#include "runtime/Executor.h"
+#include "runtime/GraphPartitioner.h"
+#include "runtime/NodeKernel.h"
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    class ExecutionEventChannel;
+
+    /// @brief Callbacks run around fork() so embedded runtimes stay consistent in the workers
+    /// (e.g. PyOS_BeforeFork / PyOS_AfterFork_Child for Python). All are optional.
+    struct ProcessForkHooks
+    {
+        std::function<void()> prepare; /// @brief In the parent, right before each fork.
+        std::function<void()> parent;  /// @brief In the parent, right after each fork.
+        std::function<void()> child;   /// @brief In the new worker, before it runs any node.
+    };
+
+    /// @brief Runs execution plans across local worker processes.
+    ///
+    /// Every run partitions the plan (see PartitionExecutionPlan) and forks one worker per partition.
+    /// Workers inherit the plan and the kernel registry, so nothing about the graph is serialized;
+    /// they run their partition in dependency order and only exchange what crosses a partition
+    /// boundary. Small control messages (node finished, node failed, progress) and small values go
+    /// over a Unix socket to the coordinating parent, which routes them to the partitions that need
+    /// them. Buffers above the shared-memory threshold are written once into a POSIX shared-memory
+    /// segment and mapped by every consumer, so only the segment name travels over the socket.
+    ///
+    /// Each worker has its own interpreter (and GIL), and a crashing node only takes down its
+    /// worker: the run then fails with an error instead of taking the editor with it.
+    ///
+    /// Values crossing processes must be int, int64_t, float, double, bool, std::string or Buffer.
+    /// Workers are forked from the calling thread; kernels running in a worker must not depend on
+    /// locks that other threads of the parent might have held at fork time. Linux/POSIX only.
+    class ProcessExecutor
+    {
+    public:
+        /// @param registry Node implementations; must not be modified while runs are in flight.
+        /// @param process_count Maximum number of worker processes per run (0 = hardware concurrency).
+        explicit ProcessExecutor(std::shared_ptr<const KernelRegistry> registry, size_t process_count = 0);
+
+        ProcessExecutor(const ProcessExecutor &) = delete;
+        ProcessExecutor &operator=(const ProcessExecutor &) = delete;
+
+        /// @brief Status/progress events of every run are posted here (optional).
+        /// Progress and previews reported by a worker are forwarded when its node finishes.
+        void SetEventChannel(std::shared_ptr<ExecutionEventChannel> channel);
+
+        /// @brief Lock held around Interpreter-affinity nodes inside each worker (optional).
+        void SetInterpreterLock(std::shared_ptr<InterpreterLock> lock);
+
+        /// @brief Cache kernels load resources into; without one, ResourceCache::Instance().
+        /// Workers inherit what the parent has loaded; what a worker loads is gone when it exits.
+        void SetResourceCache(std::shared_ptr<ResourceCache> cache);
+
+        void SetForkHooks(ProcessForkHooks hooks);
+
+        /// @brief Estimates used to partition plans.
+        void SetCostModel(PartitionCostModel model);
+
+        /// @brief Buffers of at least this many bytes cross processes through shared memory;
+        /// smaller ones are copied inline into the socket message. Default 64 KiB.
+        void SetSharedMemoryThreshold(size_t bytes);
+
+        /// @brief Records per-node measurements into ExecutionResult::stats (off by default).
+        /// Each worker process measures its own nodes; stats threads are worker processes.
+        void SetCollectStats(bool collect) { m_CollectStats = collect; }
+
+        /// @brief Builds the minimal plan for a request against a snapshot.
+        ExecutionPlan Prepare(const GraphSnapshot &snapshot, const ExecutionRequest &request = {}) const;
+
+        /// @brief Runs a prepared plan to completion; blocks until every worker has exited.
+        ExecutionResult Run(const ExecutionPlan &plan);
+
+        /// @brief Prepares and runs a request against a snapshot.
+        /// Planning errors (cycles, unknown target pins) are reported through the result.
+        ExecutionResult Run(const GraphSnapshot &snapshot, const ExecutionRequest &request = {});
+
+        /// @brief Runs a request on a background thread. The executor must outlive the returned future.
+        std::future<ExecutionResult> RunAsync(GraphSnapshot snapshot, ExecutionRequest request = {});
+
+        const KernelRegistry &GetRegistry() const { return *m_Registry; }
+
+    private:
+        std::shared_ptr<const KernelRegistry> m_Registry;
+        std::shared_ptr<ExecutionEventChannel> m_Events;
+        std::shared_ptr<InterpreterLock> m_InterpreterLock;
+        std::shared_ptr<ResourceCache> m_Resources;
+        ProcessForkHooks m_ForkHooks;
+        PartitionCostModel m_CostModel;
+        size_t m_SharedMemoryThreshold = 64 * 1024;
+        size_t m_ProcessCount;
+        bool m_CollectStats = false;
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "runtime/MappedFile.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Identifies a cached resource: the file it was loaded from plus the load parameters.
+    /// Two loads of the same file with different parameters (dtype, device, ...) are distinct entries.
+    struct ResourceKey
+    {
+        std::string path;   /// @brief Path of the source file.
+        std::string params; /// @brief Canonical parameter string (e.g. "dtype=fp16;device=cpu").
+
+        bool operator==(const ResourceKey &other) const { return path == other.path && params == other.params; }
+        bool operator!=(const ResourceKey &other) const { return !(*this == other); }
+    };
+
+} // namespace MindWeaver
+
+namespace std
+{
+    template <> struct hash<MindWeaver::ResourceKey>
+    {
+        std::size_t operator()(const MindWeaver::ResourceKey &key) const noexcept
+        {
+            std::size_t h = std::hash<std::string>{}(key.path);
+            h ^= std::hash<std::string>{}(key.params) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+} // namespace std
+
+namespace MindWeaver
+{
+
+    /// @brief Point-in-time counters of a ResourceCache.
+    struct ResourceCacheStats
+    {
+        uint64_t hits = 0;        /// @brief Acquires served from an existing (or in-flight) entry.
+        uint64_t misses = 0;      /// @brief Acquires that had to run the loader.
+        uint64_t evictions = 0;   /// @brief Entries dropped to stay within the budget.
+        size_t bytesResident = 0; /// @brief Bytes accounted to all resident entries.
+        size_t bytesPinned = 0;   /// @brief Bytes accounted to entries currently in use.
+        size_t budgetBytes = 0;   /// @brief Configured memory budget.
+        size_t entryCount = 0;    /// @brief Number of resident entries.
+    };
+
+    /// @brief Process-wide cache of loaded resources (model weights, tokenizers, ...).
+    ///
+    /// Entries are keyed by ResourceKey and accounted against a byte budget. Acquire() returns a
+    /// shared_ptr that pins the entry: pinned entries are never evicted, and once the last handle
+    /// is released the entry becomes a candidate for least-recently-used eviction. Because the
+    /// cache outlives any single graph execution, a second run of the same graph finds its
+    /// resources already resident and skips the loaders entirely.
+    ///
+    /// Concurrent acquires of the same missing key run the loader once; the other callers block
+    /// until it finishes and then share the result.
+    class ResourceCache
+    {
+    public:
+        /// @brief Loader callback: produces the resource and reports its size in bytes.
+        template <typename T> using Loader = std::function<std::shared_ptr<T>(size_t &out_bytes)>;
+
+        static constexpr size_t kDefaultBudgetBytes = size_t(4) << 30; // 4 GiB
+
+        /// @brief The process-wide cache instance.
+        static ResourceCache &Instance();
+
+        explicit ResourceCache(size_t budget_bytes = kDefaultBudgetBytes);
+        ~ResourceCache();
+
+        ResourceCache(const ResourceCache &) = delete;
+        ResourceCache &operator=(const ResourceCache &) = delete;
+
+        /// @brief Returns the resource for key, running loader on a miss.
+        /// The returned handle pins the entry until it (and all copies) are destroyed.
+        /// @throws std::runtime_error if the key is already cached with a different type,
+        /// or whatever the loader throws.
+        template <typename T> std::shared_ptr<T> Acquire(const ResourceKey &key, const Loader<T> &loader)
+        {
+            std::shared_ptr<void> pinned = AcquireErased(key, typeid(T),
+                                                         [&](size_t &out_bytes) -> std::shared_ptr<void>
+                                                         { return std::const_pointer_cast<void>(
+                                                               std::static_pointer_cast<const void>(loader(out_bytes))); });
+            return std::static_pointer_cast<T>(pinned);
+        }
+
+        /// @brief Memory-maps a weight file through the cache.
+        /// The mapping is accounted at its full file size.
+        std::shared_ptr<const MappedFile> AcquireMappedFile(const std::string &path);
+
+        /// @brief Returns true if key is resident (does not touch LRU order or counters).
+        bool Contains(const ResourceKey &key) const;
+
+        /// @brief Changes the memory budget, evicting unpinned entries if now over it.
+        void SetBudget(size_t budget_bytes);
+        size_t GetBudget() const { return m_BudgetBytes.load(std::memory_order_relaxed); }
+
+        /// @brief Evicts every unpinned entry.
+        void Trim();
+
+        /// @brief Snapshot of the cache counters.
+        ResourceCacheStats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            ResourceKey key;
+            std::type_index type = typeid(void);
+            std::shared_ptr<void> resource;
+            size_t bytes = 0;
+            size_t pins = 0;
+            bool ready = false;
+            std::exception_ptr error;
+            std::list<std::shared_ptr<Entry>>::iterator lruPos;
+        };
+
+        /// @brief Releases one pin when the last copy of a handle dies.
+        struct Unpinner
+        {
+            ResourceCache *cache;
+            std::shared_ptr<Entry> entry;
+            void operator()(void *) const { cache->Unpin(entry); }
+        };
+
+        using ErasedLoader = std::function<std::shared_ptr<void>(size_t &out_bytes)>;
+
+        std::shared_ptr<void> AcquireErased(const ResourceKey &key, std::type_index type, const ErasedLoader &loader);
+        std::shared_ptr<void> MakeHandle(const std::shared_ptr<Entry> &entry);
+        void Unpin(const std::shared_ptr<Entry> &entry);
+
+        /// @brief Evicts LRU unpinned entries until within target_bytes. Caller holds m_Mutex.
+        /// Evicted resources are moved into graveyard so they are destroyed outside the lock.
+        void EvictLocked(size_t target_bytes, std::vector<std::shared_ptr<void>> &graveyard);
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_LoadFinished;
+        std::unordered_map<ResourceKey, std::shared_ptr<Entry>> m_Entries;
+        std::list<std::shared_ptr<Entry>> m_Lru; // Ready entries, most recently used first
+        size_t m_BytesResident = 0;
+        size_t m_BytesPinned = 0;
+
+        std::atomic<size_t> m_BudgetBytes;
+        std::atomic<uint64_t> m_Hits{0};
+        std::atomic<uint64_t> m_Misses{0};
+        std::atomic<uint64_t> m_Evictions{0};
+    };
+
+} // namespace MindWeaver
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief A named POSIX shared-memory segment (shm_open + mmap).
+    /// Used to hand large values between worker processes: the producer writes the segment once and
+    /// every consumer maps the same pages instead of receiving a copy over a socket.
+    class SharedMemorySegment
+    {
+    public:
+        /// @brief Creates a new segment of the given size, mapped read-write.
+        /// @param name Segment name ("/name"); must not exist yet.
+        /// @throws std::runtime_error if the segment cannot be created or mapped.
+        static std::shared_ptr<SharedMemorySegment> Create(const std::string &name, size_t size);
+
+        /// @brief Maps an existing segment read-only.
+        /// @throws std::runtime_error if the segment does not exist or cannot be mapped.
+        static std::shared_ptr<SharedMemorySegment> Open(const std::string &name);
+
+        /// @brief Removes a segment name; existing mappings stay valid. Missing names are ignored.
+        static void Unlink(const std::string &name);
+
+        ~SharedMemorySegment();
+
+        SharedMemorySegment(const SharedMemorySegment &) = delete;
+        SharedMemorySegment &operator=(const SharedMemorySegment &) = delete;
+
+        /// @brief First byte of the mapping (nullptr for empty segments).
+        /// Only segments from Create() may be written.
+        uint8_t *Data() const { return m_Data; }
+
+        size_t Size() const { return m_Size; }
+
+        const std::string &GetName() const { return m_Name; }
+
+    private:
+        SharedMemorySegment(const std::string &name, bool create, size_t size);
+
+        std::string m_Name;
+        uint8_t *m_Data = nullptr;
+        size_t m_Size = 0;
+    };
+
+} // namespace MindWeaver
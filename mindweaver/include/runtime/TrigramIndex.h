@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Incrementally maintained trigram index for fuzzy, ranked matching of short texts
+    /// (node-type names and categories in the palette).
+    ///
+    /// Every word of an entry is lowercased and padded ("  add ") before being cut into trigrams, so
+    /// word starts carry their own trigrams and one- or two-letter queries still match prefixes. A
+    /// query only visits the posting lists of its own trigrams: the cost grows with the number of
+    /// entries sharing trigrams with the query, not with the size of the index. Candidates are
+    /// ranked by the share of query trigrams they contain, with bonuses for exact, prefix and
+    /// substring matches, so typos ("mulitply") still find their target.
+    class TrigramIndex
+    {
+    public:
+        using EntryID = uint32_t;
+
+        struct Match
+        {
+            EntryID id;
+            float score; /// @brief Higher is better; 1 means every query trigram matched.
+        };
+
+        /// @brief Indexes text and returns its ID (IDs of removed entries are reused).
+        EntryID Add(std::string_view text);
+
+        /// @brief Removes an entry; unknown IDs are ignored.
+        void Remove(EntryID id);
+
+        /// @brief Best matches for query, best first. An empty query matches nothing.
+        std::vector<Match> Search(std::string_view query, size_t max_results) const;
+
+        /// @brief Number of live entries.
+        size_t Size() const { return m_Entries.size() - m_FreeIDs.size(); }
+
+    private:
+        struct Entry
+        {
+            std::string text; // Lowercased
+            std::vector<uint32_t> trigrams;
+            bool alive = false;
+        };
+
+        std::vector<Entry> m_Entries;
+        std::vector<EntryID> m_FreeIDs;
+        std::unordered_map<uint32_t, std::vector<EntryID>> m_Postings; // Trigram -> entries containing it
+    };
+
+} // namespace MindWeaver
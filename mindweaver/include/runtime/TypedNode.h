@@ -0,0 +1,235 @@
+#pragma once
+
+#include "core/Node.h"
+#include "core/ObjectPool.h"
+#include "core/Symbol.h"
+#include "runtime/Buffer.h"
+#include "runtime/NodeKernel.h"
+#include "runtime/Value.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief Pin type carrying values of C++ type T (specialized for every supported value type).
+    template <typename T> struct PinTypeOf;
+    template <> struct PinTypeOf<bool> : std::integral_constant<PinType, PinType::Bool> {};
+    template <> struct PinTypeOf<int> : std::integral_constant<PinType, PinType::Int> {};
+    template <> struct PinTypeOf<int64_t> : std::integral_constant<PinType, PinType::Int> {};
+    template <> struct PinTypeOf<float> : std::integral_constant<PinType, PinType::Float> {};
+    template <> struct PinTypeOf<double> : std::integral_constant<PinType, PinType::Float> {};
+    template <> struct PinTypeOf<std::string> : std::integral_constant<PinType, PinType::String> {};
+    template <> struct PinTypeOf<FloatVector> : std::integral_constant<PinType, PinType::Vector> {};
+    template <> struct PinTypeOf<Buffer> : std::integral_constant<PinType, PinType::Buffer> {};
+
+    /// @brief An optional input: std::nullopt when the pin is not connected.
+    template <typename T> struct PinTypeOf<std::optional<T>> : PinTypeOf<T> {};
+
+    namespace Detail
+    {
+        template <typename Fn> struct ExecuteTraits;
+
+        template <typename R, typename... Args> struct ExecuteTraits<R (*)(Args...)>
+        {
+            static constexpr bool kTakesContext = false;
+            using Result = R;
+            using Inputs = std::tuple<std::decay_t<Args>...>;
+        };
+
+        /// @brief Execute(ExecutionContext &, inputs...) may report progress or read parameters.
+        template <typename R, typename... Args> struct ExecuteTraits<R (*)(ExecutionContext &, Args...)>
+        {
+            static constexpr bool kTakesContext = true;
+            using Result = R;
+            using Inputs = std::tuple<std::decay_t<Args>...>;
+        };
+
+        /// @brief Outputs as a tuple: void -> none, std::tuple<Ts...> -> Ts..., anything else -> one.
+        template <typename R> struct OutputTuple
+        {
+            using type = std::tuple<R>;
+        };
+        template <> struct OutputTuple<void>
+        {
+            using type = std::tuple<>;
+        };
+        template <typename... Ts> struct OutputTuple<std::tuple<Ts...>>
+        {
+            using type = std::tuple<Ts...>;
+        };
+
+        template <typename Tuple, size_t... I>
+        constexpr std::array<PinType, sizeof...(I)> PinTypes(std::index_sequence<I...>)
+        {
+            return {PinTypeOf<std::tuple_element_t<I, Tuple>>::value...};
+        }
+
+        /// @brief Reads an input value: an exact kind match is one tag comparison; other numbers
+        /// (e.g. an Int from Python feeding a double) are converted.
+        template <typename T, typename = void> struct InputReader
+        {
+            static decltype(auto) Read(const Value &value) { return value.Get<T>(); }
+        };
+
+        template <typename T> struct InputReader<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+        {
+            static T Read(const Value &value)
+            {
+                constexpr ValueKind kind = std::is_same_v<T, bool>        ? ValueKind::Bool
+                                           : std::is_floating_point_v<T> ? ValueKind::Float
+                                                                         : ValueKind::Int;
+                if (value.GetKind() == kind)
+                    return static_cast<T>(value.GetUnchecked<kind>());
+                return value.To<T>();
+            }
+        };
+
+        template <typename T> struct ArgumentBinder
+        {
+            static decltype(auto) Bind(const ExecutionContext &context, size_t index)
+            {
+                return InputReader<T>::Read(context.GetInputAt(index));
+            }
+        };
+
+        template <typename T> struct ArgumentBinder<std::optional<T>>
+        {
+            static std::optional<T> Bind(const ExecutionContext &context, size_t index)
+            {
+                const Value *value = context.FindInputAt(index);
+                return value ? std::optional<T>(InputReader<T>::Read(*value)) : std::nullopt;
+            }
+        };
+
+        template <typename Kind, typename Inputs, size_t... I>
+        decltype(auto) CallExecute(ExecutionContext &context, std::index_sequence<I...>)
+        {
+            if constexpr (ExecuteTraits<decltype(&Kind::Execute)>::kTakesContext)
+                return Kind::Execute(context, ArgumentBinder<std::tuple_element_t<I, Inputs>>::Bind(context, I)...);
+            else
+                return Kind::Execute(ArgumentBinder<std::tuple_element_t<I, Inputs>>::Bind(context, I)...);
+        }
+
+        template <typename Tuple, size_t... I>
+        void PublishOutputs(ExecutionContext &context, Tuple &&outputs, std::index_sequence<I...>)
+        {
+            (context.SetOutputAt(I, Value(std::get<I>(std::forward<Tuple>(outputs)))), ...);
+        }
+    } // namespace Detail
+
+    /// @brief Compile-time description of a node kind declared in C++.
+    ///
+    /// A kind is a struct naming itself and its pins, with a static Execute whose parameters are the
+    /// inputs and whose return value is the output (a std::tuple for several, void for none):
+    ///
+    ///     struct HypotNode
+    ///     {
+    ///         static constexpr const char *kName = "Hypot";
+    ///         static constexpr NodeType kType = NodeType::Function;
+    ///         static constexpr std::array<const char *, 2> kInputs{"x", "y"};
+    ///         static constexpr std::array<const char *, 1> kOutputs{"result"};
+    ///         static double Execute(double x, double y) { return std::hypot(x, y); }
+    ///     };
+    ///
+    /// Execute may also take an ExecutionContext & first (progress, parameters). An input declared
+    /// std::optional<T> may be left unconnected. Pin types follow from the C++ types (PinTypeOf),
+    /// and mismatched name counts fail to compile. Arithmetic on several operand types is better
+    /// written as a BinaryOperator (see Operators.h).
+    template <typename Kind> struct NodeSignature
+    {
+        using Traits = Detail::ExecuteTraits<decltype(&Kind::Execute)>;
+        using Inputs = typename Traits::Inputs;
+        using Outputs = typename Detail::OutputTuple<typename Traits::Result>::type;
+
+        static constexpr size_t kInputCount = std::tuple_size_v<Inputs>;
+        static constexpr size_t kOutputCount = std::tuple_size_v<Outputs>;
+
+        static_assert(Kind::kInputs.size() == kInputCount, "kInputs must name every Execute parameter");
+        static_assert(Kind::kOutputs.size() == kOutputCount, "kOutputs must name every Execute result");
+
+        static constexpr std::array<PinType, kInputCount> kInputTypes =
+            Detail::PinTypes<Inputs>(std::make_index_sequence<kInputCount>{});
+        static constexpr std::array<PinType, kOutputCount> kOutputTypes =
+            Detail::PinTypes<Outputs>(std::make_index_sequence<kOutputCount>{});
+
+        /// @brief Interned names and types, built once per kind.
+        static const std::shared_ptr<const KernelSignature> &Get()
+        {
+            static const std::shared_ptr<const KernelSignature> signature = []
+            {
+                auto built = std::make_shared<KernelSignature>();
+                for (size_t i = 0; i < kInputCount; ++i)
+                    built->inputs.push_back({Symbol(Kind::kInputs[i]), kInputTypes[i]});
+                for (size_t i = 0; i < kOutputCount; ++i)
+                    built->outputs.push_back({Symbol(Kind::kOutputs[i]), kOutputTypes[i]});
+                return built;
+            }();
+            return signature;
+        }
+
+        static Symbol GetName()
+        {
+            static const Symbol name(Kind::kName);
+            return name;
+        }
+    };
+
+    /// @brief Kernel calling Kind::Execute with its inputs bound by position.
+    template <typename Kind> KernelInfo MakeTypedKernel(bool has_side_effects = false)
+    {
+        using Signature = NodeSignature<Kind>;
+
+        KernelInfo info;
+        info.sideEffects = has_side_effects;
+        info.signature = Signature::Get();
+        info.kernel = [](ExecutionContext &context)
+        {
+            using Inputs = typename Signature::Inputs;
+            constexpr auto input_indices = std::make_index_sequence<Signature::kInputCount>{};
+            if constexpr (Signature::kOutputCount == 0)
+                Detail::CallExecute<Kind, Inputs>(context, input_indices);
+            else if constexpr (std::is_same_v<typename Signature::Traits::Result, typename Signature::Outputs>)
+                Detail::PublishOutputs(context, Detail::CallExecute<Kind, Inputs>(context, input_indices),
+                                       std::make_index_sequence<Signature::kOutputCount>{});
+            else
+                context.SetOutputAt(0, Value(Detail::CallExecute<Kind, Inputs>(context, input_indices)));
+        };
+        return info;
+    }
+
+    /// @brief Registers Kind's kernel under Kind::kName.
+    template <typename Kind> void RegisterNode(KernelRegistry &registry, bool has_side_effects = false)
+    {
+        registry.Register(NodeSignature<Kind>::GetName(), MakeTypedKernel<Kind>(has_side_effects));
+    }
+
+    /// @brief Creates a node of Kind with its pins laid out from the signature, allocated from pool
+    /// (e.g. Graph::GetPool(); optional). No strings are interned after the first call per kind.
+    template <typename Kind>
+    std::shared_ptr<Node> InstantiateNode(const std::shared_ptr<ObjectPool> &pool = nullptr,
+                                          const UUID &node_id = UUID::generate())
+    {
+        using Signature = NodeSignature<Kind>;
+        const KernelSignature &signature = *Signature::Get();
+
+        auto node = MakePooled<Node>(pool, node_id, Signature::GetName(), Kind::kType, pool);
+        node->inputPins.reserve(Signature::kInputCount);
+        node->outputPins.reserve(Signature::kOutputCount);
+        for (const auto &spec : signature.inputs)
+            node->AddInputPin(spec.name, spec.type);
+        for (const auto &spec : signature.outputs)
+            node->AddOutputPin(spec.name, spec.type);
+        return node;
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "core/Pin.h"
+#include "runtime/Buffer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+/// @brief Project Namespace
+namespace MindWeaver
+{
+
+    /// @brief What a Value holds.
+    enum class ValueKind : uint8_t
+    {
+        Empty,  /// @brief No value (unconnected or not yet produced).
+        Bool,   /// @brief bool.
+        Int,    /// @brief int64_t; every integral type is stored as one.
+        Float,  /// @brief double; float is stored as one.
+        String, /// @brief UTF-8 text, stored inline up to Value::kInlineStringCapacity bytes.
+        Vector, /// @brief FloatVector.
+        Buffer, /// @brief Buffer (see Buffer.h).
+        Object, /// @brief Any other C++ type, e.g. a PythonObject.
+    };
+
+    constexpr size_t kValueKindCount = 8;
+
+    /// @brief Display name of a kind ("Int", ...).
+    const char *GetValueKindName(ValueKind kind);
+
+    /// @brief Kind of the values carried by pins of type (Empty for Exec, Object for Class).
+    ValueKind GetValueKind(PinType type);
+
+    /// @brief Values carried by PinType::Vector pins.
+    using FloatVector = std::vector<double>;
+
+    /// @brief A pin value: a 24-byte tagged union.
+    ///
+    /// Scalars and strings of up to kInlineStringCapacity bytes are stored inline, so producing
+    /// and copying them never allocates. Longer strings, vectors, buffers and objects live in a
+    /// shared, immutable heap block; copying the Value takes a reference (an atomic increment), so
+    /// values can be copied and destroyed on any thread.
+    ///
+    /// Any C++ value converts implicitly: bool, integral and floating-point types, strings,
+    /// FloatVector and Buffer map to their kinds and everything else becomes an Object.
+    class Value
+    {
+    public:
+        static constexpr size_t kInlineStringCapacity = 22;
+
+        Value() noexcept : m_Kind(ValueKind::Empty) {}
+
+        template <typename T, typename = std::enable_if_t<!std::is_same_v<std::decay_t<T>, Value>>>
+        Value(T &&value)
+        {
+            Assign(std::forward<T>(value));
+        }
+
+        Value(const Value &other) noexcept : m_Kind(other.m_Kind)
+        {
+            std::memcpy(m_Storage, other.m_Storage, sizeof(m_Storage));
+            if (IsShared())
+                GetHeap()->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Value(Value &&other) noexcept : m_Kind(other.m_Kind)
+        {
+            std::memcpy(m_Storage, other.m_Storage, sizeof(m_Storage));
+            other.m_Kind = ValueKind::Empty;
+        }
+
+        Value &operator=(const Value &other) noexcept
+        {
+            if (this != &other)
+            {
+                Value copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        Value &operator=(Value &&other) noexcept
+        {
+            if (this != &other)
+            {
+                Release();
+                m_Kind = other.m_Kind;
+                std::memcpy(m_Storage, other.m_Storage, sizeof(m_Storage));
+                other.m_Kind = ValueKind::Empty;
+            }
+            return *this;
+        }
+
+        ~Value() { Release(); }
+
+        ValueKind GetKind() const { return m_Kind; }
+        bool HasValue() const { return m_Kind != ValueKind::Empty; }
+
+        void Reset()
+        {
+            Release();
+            m_Kind = ValueKind::Empty;
+        }
+
+        /// @brief Access without a kind check, for callers that already know it (dispatch tables).
+        template <ValueKind K> decltype(auto) GetUnchecked() const
+        {
+            if constexpr (K == ValueKind::Bool)
+                return m_Storage[0] != 0;
+            else if constexpr (K == ValueKind::Int)
+                return Load<int64_t>();
+            else if constexpr (K == ValueKind::Float)
+                return Load<double>();
+            else if constexpr (K == ValueKind::String)
+            {
+                if (IsInlineString())
+                    return std::string_view(reinterpret_cast<const char *>(m_Storage), m_Storage[kLengthByte]);
+                return std::string_view(static_cast<const HeapValue<std::string> *>(GetHeap())->value);
+            }
+            else if constexpr (K == ValueKind::Vector)
+                return static_cast<const FloatVector &>(static_cast<const HeapValue<FloatVector> *>(GetHeap())->value);
+            else if constexpr (K == ValueKind::Buffer)
+                return static_cast<const Buffer &>(static_cast<const HeapValue<Buffer> *>(GetHeap())->value);
+            else
+                static_assert(K == ValueKind::Bool, "GetUnchecked() does not apply to this kind");
+        }
+
+        // Checked accessors: each throws std::runtime_error if the value is of another kind.
+
+        bool GetBool() const
+        {
+            CheckKind(ValueKind::Bool);
+            return GetUnchecked<ValueKind::Bool>();
+        }
+
+        int64_t GetInt() const
+        {
+            CheckKind(ValueKind::Int);
+            return GetUnchecked<ValueKind::Int>();
+        }
+
+        double GetFloat() const
+        {
+            CheckKind(ValueKind::Float);
+            return GetUnchecked<ValueKind::Float>();
+        }
+
+        /// @brief Valid as long as this Value (or a copy of it) is alive.
+        std::string_view GetString() const
+        {
+            CheckKind(ValueKind::String);
+            return GetUnchecked<ValueKind::String>();
+        }
+
+        const FloatVector &GetVector() const
+        {
+            CheckKind(ValueKind::Vector);
+            return GetUnchecked<ValueKind::Vector>();
+        }
+
+        const Buffer &GetBuffer() const
+        {
+            CheckKind(ValueKind::Buffer);
+            return GetUnchecked<ValueKind::Buffer>();
+        }
+
+        /// @brief The held object if it is a T, else nullptr.
+        template <typename T> const T *GetObject() const
+        {
+            if (m_Kind != ValueKind::Object || GetHeap()->GetType() != typeid(T))
+                return nullptr;
+            return &static_cast<const HeapValue<T> *>(GetHeap())->value;
+        }
+
+        /// @brief Type of the held object (typeid(void) unless the kind is Object).
+        const std::type_info &GetObjectType() const
+        {
+            return m_Kind == ValueKind::Object ? GetHeap()->GetType() : typeid(void);
+        }
+
+        /// @brief The value as a T, which must match the kind exactly (any integral type reads an
+        /// Int, float or double reads a Float). Returns a reference for heap kinds.
+        /// @throws std::runtime_error on a kind or object type mismatch.
+        template <typename T> decltype(auto) Get() const
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return GetBool();
+            else if constexpr (std::is_integral_v<T>)
+                return static_cast<T>(GetInt());
+            else if constexpr (std::is_floating_point_v<T>)
+                return static_cast<T>(GetFloat());
+            else if constexpr (std::is_same_v<T, std::string>)
+                return std::string(GetString());
+            else if constexpr (std::is_same_v<T, std::string_view>)
+                return GetString();
+            else if constexpr (std::is_same_v<T, FloatVector>)
+                return GetVector();
+            else if constexpr (std::is_same_v<T, Buffer>)
+                return GetBuffer();
+            else
+            {
+                const T *object = GetObject<T>();
+                if (!object)
+                    ThrowObjectMismatch(typeid(T));
+                return *object;
+            }
+        }
+
+        /// @brief A Bool, Int or Float converted to the arithmetic type T.
+        /// @throws std::runtime_error for other kinds.
+        template <typename T> T To() const
+        {
+            static_assert(std::is_arithmetic_v<T>, "To<T>() converts between numbers only");
+            switch (m_Kind)
+            {
+            case ValueKind::Bool:
+                return static_cast<T>(GetUnchecked<ValueKind::Bool>());
+            case ValueKind::Int:
+                return static_cast<T>(GetUnchecked<ValueKind::Int>());
+            case ValueKind::Float:
+                return static_cast<T>(GetUnchecked<ValueKind::Float>());
+            default:
+                ThrowKindMismatch(std::is_floating_point_v<T> ? ValueKind::Float : ValueKind::Int);
+            }
+        }
+
+    private:
+        /// @brief Shared, immutable payload of the heap kinds.
+        struct Heap
+        {
+            std::atomic<uint32_t> refs{1};
+
+            virtual ~Heap() = default;
+            virtual const std::type_info &GetType() const = 0;
+        };
+
+        template <typename T> struct HeapValue final : Heap
+        {
+            template <typename U> explicit HeapValue(U &&init) : value(std::forward<U>(init)) {}
+            const std::type_info &GetType() const override { return typeid(T); }
+
+            T value;
+        };
+
+        static constexpr size_t kLengthByte = kInlineStringCapacity; // Inline string length
+        static constexpr unsigned char kHeapString = 0xFF;            // ... or a heap string
+
+        template <typename T> T Load() const
+        {
+            T value;
+            std::memcpy(&value, m_Storage, sizeof(T));
+            return value;
+        }
+
+        template <typename T> void Store(T value) { std::memcpy(m_Storage, &value, sizeof(T)); }
+
+        Heap *GetHeap() const { return Load<Heap *>(); }
+
+        bool IsInlineString() const { return m_Storage[kLengthByte] != kHeapString; }
+
+        bool IsShared() const
+        {
+            return m_Kind >= ValueKind::Vector || (m_Kind == ValueKind::String && !IsInlineString());
+        }
+
+        template <typename T, typename U> void StoreHeap(ValueKind kind, U &&init)
+        {
+            Store<Heap *>(new HeapValue<T>(std::forward<U>(init)));
+            m_Kind = kind;
+        }
+
+        void AssignString(std::string_view text)
+        {
+            if (text.size() <= kInlineStringCapacity)
+            {
+                std::memcpy(m_Storage, text.data(), text.size());
+                m_Storage[kLengthByte] = static_cast<unsigned char>(text.size());
+                m_Kind = ValueKind::String;
+                return;
+            }
+            StoreHeap<std::string>(ValueKind::String, text);
+            m_Storage[kLengthByte] = kHeapString;
+        }
+
+        template <typename T> void Assign(T &&value)
+        {
+            using D = std::decay_t<T>;
+            if constexpr (std::is_same_v<D, bool>)
+            {
+                m_Storage[0] = value ? 1 : 0;
+                m_Kind = ValueKind::Bool;
+            }
+            else if constexpr (std::is_integral_v<D>)
+            {
+                Store<int64_t>(static_cast<int64_t>(value));
+                m_Kind = ValueKind::Int;
+            }
+            else if constexpr (std::is_floating_point_v<D>)
+            {
+                Store<double>(static_cast<double>(value));
+                m_Kind = ValueKind::Float;
+            }
+            else if constexpr (std::is_same_v<D, std::string>)
+            {
+                if (value.size() <= kInlineStringCapacity)
+                    AssignString(value);
+                else
+                {
+                    StoreHeap<std::string>(ValueKind::String, std::forward<T>(value));
+                    m_Storage[kLengthByte] = kHeapString;
+                }
+            }
+            else if constexpr (std::is_convertible_v<const D &, std::string_view>)
+                AssignString(std::string_view(value));
+            else if constexpr (std::is_same_v<D, FloatVector>)
+                StoreHeap<FloatVector>(ValueKind::Vector, std::forward<T>(value));
+            else if constexpr (std::is_same_v<D, Buffer>)
+                StoreHeap<Buffer>(ValueKind::Buffer, std::forward<T>(value));
+            else
+                StoreHeap<D>(ValueKind::Object, std::forward<T>(value));
+        }
+
+        void Release() noexcept
+        {
+            if (IsShared())
+            {
+                Heap *heap = GetHeap();
+                if (heap->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    delete heap;
+            }
+        }
+
+        void CheckKind(ValueKind expected) const
+        {
+            if (m_Kind != expected)
+                ThrowKindMismatch(expected);
+        }
+
+        [[noreturn]] void ThrowKindMismatch(ValueKind expected) const;
+        [[noreturn]] void ThrowObjectMismatch(const std::type_info &expected) const;
+
+        alignas(8) unsigned char m_Storage[kInlineStringCapacity + 1];
+        ValueKind m_Kind;
+    };
+
+    static_assert(sizeof(Value) == 24, "Value is meant to stay three words");
+
+} // namespace MindWeaver
@@ -1,17 +1,26 @@
 #pragma once
 
+#include "core/UUID.h"
+#include "runtime/ExecutionEvents.h"
+#include "runtime/ExecutionStats.h"
+
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+struct ImVec2;
+
 // Forward declare core types to reduce header dependencies
 namespace MindWeaver
 {
     class Graph;
+    class NodeCatalog;
     struct Node; // For internal iteration, full definition not strictly needed in header
     struct Link; // For internal iteration
     struct Pin;  // For internal iteration
-    struct UUID; // For GetImNodeID signature
 } // namespace MindWeaver
 
 namespace MindWeaver
@@ -28,6 +37,30 @@ namespace MindWeaver
         NodeEditorPanel &operator=(const NodeEditorPanel &) = delete;
 
         void SetGraph(std::shared_ptr<Graph> graph_ptr);
+
+        /// @brief Source of executor status/progress events, drained once per frame in Render().
+        void SetEventChannel(std::shared_ptr<ExecutionEventChannel> channel);
+
+        /// @brief Invoked when the user asks to run the graph from the panel's menu.
+        void SetRunCallback(std::function<void()> callback) { m_OnRun = std::move(callback); }
+
+        /// @brief Invoked when the user asks to run the graph across worker processes.
+        void SetRunInProcessesCallback(std::function<void()> callback) { m_OnRunInProcesses = std::move(callback); }
+
+        /// @brief Invoked when the user asks for an automatic layout, with the nodes to arrange
+        /// (empty for the whole graph).
+        void SetLayoutCallback(std::function<void(std::vector<UUID>)> callback) { m_OnLayout = std::move(callback); }
+
+        /// @brief Stats of the last run, shown as a heatmap over the nodes when a metric is picked in
+        /// the Stats menu (nullptr to clear).
+        void SetExecutionStats(std::shared_ptr<const ExecutionStats> stats);
+
+        /// @brief Invoked when the user asks to export the stats, with true for JSON and false for CSV.
+        void SetExportStatsCallback(std::function<void(bool)> callback) { m_OnExportStats = std::move(callback); }
+
+        /// @brief Node types offered by the "Create Node" palette (right-click or Tab in the editor).
+        void SetNodeCatalog(std::shared_ptr<NodeCatalog> catalog) { m_NodeCatalog = std::move(catalog); }
+
         void Render(); // This will contain ImGui::Begin, ImNodes::BeginNodeEditor, etc.
 
         const std::string &GetName() const { return m_PanelName; }
@@ -35,11 +68,51 @@ namespace MindWeaver
         // void SetOpen(bool open) { m_IsOpen = open; }
 
     private:
+        /// @brief Latest execution state of a node as seen by the UI.
+        struct NodeRunState
+        {
+            NodeStatus status = NodeStatus::Idle;
+            float progress = -1.0f; // < 0 when the node has not reported progress
+            std::string message;    // Error text or latest output preview
+        };
+
+        /// @brief ImNodes IDs and last drawn rectangle (grid space) of the node at the same index in
+        /// the graph's node list.
+        struct NodeDrawCache
+        {
+            int imnodesID = 0;
+            std::vector<int> inputPinIDs; // In pin order; 0 for empty slots
+            std::vector<int> outputPinIDs;
+            float x = 0.0f, y = 0.0f, width = 0.0f, height = 0.0f;
+            std::vector<uint32_t> links; // Indices into m_LinkCache of the links touching the node
+        };
+
+        /// @brief ImNodes IDs of a drawable link and the grid-space bounds of its curve.
+        struct LinkDrawCache
+        {
+            int imnodesID = 0;
+            int startPinID = 0;
+            int endPinID = 0;
+            uint32_t startNode = 0; // Indices into m_NodeCache
+            uint32_t endNode = 0;
+            float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+        };
+
+        void DrainExecutionEvents();
+        void DrawMenuBar();
+        std::vector<UUID> GetSelectedNodeIDs() const;
+        void RefreshDrawCache();
+        void CacheMaterializedNodes(const std::vector<uint32_t> &node_indices);
+        int CacheImNodeID(const UUID &uuid, const std::unordered_map<UUID, int> *previous_ids = nullptr);
+        void CacheNode(uint32_t node_index, const Node &node, const std::unordered_map<UUID, int> *previous_ids);
+        void CacheLink(const Link &link, const std::unordered_map<UUID, int> *previous_ids);
+        void UpdateLinkBounds(LinkDrawCache &link) const;
         void DrawNodes();
         void DrawLinks();
         void HandleLinkCreation();
         void HandleLinkDeletion();
         void HandleNodeInteraction(); // For updating backend positions
+        void DrawNodePalette(const ImVec2 &editor_origin);
 
         // Helper to get a unique int ID for ImNodes from our UUID
         static int GetImNodeID(const MindWeaver::UUID &uuid);
@@ -47,6 +120,33 @@ namespace MindWeaver
         std::string m_PanelName;
         // bool m_IsOpen = true; // Optional
         std::shared_ptr<Graph> m_Graph; // The panel operates on this graph
+
+        std::shared_ptr<ExecutionEventChannel> m_EventChannel;
+        std::unordered_map<UUID, NodeRunState> m_NodeRunStates;
+        std::function<void()> m_OnRun;
+        std::function<void()> m_OnRunInProcesses;
+        std::function<void(std::vector<UUID>)> m_OnLayout;
+        std::function<void(bool)> m_OnExportStats;
+
+        std::shared_ptr<const ExecutionStats> m_ExecutionStats;
+        bool m_ShowHeatmap = false;
+        NodeMetric m_HeatmapMetric = NodeMetric::WallTime;
+        double m_HeatmapMax = 0.0; // Largest value of the metric, recomputed when stats or metric change
+
+        // Rebuilt when the graph's topology changes; node rectangles and link bounds are updated
+        // only for nodes that moved or resized. Links to unloaded placeholders are left out until
+        // the panel materializes them, which adds only their entries.
+        const Graph *m_CacheGraph = nullptr;
+        uint64_t m_CacheTopologyVersion = 0;
+        std::vector<NodeDrawCache> m_NodeCache;
+        std::vector<LinkDrawCache> m_LinkCache;
+        std::unordered_map<UUID, int> m_ImNodeIDs;      // Memoized GetImNodeID of the objects in the cache
+        std::unordered_map<UUID, uint32_t> m_PinOwners; // Pin ID -> index of its (loaded) node
+
+        std::shared_ptr<NodeCatalog> m_NodeCatalog;
+        char m_PaletteQuery[128] = {};
+        int m_PaletteSelection = 0;
+        float m_PaletteGridX = 0.0f, m_PaletteGridY = 0.0f; // Where the created node is placed
     };
 
 } // namespace MindWeaver
\ No newline at end of file
@@ -10,6 +10,21 @@
 #include "core/Position.h"
 #include "core/UUID.h"
 
+// Python
+#include "python/PythonInterop.h"
+#include "python/PythonRuntime.h"
+
+// Persistence
+#include "io/GraphAutosave.h"
+
+// Runtime
+#include "runtime/BuiltinNodes.h"
+#include "runtime/ExecutionEvents.h"
+#include "runtime/Executor.h"
+#include "runtime/NodeCatalog.h"
+#include "runtime/NodeKernel.h"
+#include "runtime/ProcessExecutor.h"
+
 // ImGui and backends
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -20,10 +35,16 @@
 // GLFW (Windowing) - Must be included after GLAD
 #include <GLFW/glfw3.h>
 
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 #include <vector>
 
+static const char *kAutosavePath = "MainGraph.mwgraph";
+static const char *kStatsCSVPath = "MainGraph.stats.csv";
+static const char *kStatsJSONPath = "MainGraph.stats.json";
+static const size_t kLayoutPositionsPerFrame = 20000; // Node moves applied per frame after a layout
+
 static void glfw_error_callback(int error, const char *description)
 {
     std::cerr << "GLFW Error " << error << ": " << description << std::endl;
@@ -35,6 +56,8 @@ namespace MindWeaver
     Application::Application(const std::string &title, int width, int height)
         : m_WindowTitle(title), m_Width(width), m_Height(height)
     {
+        m_PythonRuntime = std::make_unique<PythonRuntime>(); // Releases the GIL; executor workers take it per batch
+
         if (!InitWindow())
         {
             Shutdown();
@@ -46,18 +69,82 @@ namespace MindWeaver
             throw std::runtime_error("Failed to initialize ImGui.");
         }
 
-        m_GraphInstance = std::make_shared<Graph>("MainGraph");
+        // Pick up where the last session left off (including after a crash)
+        bool autosave_usable = true;
+        bool recovered = false;
+        if (GraphAutosave::Exists(kAutosavePath))
+        {
+            try
+            {
+                m_GraphInstance = std::make_shared<Graph>(GraphAutosave::Recover(kAutosavePath));
+                std::cout << "Recovered graph from '" << kAutosavePath << "'." << std::endl;
+                recovered = true;
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Failed to recover autosave: " << e.what() << std::endl;
+                // Keep the unreadable file for inspection instead of saving the new graph over it
+                try
+                {
+                    const std::string moved_path = GraphAutosave::SetAside(kAutosavePath);
+                    std::cerr << "The unreadable autosave was kept as '" << moved_path << "'." << std::endl;
+                }
+                catch (const std::exception &move_error)
+                {
+                    std::cerr << "Autosave disabled for this session: " << move_error.what() << std::endl;
+                    autosave_usable = false;
+                }
+            }
+        }
+        if (!m_GraphInstance)
+            m_GraphInstance = std::make_shared<Graph>("MainGraph");
         m_NodeEditorPanelInstance = std::make_unique<NodeEditorPanel>("Node Editor");
         m_NodeEditorPanelInstance->SetGraph(m_GraphInstance);
 
-        // Add sample nodes
-        auto node1 = std::make_shared<Node>(UUID::generate(), "Start Event", NodeType::ExecutionFlow);
+        m_ExecutionEvents = std::make_shared<ExecutionEventChannel>();
+        m_NodeEditorPanelInstance->SetEventChannel(m_ExecutionEvents);
+
+        m_KernelRegistry = std::make_shared<KernelRegistry>();
+        m_NodeCatalog = std::make_shared<NodeCatalog>();
+        RegisterBuiltinNodes(*m_KernelRegistry, m_NodeCatalog.get());
+        m_NodeEditorPanelInstance->SetNodeCatalog(m_NodeCatalog);
+        m_Executor = std::make_unique<Executor>(m_KernelRegistry);
+        m_Executor->SetEventChannel(m_ExecutionEvents);
+        m_Executor->SetInterpreterLock(std::make_shared<PythonGilLock>());
+        m_Executor->SetCollectStats(true);
+        m_ProcessExecutor = std::make_unique<ProcessExecutor>(m_KernelRegistry);
+        m_ProcessExecutor->SetEventChannel(m_ExecutionEvents);
+        m_ProcessExecutor->SetInterpreterLock(std::make_shared<PythonGilLock>());
+        m_ProcessExecutor->SetForkHooks(MakePythonForkHooks());
+        m_ProcessExecutor->SetCollectStats(true);
+        m_NodeEditorPanelInstance->SetRunCallback([this]() { StartExecution(); });
+        m_NodeEditorPanelInstance->SetRunInProcessesCallback([this]() { StartExecution(true); });
+        m_NodeEditorPanelInstance->SetLayoutCallback([this](std::vector<UUID> region) { StartLayout(std::move(region)); });
+        m_NodeEditorPanelInstance->SetExportStatsCallback([this](bool as_json) { ExportExecutionStats(as_json); });
+
+        // Add sample nodes to a fresh graph
+        if (m_GraphInstance->GetNodes().empty())
+        {
+            AddSampleNodes();
+            recovered = false; // The samples are not in the autosave yet
+        }
+
+        if (autosave_usable)
+        {
+            m_Autosave = std::make_unique<GraphAutosave>(kAutosavePath);
+            m_Autosave->Attach(*m_GraphInstance, recovered);
+        }
+    }
+
+    void Application::AddSampleNodes()
+    {
+        auto node1 = m_GraphInstance->CreateNode(UUID::generate(), "Start Event", NodeType::ExecutionFlow);
         node1->SetPosition(Position(100.f, 100.f));
         node1->AddOutputPin("Exec Out", PinType::Exec);
         node1->AddInputPin("Condition", PinType::Bool);
         m_GraphInstance->AddNode(node1);
 
-        auto node2 = std::make_shared<Node>(UUID::generate(), "Process Data", NodeType::Function);
+        auto node2 = m_GraphInstance->CreateNode(UUID::generate(), "Process Data", NodeType::Function);
         node2->SetPosition(Position(350.f, 150.f));
         node2->AddInputPin("Exec In", PinType::Exec);
         node2->AddInputPin("Input Value", PinType::Int);
@@ -140,11 +227,98 @@ namespace MindWeaver
 
     void Application::Run() { MainLoop(); }
 
+    void Application::StartExecution(bool in_processes)
+    {
+        if (m_PendingRun.valid())
+        {
+            std::cout << "Execution already in progress." << std::endl;
+            return;
+        }
+        // The executor works on an immutable snapshot, so editing can continue during the run
+        if (in_processes)
+            m_PendingRun = m_ProcessExecutor->RunAsync(m_GraphInstance->Snapshot());
+        else
+            m_PendingRun = m_Executor->RunAsync(m_GraphInstance->Snapshot());
+    }
+
+    void Application::PollExecution()
+    {
+        if (!m_PendingRun.valid() ||
+            m_PendingRun.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+            return;
+
+        ExecutionResult result = m_PendingRun.get();
+        if (result.success)
+            std::cout << "Execution finished: " << result.nodesExecuted << " node(s) executed." << std::endl;
+        else
+            std::cerr << "Execution failed: " << result.error << std::endl;
+
+        m_LastRunStats = std::make_shared<const ExecutionStats>(std::move(result.stats));
+        m_NodeEditorPanelInstance->SetExecutionStats(m_LastRunStats);
+    }
+
+    void Application::ExportExecutionStats(bool as_json)
+    {
+        if (!m_LastRunStats)
+            return;
+        const char *path = as_json ? kStatsJSONPath : kStatsCSVPath;
+        try
+        {
+            m_LastRunStats->Save(path);
+            std::cout << "Execution stats written to '" << path << "'." << std::endl;
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Failed to export execution stats: " << e.what() << std::endl;
+        }
+    }
+
+    void Application::StartLayout(std::vector<UUID> region)
+    {
+        if (m_PendingLayout.valid() || m_LayoutApplied < m_Layout.positions.size())
+        {
+            std::cout << "Layout already in progress." << std::endl;
+            return;
+        }
+        // Computed from a snapshot on worker threads; the editor stays responsive meanwhile
+        m_PendingLayout = ComputeGraphLayoutAsync(m_GraphInstance->Snapshot(), std::move(region));
+    }
+
+    void Application::PollLayout()
+    {
+        if (m_PendingLayout.valid() &&
+            m_PendingLayout.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            try
+            {
+                m_Layout = m_PendingLayout.get();
+                m_LayoutApplied = 0;
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Layout failed: " << e.what() << std::endl;
+            }
+        }
+
+        // Positions are applied in batches so huge layouts do not stall a frame
+        if (m_LayoutApplied < m_Layout.positions.size())
+        {
+            m_LayoutApplied = ApplyGraphLayout(*m_GraphInstance, m_Layout, m_LayoutApplied, kLayoutPositionsPerFrame);
+            if (m_LayoutApplied == m_Layout.positions.size())
+            {
+                m_Layout = GraphLayout();
+                m_LayoutApplied = 0;
+            }
+        }
+    }
+
     void Application::MainLoop()
     {
         while (!glfwWindowShouldClose(m_Window))
         {
             glfwPollEvents();
+            PollExecution();
+            PollLayout();
             NewFrame();
 
             ImGui::DockSpaceOverViewport(ImGui::GetWindowDockID(), ImGui::GetMainViewport(),
@@ -190,6 +364,17 @@ namespace MindWeaver
 
     void Application::Shutdown()
     {
+        if (m_PendingRun.valid())
+            m_PendingRun.wait(); // The run references the executor
+
+        // Kernels may hold Python objects, so they must go before the interpreter
+        m_Executor.reset();
+        m_ProcessExecutor.reset();
+        m_KernelRegistry.reset();
+        m_NodeCatalog.reset();
+        m_LastRunStats.reset();
+
+        m_Autosave.reset(); // Writes the last edits and stops observing the graph
         m_NodeEditorPanelInstance.reset(); // Destructor will call ImNodes::DestroyContext()
         m_GraphInstance.reset();
 
@@ -206,6 +391,8 @@ namespace MindWeaver
             m_Window = nullptr;
         }
         glfwTerminate();
+
+        m_PythonRuntime.reset();
         std::cout << "Application Shutdown." << std::endl;
     }
 
@@ -0,0 +1,67 @@
+#include "core/ObjectPool.h"
+
+namespace MindWeaver
+{
+
+    ObjectPool::~ObjectPool()
+    {
+        for (void *chunk : m_Chunks)
+            ::operator delete(chunk);
+    }
+
+    void *ObjectPool::Allocate(size_t size)
+    {
+        if (size > kMaxBlockSize)
+            return ::operator new(size);
+
+        const size_t size_class = SizeClass(size == 0 ? 1 : size);
+        const size_t block_size = size_class * kGranularity;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto &free_list = m_FreeLists[size_class];
+        FreeBlock *block = free_list.load(std::memory_order_acquire);
+        while (block && !free_list.compare_exchange_weak(block, block->next, std::memory_order_acquire))
+        {
+        }
+        if (block)
+            return block;
+        if (static_cast<size_t>(m_End - m_Cursor) < block_size)
+        {
+            // The tail of the previous chunk is abandoned; it is smaller than kMaxBlockSize
+            m_Chunks.reserve(m_Chunks.size() + 1);
+            char *chunk = static_cast<char *>(::operator new(kChunkSize));
+            m_Chunks.push_back(chunk);
+            m_Cursor = chunk;
+            m_End = chunk + kChunkSize;
+        }
+        void *fresh = m_Cursor;
+        m_Cursor += block_size;
+        return fresh;
+    }
+
+    void ObjectPool::Deallocate(void *block, size_t size) noexcept
+    {
+        if (!block)
+            return;
+        if (size > kMaxBlockSize)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        auto &free_list = m_FreeLists[SizeClass(size == 0 ? 1 : size)];
+        FreeBlock *free_block = static_cast<FreeBlock *>(block);
+        free_block->next = free_list.load(std::memory_order_relaxed);
+        while (!free_list.compare_exchange_weak(free_block->next, free_block, std::memory_order_release,
+                                                std::memory_order_relaxed))
+        {
+        }
+    }
+
+    size_t ObjectPool::GetReservedBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Chunks.size() * kChunkSize;
+    }
+
+} // namespace MindWeaver
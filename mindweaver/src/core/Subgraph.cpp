@@ -0,0 +1,309 @@
+#include "core/Subgraph.h"
+
+#include "core/Graph.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        /// @brief Port name for a body pin, numbered when several ports would share it.
+        Symbol UniquePortName(Symbol pin_name, std::unordered_map<Symbol, size_t> &uses)
+        {
+            const size_t use = ++uses[pin_name];
+            if (use == 1)
+                return pin_name;
+            return Symbol(pin_name.str() + " " + std::to_string(use));
+        }
+
+        /// @brief Pins are matched to ports by position, so each must have its port's name and type.
+        void CheckPorts(const Node &node, const SubgraphDefinition &definition)
+        {
+            auto matches = [](const PinMap &pins, const std::vector<SubgraphPort> &ports)
+            {
+                if (pins.size() != ports.size())
+                    return false;
+                size_t port = 0;
+                for (const auto &pair : pins)
+                {
+                    if (pair.second->name != ports[port].name || pair.second->type != ports[port].type)
+                        return false;
+                    ++port;
+                }
+                return true;
+            };
+            if (!matches(node.inputPins, definition.inputs) || !matches(node.outputPins, definition.outputs))
+                throw std::runtime_error("Subgraph node '" + node.name.str() + "' does not match the ports of its body");
+        }
+    } // namespace
+
+    const FlatSubgraph &SubgraphDefinition::GetFlattened() const
+    {
+        std::call_once(flatten_once,
+                       [this]
+                       {
+                           auto flat = std::make_shared<FlatSubgraph>();
+                           std::unordered_map<UUID, UUID> redirects;
+                           flat->body = FlattenSubgraphs(nodes, links, &redirects);
+
+                           // A port may lead to a nested subgraph node; follow it to the body pin
+                           auto resolve = [&](const UUID &pin_id)
+                           {
+                               auto it = redirects.find(pin_id);
+                               return it != redirects.end() ? it->second : pin_id;
+                           };
+                           for (const auto &port : inputs)
+                               flat->inputPins.push_back(resolve(port.innerPinID));
+                           for (const auto &port : outputs)
+                               flat->outputPins.push_back(resolve(port.innerPinID));
+                           flattened = std::move(flat);
+                       });
+        return *flattened;
+    }
+
+    std::shared_ptr<Node> CloneInScope(const Node &node, const UUID &scope, const std::shared_ptr<ObjectPool> &pool)
+    {
+        auto copy = MakePooled<Node>(pool, UUID::derive(scope, node.id), node.name, node.type, pool);
+        copy->position = node.position;
+        copy->parameters = node.parameters;
+        copy->subgraph = node.subgraph;
+        copy->inputPins.reserve(node.inputPins.size());
+        for (const auto &pair : node.inputPins)
+        {
+            const UUID pin_id = UUID::derive(scope, pair.first);
+            copy->inputPins.emplace(pin_id, MakePooled<Pin>(pool, pin_id, pair.second->name, pair.second->type,
+                                                            PinDirection::Input, copy->id));
+        }
+        copy->outputPins.reserve(node.outputPins.size());
+        for (const auto &pair : node.outputPins)
+        {
+            const UUID pin_id = UUID::derive(scope, pair.first);
+            copy->outputPins.emplace(pin_id, MakePooled<Pin>(pool, pin_id, pair.second->name, pair.second->type,
+                                                             PinDirection::Output, copy->id));
+        }
+        return copy;
+    }
+
+    FlatGraph FlattenSubgraphs(const NodeList &nodes, const LinkList &links, std::unordered_map<UUID, UUID> *pin_redirects,
+                               std::unordered_map<UUID, UUID> *node_owners)
+    {
+        FlatGraph flat;
+        flat.nodes.reserve(nodes.size());
+        std::unordered_map<UUID, UUID> redirects;
+        std::shared_ptr<ObjectPool> pool; // Of the instances: links to them are rebuilt there
+        for (const auto &node : nodes)
+        {
+            if (!node)
+                continue;
+            if (!node->subgraph)
+            {
+                flat.nodes.push_back(node);
+                continue;
+            }
+
+            // The body is flattened once per definition version; each instance only copies it
+            const SubgraphDefinition &definition = *node->subgraph;
+            CheckPorts(*node, definition);
+            const FlatSubgraph &body = definition.GetFlattened();
+            const UUID &scope = node->id;
+            pool = node->pool;
+            for (const auto &inner : body.body.nodes)
+            {
+                flat.nodes.push_back(CloneInScope(*inner, scope, node->pool));
+                if (node_owners)
+                    (*node_owners)[flat.nodes.back()->id] = scope;
+            }
+            for (const auto &inner : body.body.links)
+                flat.links.push_back(MakePooled<Link>(node->pool, UUID::derive(scope, inner->id),
+                                                      UUID::derive(scope, inner->startPinID),
+                                                      UUID::derive(scope, inner->endPinID)));
+            size_t port = 0;
+            for (const auto &pair : node->inputPins)
+                redirects[pair.first] = UUID::derive(scope, body.inputPins[port++]);
+            port = 0;
+            for (const auto &pair : node->outputPins)
+                redirects[pair.first] = UUID::derive(scope, body.outputPins[port++]);
+        }
+
+        flat.links.reserve(flat.links.size() + links.size());
+        for (const auto &link : links)
+        {
+            if (!link)
+                continue;
+            auto start = redirects.find(link->startPinID);
+            auto end = redirects.find(link->endPinID);
+            if (start == redirects.end() && end == redirects.end())
+            {
+                flat.links.push_back(link);
+                continue;
+            }
+            flat.links.push_back(MakePooled<Link>(pool, link->id,
+                                                  start != redirects.end() ? start->second : link->startPinID,
+                                                  end != redirects.end() ? end->second : link->endPinID));
+        }
+
+        if (pin_redirects)
+            *pin_redirects = std::move(redirects);
+        return flat;
+    }
+
+    std::shared_ptr<const Node> CollapseToSubgraph(Graph &graph, const std::vector<UUID> &node_ids, Symbol name)
+    {
+        const std::unordered_set<UUID> selected(node_ids.begin(), node_ids.end());
+        auto definition = std::make_shared<SubgraphDefinition>();
+        definition->id = UUID::generate();
+        definition->name = name;
+
+        // The body takes the selected nodes as they are (they are immutable), in graph order
+        std::unordered_set<UUID> body_pins;
+        Position top_left;
+        for (const auto &node : graph.GetNodes())
+        {
+            if (!node || !selected.count(node->id))
+                continue;
+            auto resolved = graph.ResolveNode(node);
+            for (const auto &pair : resolved->inputPins)
+                body_pins.insert(pair.first);
+            for (const auto &pair : resolved->outputPins)
+                body_pins.insert(pair.first);
+            if (definition->nodes.empty())
+                top_left = resolved->position;
+            top_left.x = std::min(top_left.x, resolved->position.x);
+            top_left.y = std::min(top_left.y, resolved->position.y);
+            definition->nodes.push_back(std::move(resolved));
+        }
+        if (definition->nodes.empty())
+            return nullptr;
+
+        std::vector<std::shared_ptr<const Link>> entering, leaving;
+        std::unordered_set<UUID> entered_pins, left_pins, inner_pins;
+        for (const auto &link : graph.GetLinks())
+        {
+            if (!link)
+                continue;
+            const bool starts_inside = body_pins.count(link->startPinID) != 0;
+            const bool ends_inside = body_pins.count(link->endPinID) != 0;
+            if (starts_inside && ends_inside)
+            {
+                definition->links.push_back(link);
+                inner_pins.insert(link->startPinID);
+                inner_pins.insert(link->endPinID);
+            }
+            else if (ends_inside)
+            {
+                entering.push_back(link);
+                entered_pins.insert(link->endPinID);
+            }
+            else if (starts_inside)
+            {
+                leaving.push_back(link);
+                left_pins.insert(link->startPinID);
+            }
+        }
+
+        // One port per body pin connected to the outside or not connected at all, in body order
+        auto is_port = [&](const UUID &pin_id, const std::unordered_set<UUID> &outside_pins)
+        { return outside_pins.count(pin_id) || !inner_pins.count(pin_id); };
+        std::unordered_map<Symbol, size_t> input_names, output_names;
+        for (const auto &node : definition->nodes)
+        {
+            for (const auto &pair : node->inputPins)
+            {
+                if (is_port(pair.first, entered_pins))
+                    definition->inputs.push_back(
+                        {UniquePortName(pair.second->name, input_names), pair.second->type, pair.first});
+            }
+            for (const auto &pair : node->outputPins)
+            {
+                if (is_port(pair.first, left_pins))
+                    definition->outputs.push_back(
+                        {UniquePortName(pair.second->name, output_names), pair.second->type, pair.first});
+            }
+        }
+
+        auto subgraph_node = graph.CreateNode(UUID::generate(), name, NodeType::Function);
+        subgraph_node->subgraph = definition;
+        subgraph_node->position = top_left;
+        std::unordered_map<UUID, UUID> port_pins; // Body pin -> pin of the subgraph node
+        for (const auto &port : definition->inputs)
+            port_pins[port.innerPinID] = subgraph_node->AddInputPin(port.name, port.type)->id;
+        for (const auto &port : definition->outputs)
+            port_pins[port.innerPinID] = subgraph_node->AddOutputPin(port.name, port.type)->id;
+
+        // Removing the nodes also removes their links; the outside ones come back on the new node
+        std::vector<UUID> body_ids;
+        body_ids.reserve(definition->nodes.size());
+        for (const auto &node : definition->nodes)
+            body_ids.push_back(node->id);
+        graph.RemoveNodes(body_ids);
+        graph.AddNode(subgraph_node);
+        for (const auto &link : entering)
+            graph.AddLink(graph.CreateLink(link->id, link->startPinID, port_pins[link->endPinID]));
+        for (const auto &link : leaving)
+            graph.AddLink(graph.CreateLink(link->id, port_pins[link->startPinID], link->endPinID));
+        return graph.GetNode(subgraph_node->id);
+    }
+
+    std::vector<UUID> ExpandSubgraph(Graph &graph, const UUID &node_id)
+    {
+        const auto subgraph_node = graph.ResolveNode(graph.GetNode(node_id));
+        if (!subgraph_node || !subgraph_node->subgraph)
+            return {};
+        const auto definition = subgraph_node->subgraph; // Keeps the body alive past RemoveNode
+        CheckPorts(*subgraph_node, *definition);
+        const UUID &scope = subgraph_node->id;
+
+        // Pins of the subgraph node -> the body pins behind its ports, as copied into the graph
+        std::unordered_map<UUID, UUID> redirects;
+        size_t port = 0;
+        for (const auto &pair : subgraph_node->inputPins)
+            redirects[pair.first] = UUID::derive(scope, definition->inputs[port++].innerPinID);
+        port = 0;
+        for (const auto &pair : subgraph_node->outputPins)
+            redirects[pair.first] = UUID::derive(scope, definition->outputs[port++].innerPinID);
+
+        std::vector<std::shared_ptr<const Link>> outside;
+        for (const auto &link : graph.GetLinks())
+        {
+            if (link && (redirects.count(link->startPinID) || redirects.count(link->endPinID)))
+                outside.push_back(link);
+        }
+        graph.RemoveNode(node_id);
+
+        // The body keeps its shape, moved so its top-left corner lands where the subgraph node was
+        Position top_left = definition->nodes.empty() ? Position() : definition->nodes[0]->position;
+        for (const auto &node : definition->nodes)
+        {
+            top_left.x = std::min(top_left.x, node->position.x);
+            top_left.y = std::min(top_left.y, node->position.y);
+        }
+        const Position offset = subgraph_node->position - top_left;
+
+        std::vector<UUID> added;
+        added.reserve(definition->nodes.size());
+        for (const auto &node : definition->nodes)
+        {
+            auto copy = CloneInScope(*node, scope, graph.GetPool());
+            copy->position = node->position + offset;
+            added.push_back(copy->id);
+            graph.AddNode(std::move(copy));
+        }
+        for (const auto &link : definition->links)
+            graph.AddLink(graph.CreateLink(UUID::derive(scope, link->id), UUID::derive(scope, link->startPinID),
+                                           UUID::derive(scope, link->endPinID)));
+        for (const auto &link : outside)
+        {
+            auto start = redirects.find(link->startPinID);
+            auto end = redirects.find(link->endPinID);
+            graph.AddLink(graph.CreateLink(link->id, start != redirects.end() ? start->second : link->startPinID,
+                                           end != redirects.end() ? end->second : link->endPinID));
+        }
+        return added;
+    }
+
+} // namespace MindWeaver
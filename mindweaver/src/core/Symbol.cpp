@@ -0,0 +1,114 @@
+#include "core/Symbol.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        /// @brief Append-only storage: fixed-size chunks that never move, so readers can index them
+        /// without a lock while new symbols are being added.
+        class SymbolTable
+        {
+        public:
+            static constexpr uint32_t kChunkBits = 12;
+            static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+            static constexpr uint32_t kMaxChunks = 1u << 14; // 64M symbols
+
+            SymbolTable() { Insert(std::string_view()); }
+
+            static SymbolTable &Get()
+            {
+                // Never destroyed: symbols may be used from static destructors
+                static SymbolTable *table = []
+                {
+                    auto *created = new SymbolTable();
+#ifndef _WIN32
+                    // A fork while another thread holds the lock would leave it locked forever in
+                    // the child (ProcessExecutor workers intern names), so fork() waits for it. The
+                    // child gets a fresh lock: its thread is not the one that took the old one,
+                    // which an rwlock cannot be unlocked by
+                    pthread_atfork([] { Get().m_Mutex.lock(); }, [] { Get().m_Mutex.unlock(); },
+                                   [] { new (&Get().m_Mutex) std::shared_mutex(); });
+#endif
+                    return created;
+                }();
+                return *table;
+            }
+
+            uint32_t Intern(std::string_view text)
+            {
+                {
+                    std::shared_lock<std::shared_mutex> lock(m_Mutex);
+                    auto it = m_Index.find(text);
+                    if (it != m_Index.end())
+                        return it->second;
+                }
+                std::unique_lock<std::shared_mutex> lock(m_Mutex);
+                auto it = m_Index.find(text);
+                if (it != m_Index.end())
+                    return it->second;
+                return Insert(text);
+            }
+
+            const std::string &Text(uint32_t id) const
+            {
+                return m_Chunks[id >> kChunkBits].load(std::memory_order_acquire)[id & (kChunkSize - 1)];
+            }
+
+            size_t Size() const
+            {
+                std::shared_lock<std::shared_mutex> lock(m_Mutex);
+                return m_Count;
+            }
+
+        private:
+            // Caller holds the exclusive lock (or is the constructor)
+            uint32_t Insert(std::string_view text)
+            {
+                const uint32_t id = m_Count;
+                const uint32_t chunk = id >> kChunkBits;
+                if (chunk >= kMaxChunks)
+                    throw std::runtime_error("Symbol table is full");
+                std::string *strings = m_Chunks[chunk].load(std::memory_order_relaxed);
+                if (!strings)
+                {
+                    strings = new std::string[kChunkSize];
+                    m_Chunks[chunk].store(strings, std::memory_order_release);
+                }
+                std::string &stored = strings[id & (kChunkSize - 1)];
+                stored.assign(text.data(), text.size());
+                m_Index.emplace(std::string_view(stored), id); // Keys view the stored text
+                ++m_Count;
+                return id;
+            }
+
+            mutable std::shared_mutex m_Mutex;
+            std::unordered_map<std::string_view, uint32_t> m_Index;
+            std::unique_ptr<std::atomic<std::string *>[]> m_Chunks{new std::atomic<std::string *>[kMaxChunks]()};
+            uint32_t m_Count = 0;
+        };
+
+        // Created while the program is still single-threaded, so the fork handlers are in place
+        // before any thread can fork
+        [[maybe_unused]] const SymbolTable &kSymbolTable = SymbolTable::Get();
+    } // namespace
+
+    const std::string &Symbol::str() const { return SymbolTable::Get().Text(m_ID); }
+
+    size_t Symbol::TableSize() { return SymbolTable::Get().Size(); }
+
+    uint32_t Symbol::Intern(std::string_view text) { return SymbolTable::Get().Intern(text); }
+
+} // namespace MindWeaver
@@ -0,0 +1,302 @@
+#include "io/GraphAutosave.h"
+
+#include "io/BinaryStream.h"
+#include "io/GraphFile.h"
+#include "io/LazyGraphFile.h"
+#include "io/MutationLog.h"
+#include "runtime/MappedFile.h"
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        bool FileExists(const std::string &path)
+        {
+            FILE *file = std::fopen(path.c_str(), "rb");
+            if (!file)
+                return false;
+            std::fclose(file);
+            return true;
+        }
+
+        /// @return False if the buffered data could not be written or synced.
+        bool SyncToDisk(FILE *file)
+        {
+            if (std::fflush(file) != 0)
+                return false;
+#ifdef _WIN32
+            return _commit(_fileno(file)) == 0;
+#else
+            return ::fsync(::fileno(file)) == 0;
+#endif
+        }
+    } // namespace
+
+    GraphAutosave::GraphAutosave(std::string path, AutosaveOptions options)
+        : m_Path(std::move(path)), m_Options(options)
+    {
+    }
+
+    GraphAutosave::~GraphAutosave() { Detach(); }
+
+    void GraphAutosave::Attach(Graph &graph, bool recovered)
+    {
+        Detach();
+        m_Graph = &graph;
+        m_Resume = recovered;
+        m_Replica = std::make_unique<Graph>(graph.Snapshot());
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = false;
+        }
+        m_Thread = std::thread(&GraphAutosave::ThreadMain, this);
+        graph.SetMutationListener([this](const GraphMutation &mutation) { m_Queue.Push(mutation); });
+    }
+
+    void GraphAutosave::Detach()
+    {
+        if (!m_Graph)
+            return;
+        m_Graph->SetMutationListener(nullptr);
+        m_Graph = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stop = true;
+        }
+        m_Wake.notify_one();
+        m_Thread.join(); // Writes the remaining queue before exiting
+    }
+
+    void GraphAutosave::Flush()
+    {
+        if (!m_Graph)
+            return;
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        const uint64_t request = ++m_FlushRequests;
+        m_Wake.notify_one();
+        m_Flushed.wait(lock, [&] { return m_FlushesDone >= request; });
+    }
+
+    bool GraphAutosave::Exists(const std::string &path) { return FileExists(path); }
+
+    std::string GraphAutosave::SetAside(const std::string &path)
+    {
+        const std::string log_path = path + ".log";
+        const std::string moved_path = path + ".corrupt";
+        const std::string moved_log_path = log_path + ".corrupt";
+        std::remove(moved_path.c_str()); // rename() does not replace files on every platform
+        if (std::rename(path.c_str(), moved_path.c_str()) != 0)
+            throw std::runtime_error("failed to move '" + path + "' to '" + moved_path + "'");
+        if (FileExists(log_path))
+        {
+            std::remove(moved_log_path.c_str());
+            if (std::rename(log_path.c_str(), moved_log_path.c_str()) != 0)
+                throw std::runtime_error("failed to move '" + log_path + "' to '" + moved_log_path + "'");
+        }
+        return moved_path;
+    }
+
+    GraphSnapshot GraphAutosave::Recover(const std::string &path)
+    {
+        uint64_t file_id = 0;
+        GraphSnapshot base = OpenGraphFileLazily(path, &file_id); // Nodes load on demand
+
+        const std::string log_path = path + ".log";
+        if (!FileExists(log_path))
+            return base;
+
+        std::vector<GraphMutation> mutations;
+        uint64_t base_file_id = 0;
+        try
+        {
+            mutations = ReadMutationLog(log_path, base_file_id);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Autosave: ignoring unreadable log '" << log_path << "': " << e.what() << std::endl;
+            return base;
+        }
+        if (base_file_id != file_id)
+            return base; // Log of an older base file (crash during compaction)
+
+        Graph graph(base);
+        for (const auto &mutation : mutations)
+            graph.ApplyMutation(mutation);
+        return graph.Snapshot();
+    }
+
+    void GraphAutosave::ThreadMain()
+    {
+        try
+        {
+            // The attached state becomes the new base file, unless it is the one on disk already.
+            // If resuming fails the log stays closed, and the first batch compacts instead.
+            if (m_Resume)
+                Resume();
+            else
+                Compact();
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Autosave: " << e.what() << std::endl;
+        }
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        while (true)
+        {
+            m_Wake.wait_for(lock, m_Options.flushInterval,
+                            [&] { return m_Stop || m_FlushRequests > m_FlushesDone; });
+            const bool stop = m_Stop;
+            const uint64_t flush_target = m_FlushRequests;
+            lock.unlock();
+
+            try
+            {
+                WriteBatch();
+                if (m_LogBytes >= m_Options.compactAfterBytes)
+                    Compact();
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Autosave: " << e.what() << std::endl;
+            }
+
+            lock.lock();
+            m_FlushesDone = flush_target;
+            m_Flushed.notify_all();
+            if (stop)
+                break;
+        }
+        lock.unlock();
+
+        if (m_Log)
+        {
+            std::fclose(m_Log);
+            m_Log = nullptr;
+        }
+        m_Replica.reset();
+    }
+
+    void GraphAutosave::WriteBatch()
+    {
+        BinaryWriter out;
+        GraphMutation mutation;
+        GraphMutation pending;
+        bool has_pending = false;
+        while (m_Queue.TryPop(mutation))
+        {
+            // Dragging a node produces a position per frame; only the last of a run is kept
+            if (has_pending && pending.kind == GraphMutationKind::SetNodePosition &&
+                mutation.kind == GraphMutationKind::SetNodePosition && pending.targetID == mutation.targetID)
+            {
+                pending = std::move(mutation);
+                continue;
+            }
+            if (has_pending)
+            {
+                m_Replica->ApplyMutation(pending);
+                AppendMutationRecord(out, pending);
+            }
+            pending = std::move(mutation);
+            has_pending = true;
+        }
+        if (has_pending)
+        {
+            m_Replica->ApplyMutation(pending);
+            AppendMutationRecord(out, pending);
+        }
+        if (out.Size() == 0)
+            return;
+
+        if (!m_Log)
+        {
+            Compact(); // An earlier write failed; the replica already holds this batch
+            return;
+        }
+        if (std::fwrite(out.Bytes().data(), 1, out.Size(), m_Log) != out.Size() || !SyncToDisk(m_Log))
+        {
+            // The log may end in a torn record now (Recover() stops before it); the next batch
+            // compacts instead, from the replica, which already holds this one
+            std::fclose(m_Log);
+            m_Log = nullptr;
+            throw std::runtime_error("failed to append to '" + GetLogPath() + "'");
+        }
+        m_LogBytes += out.Size();
+    }
+
+    void GraphAutosave::Compact()
+    {
+        // Base file first, then a fresh log naming it. A crash in between leaves the old log, which
+        // Recover() ignores because it names the previous base file.
+        const uint64_t file_id = WriteGraphFile(m_Path, m_Replica->Snapshot());
+        if (m_Log)
+        {
+            std::fclose(m_Log);
+            m_Log = nullptr;
+        }
+        const std::string header = MakeMutationLogHeader(file_id);
+        WriteFileAtomically(GetLogPath(), header);
+        m_Log = std::fopen(GetLogPath().c_str(), "ab");
+        if (!m_Log)
+            throw std::runtime_error("failed to open '" + GetLogPath() + "'");
+        m_LogBytes = header.size();
+    }
+
+    void GraphAutosave::Resume()
+    {
+        // Recover() built the graph from the base file plus the intact records of its log. Both are
+        // kept; the log is rewritten with just those records, so that a torn tail does not hide
+        // the records appended after it.
+        uint64_t file_id = 0;
+        {
+            MappedFile file(m_Path);
+            BinaryReader in(file.Data(), file.Size());
+            file_id = ReadGraphFileHeader(in, m_Path).fileID;
+        }
+        std::string log = MakeMutationLogHeader(file_id);
+        if (FileExists(GetLogPath()))
+        {
+            uint64_t base_file_id = 0;
+            std::vector<GraphMutation> mutations;
+            try
+            {
+                mutations = ReadMutationLog(GetLogPath(), base_file_id);
+            }
+            catch (const std::exception &)
+            {
+                base_file_id = 0; // Recover() ignored it too
+            }
+            if (base_file_id == file_id)
+            {
+                BinaryWriter out;
+                for (const auto &mutation : mutations)
+                    AppendMutationRecord(out, mutation);
+                log += out.Bytes();
+            }
+        }
+
+        if (m_Log)
+        {
+            std::fclose(m_Log);
+            m_Log = nullptr;
+        }
+        WriteFileAtomically(GetLogPath(), log);
+        m_Log = std::fopen(GetLogPath().c_str(), "ab");
+        if (!m_Log)
+            throw std::runtime_error("failed to open '" + GetLogPath() + "'");
+        m_LogBytes = log.size();
+    }
+
+} // namespace MindWeaver
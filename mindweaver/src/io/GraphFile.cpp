@@ -0,0 +1,412 @@
+#include "io/GraphFile.h"
+
+#include "core/Subgraph.h"
+#include "io/LazyGraphFile.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        void WritePins(BinaryWriter &out, const PinMap &pins, SymbolTableWriter &symbols)
+        {
+            out.Write<uint32_t>(static_cast<uint32_t>(pins.size()));
+            for (const auto &pair : pins)
+            {
+                out.WriteUUID(pair.second->id);
+                out.Write<uint8_t>(static_cast<uint8_t>(pair.second->type));
+                out.Write<uint32_t>(symbols.IndexOf(pair.second->name));
+            }
+        }
+
+        Symbol ReadSymbol(BinaryReader &in, const std::vector<Symbol> &symbols)
+        {
+            const uint32_t index = in.Read<uint32_t>();
+            if (index >= symbols.size())
+                throw std::runtime_error("Symbol index out of range");
+            return symbols[index];
+        }
+
+        /// @brief A node or pin name: a symbol table index, or the text itself in format 1.
+        Symbol ReadName(BinaryReader &in, const std::vector<Symbol> &symbols, uint32_t version)
+        {
+            if (version < 2)
+                return Symbol(in.ReadString());
+            return ReadSymbol(in, symbols);
+        }
+
+        // Subgraphs nested deeper than this are rejected as corrupt rather than recursed into
+        constexpr uint32_t kMaxSubgraphDepth = 64;
+
+        // Smallest encodings of repeated records, to reject counts the remaining bytes cannot hold
+        // before reserving or looping on them
+        constexpr size_t kMinPinBytes = 16 + 1 + 4;              // ID, type, name
+        constexpr size_t kMinPortBytes = 4 + 1 + 16;             // Name, type, inner pin ID
+        constexpr size_t kMinParameterBytes = 4 + 4;             // Two empty strings
+        constexpr size_t kMinBodyNodeBytes = 16 + 4 + 8 + 4 * 4; // Table fields, then name and counts
+        constexpr size_t kMinBodyLinkBytes = 3 * 16;             // ID, start and end pin IDs
+
+        void CheckCount(BinaryReader &in, uint64_t count, size_t min_bytes, const char *what)
+        {
+            if (count > in.Remaining() / min_bytes)
+                throw std::runtime_error(std::string("Corrupt ") + what + " count");
+        }
+
+        void ReadPins(BinaryReader &in, Node &node, PinDirection direction, const std::vector<Symbol> &symbols,
+                      uint32_t version)
+        {
+            auto &pins = (direction == PinDirection::Input) ? node.inputPins : node.outputPins;
+            const uint32_t count = in.Read<uint32_t>();
+            CheckCount(in, count, kMinPinBytes, "pin");
+            pins.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                const UUID pin_id = in.ReadUUID();
+                const auto type = static_cast<PinType>(in.Read<uint8_t>());
+                const Symbol name = ReadName(in, symbols, version);
+                pins.emplace(pin_id, MakePooled<Pin>(node.pool, pin_id, name, type, direction, node.id));
+            }
+        }
+
+        void WritePorts(BinaryWriter &out, const std::vector<SubgraphPort> &ports, SymbolTableWriter &symbols)
+        {
+            out.Write<uint32_t>(static_cast<uint32_t>(ports.size()));
+            for (const auto &port : ports)
+            {
+                out.Write<uint32_t>(symbols.IndexOf(port.name));
+                out.Write<uint8_t>(static_cast<uint8_t>(port.type));
+                out.WriteUUID(port.innerPinID);
+            }
+        }
+
+        std::vector<SubgraphPort> ReadPorts(BinaryReader &in, const std::vector<Symbol> &symbols)
+        {
+            const uint32_t count = in.Read<uint32_t>();
+            CheckCount(in, count, kMinPortBytes, "port");
+            std::vector<SubgraphPort> ports;
+            ports.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                SubgraphPort port;
+                port.name = ReadSymbol(in, symbols);
+                port.type = static_cast<PinType>(in.Read<uint8_t>());
+                port.innerPinID = in.ReadUUID();
+                ports.push_back(port);
+            }
+            return ports;
+        }
+
+        void WriteRecord(BinaryWriter &out, const Node &node, SymbolTableWriter &symbols);
+        void ReadRecord(BinaryReader &in, Node &node, const std::vector<Symbol> &symbols, uint32_t version,
+                        uint32_t depth);
+
+        /// @brief Body of a subgraph node: definition identity, then its nodes (table fields followed
+        /// by their records), links and ports.
+        void WriteSubgraph(BinaryWriter &out, const SubgraphDefinition &definition, SymbolTableWriter &symbols)
+        {
+            out.WriteUUID(definition.id);
+            out.Write<uint64_t>(definition.version);
+            out.Write<uint32_t>(symbols.IndexOf(definition.name));
+            out.Write<uint64_t>(definition.nodes.size());
+            for (const auto &node : definition.nodes)
+            {
+                out.WriteUUID(node->id);
+                out.Write<uint32_t>(static_cast<uint32_t>(node->type));
+                out.Write(node->position.x);
+                out.Write(node->position.y);
+                WriteRecord(out, *node, symbols);
+            }
+            out.Write<uint64_t>(definition.links.size());
+            for (const auto &link : definition.links)
+            {
+                out.WriteUUID(link->id);
+                out.WriteUUID(link->startPinID);
+                out.WriteUUID(link->endPinID);
+            }
+            WritePorts(out, definition.inputs, symbols);
+            WritePorts(out, definition.outputs, symbols);
+        }
+
+        std::shared_ptr<const SubgraphDefinition> ReadSubgraph(BinaryReader &in, const std::shared_ptr<ObjectPool> &pool,
+                                                               const std::vector<Symbol> &symbols, uint32_t version,
+                                                               uint32_t depth)
+        {
+            if (depth >= kMaxSubgraphDepth)
+                throw std::runtime_error("Subgraphs nested too deeply");
+            auto definition = std::make_shared<SubgraphDefinition>();
+            definition->id = in.ReadUUID();
+            definition->version = in.Read<uint64_t>();
+            definition->name = ReadSymbol(in, symbols);
+            const uint64_t node_count = in.Read<uint64_t>();
+            CheckCount(in, node_count, kMinBodyNodeBytes, "subgraph node");
+            for (uint64_t i = 0; i < node_count; ++i)
+            {
+                const UUID id = in.ReadUUID();
+                const auto type = static_cast<NodeType>(in.Read<uint32_t>());
+                auto node = MakePooled<Node>(pool, id, Symbol(), type, pool);
+                node->position.x = in.Read<float>();
+                node->position.y = in.Read<float>();
+                ReadRecord(in, *node, symbols, version, depth + 1);
+                definition->nodes.push_back(std::move(node));
+            }
+            const uint64_t link_count = in.Read<uint64_t>();
+            CheckCount(in, link_count, kMinBodyLinkBytes, "subgraph link");
+            for (uint64_t i = 0; i < link_count; ++i)
+            {
+                const UUID id = in.ReadUUID();
+                const UUID start = in.ReadUUID();
+                const UUID end = in.ReadUUID();
+                definition->links.push_back(MakePooled<Link>(pool, id, start, end));
+            }
+            definition->inputs = ReadPorts(in, symbols);
+            definition->outputs = ReadPorts(in, symbols);
+            return definition;
+        }
+
+        void WriteRecord(BinaryWriter &out, const Node &node, SymbolTableWriter &symbols)
+        {
+            out.Write<uint32_t>(symbols.IndexOf(node.name));
+            out.Write<uint32_t>(static_cast<uint32_t>(node.parameters.size()));
+            for (const auto &param : node.parameters)
+            {
+                out.WriteString(param.first);
+                out.WriteString(param.second);
+            }
+            WritePins(out, node.inputPins, symbols);
+            WritePins(out, node.outputPins, symbols);
+            out.Write<uint8_t>(node.subgraph ? 1 : 0);
+            if (node.subgraph)
+                WriteSubgraph(out, *node.subgraph, symbols);
+        }
+
+        void ReadRecord(BinaryReader &in, Node &node, const std::vector<Symbol> &symbols, uint32_t version,
+                        uint32_t depth)
+        {
+            node.name = ReadName(in, symbols, version);
+            const uint32_t param_count = in.Read<uint32_t>();
+            CheckCount(in, param_count, kMinParameterBytes, "parameter");
+            for (uint32_t i = 0; i < param_count; ++i)
+            {
+                std::string param_name = in.ReadString();
+                node.parameters[std::move(param_name)] = in.ReadString();
+            }
+            ReadPins(in, node, PinDirection::Input, symbols, version);
+            ReadPins(in, node, PinDirection::Output, symbols, version);
+            // Records before format 3 have no subgraph flag: the node is an ordinary one
+            if (version >= 3 && in.Read<uint8_t>() != 0)
+                node.subgraph = ReadSubgraph(in, node.pool, symbols, version, depth);
+        }
+    } // namespace
+
+    void SymbolTableWriter::Write(BinaryWriter &out) const
+    {
+        out.Write<uint32_t>(static_cast<uint32_t>(m_Symbols.size()));
+        for (const Symbol symbol : m_Symbols)
+            out.WriteString(symbol.str());
+    }
+
+    std::vector<Symbol> ReadSymbolTable(BinaryReader &in)
+    {
+        const uint32_t count = in.Read<uint32_t>();
+        if (count > in.Remaining() / sizeof(uint32_t))
+            throw std::runtime_error("Corrupt symbol table");
+        std::vector<Symbol> symbols;
+        symbols.reserve(count);
+        for (uint32_t i = 0; i < count; ++i)
+            symbols.emplace_back(in.ReadString());
+        return symbols;
+    }
+
+    void WriteNodeRecord(BinaryWriter &out, const Node &node, SymbolTableWriter &symbols)
+    {
+        WriteRecord(out, node, symbols);
+    }
+
+    void ReadNodeRecord(BinaryReader &in, Node &node, const std::vector<Symbol> &symbols, uint32_t format_version)
+    {
+        ReadRecord(in, node, symbols, format_version, 0);
+    }
+
+    void ReadNodeOutline(BinaryReader &in, NodeOutline &outline, const std::vector<Symbol> &symbols,
+                         uint32_t format_version)
+    {
+        auto skip_string = [&] { in.Take(in.Read<uint32_t>()); };
+        outline.name = ReadName(in, symbols, format_version);
+        const uint32_t param_count = in.Read<uint32_t>();
+        CheckCount(in, param_count, kMinParameterBytes, "parameter");
+        for (uint32_t i = 0; i < param_count; ++i)
+        {
+            skip_string();
+            skip_string();
+        }
+
+        outline.pinIDs.clear();
+        for (int direction = 0; direction < 2; ++direction)
+        {
+            const uint32_t count = in.Read<uint32_t>();
+            CheckCount(in, count, kMinPinBytes, "pin");
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                outline.pinIDs.push_back(in.ReadUUID());
+                in.Take(1); // Type
+                if (format_version < 2)
+                    skip_string();
+                else
+                    in.Take(sizeof(uint32_t)); // Symbol index
+            }
+        }
+    }
+
+    void WriteNode(BinaryWriter &out, const Node &node)
+    {
+        out.WriteUUID(node.id);
+        out.Write<uint32_t>(static_cast<uint32_t>(node.type));
+        out.Write(node.position.x);
+        out.Write(node.position.y);
+
+        // The table precedes the record, so the record is staged to collect the names first
+        SymbolTableWriter symbols;
+        BinaryWriter record;
+        WriteNodeRecord(record, node, symbols);
+        symbols.Write(out);
+        out.Append(record);
+    }
+
+    std::shared_ptr<Node> ReadNode(BinaryReader &in, const std::shared_ptr<ObjectPool> &pool, uint32_t format_version)
+    {
+        const UUID id = in.ReadUUID();
+        const auto type = static_cast<NodeType>(in.Read<uint32_t>());
+        auto node = MakePooled<Node>(pool, id, Symbol(), type, pool);
+        node->position.x = in.Read<float>();
+        node->position.y = in.Read<float>();
+        const std::vector<Symbol> symbols = format_version >= 2 ? ReadSymbolTable(in) : std::vector<Symbol>();
+        ReadNodeRecord(in, *node, symbols, format_version);
+        return node;
+    }
+
+    GraphFileHeader ReadGraphFileHeader(BinaryReader &in, const std::string &path)
+    {
+        GraphFileHeader header;
+        header.magic = in.Read<uint32_t>();
+        if (header.magic != GraphFileHeader::kMagic)
+            throw std::runtime_error("'" + path + "' is not a MindWeaver graph file");
+        header.formatVersion = in.Read<uint32_t>();
+        if (header.formatVersion < GraphFileHeader::kOldestFormatVersion ||
+            header.formatVersion > GraphFileHeader::kFormatVersion)
+            throw std::runtime_error("'" + path + "' uses unsupported format version " +
+                                     std::to_string(header.formatVersion));
+        header.fileID = in.Read<uint64_t>();
+        header.graphVersion = in.Read<uint64_t>();
+        header.nodeCount = in.Read<uint64_t>();
+        header.linkCount = in.Read<uint64_t>();
+        header.nodeTableOffset = in.Read<uint64_t>();
+        header.linkTableOffset = in.Read<uint64_t>();
+        if (header.formatVersion >= 2)
+            header.symbolTableOffset = in.Read<uint64_t>(); // Format 1 has no symbol table
+        return header;
+    }
+
+    uint64_t WriteGraphFile(const std::string &path, const GraphSnapshot &snapshot)
+    {
+        BinaryWriter out;
+        GraphFileHeader header;
+        std::memcpy(&header.fileID, UUID::generate().data(), sizeof(header.fileID));
+        header.graphVersion = snapshot.version;
+        header.nodeCount = snapshot.nodes.size();
+        header.linkCount = snapshot.links.size();
+        const size_t header_offset = out.Skip(sizeof(GraphFileHeader)); // Patched once offsets are known
+        out.WriteString(snapshot.name);
+
+        header.nodeTableOffset = out.Skip(snapshot.nodes.size() * sizeof(NodeTableEntry));
+        size_t entry_offset = header.nodeTableOffset;
+        SymbolTableWriter symbols;
+        for (const auto &stored : snapshot.nodes)
+        {
+            const auto node = snapshot.Resolve(stored);
+            NodeTableEntry entry{};
+            std::memcpy(entry.id, node->id.data(), sizeof(entry.id));
+            entry.type = static_cast<uint32_t>(node->type);
+            entry.x = node->position.x;
+            entry.y = node->position.y;
+            entry.recordOffset = out.Size();
+            WriteNodeRecord(out, *node, symbols);
+            entry.recordSize = out.Size() - entry.recordOffset;
+            out.Patch(entry_offset, entry);
+            entry_offset += sizeof(NodeTableEntry);
+        }
+
+        header.linkTableOffset = out.Size();
+        for (const auto &link : snapshot.links)
+        {
+            LinkRecord record;
+            std::memcpy(record.id, link->id.data(), sizeof(record.id));
+            std::memcpy(record.startPinID, link->startPinID.data(), sizeof(record.startPinID));
+            std::memcpy(record.endPinID, link->endPinID.data(), sizeof(record.endPinID));
+            out.Write(record);
+        }
+
+        header.symbolTableOffset = out.Size();
+        symbols.Write(out);
+        out.Patch(header_offset, header);
+
+        WriteFileAtomically(path, out.Bytes());
+        return header.fileID;
+    }
+
+    GraphSnapshot ReadGraphFile(const std::string &path, uint64_t *file_id)
+    {
+        GraphSnapshot snapshot = OpenGraphFileLazily(path, file_id).Materialized();
+        snapshot.nodeSource = nullptr; // Fully loaded: release the mapping
+        return snapshot;
+    }
+
+    void WriteFileAtomically(const std::string &path, const std::string &bytes)
+    {
+        const std::string temp_path = path + ".tmp";
+        FILE *file = std::fopen(temp_path.c_str(), "wb");
+        if (!file)
+            throw std::runtime_error("Failed to create '" + temp_path + "'");
+        bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && std::fflush(file) == 0;
+#ifdef _WIN32
+        ok = ok && _commit(_fileno(file)) == 0;
+#else
+        ok = ok && ::fsync(::fileno(file)) == 0;
+#endif
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok)
+        {
+            std::remove(temp_path.c_str());
+            throw std::runtime_error("Failed to write '" + temp_path + "'");
+        }
+
+#ifdef _WIN32
+        const bool renamed =
+            MoveFileExA(temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+        const bool renamed = std::rename(temp_path.c_str(), path.c_str()) == 0;
+#endif
+        if (!renamed)
+        {
+            std::remove(temp_path.c_str());
+            throw std::runtime_error("Failed to replace '" + path + "'");
+        }
+    }
+
+} // namespace MindWeaver
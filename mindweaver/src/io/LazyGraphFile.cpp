@@ -0,0 +1,191 @@
+#include "io/LazyGraphFile.h"
+
+#include "core/NodeSource.h"
+#include "io/BinaryStream.h"
+#include "io/GraphFile.h"
+#include "runtime/MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        /// @brief Decodes node records straight from the mapped file. Decoded nodes are remembered
+        /// weakly: while a graph, snapshot or run still holds one, later loads share it instead of
+        /// decoding the record again, and once nobody does it is freed. So passes over the whole
+        /// graph (compacting the autosave, say) do not leave every node resident.
+        class MappedNodeSource : public NodeSource
+        {
+        public:
+            MappedNodeSource(std::shared_ptr<MappedFile> file, const GraphFileHeader &header,
+                             std::vector<Symbol> symbols, std::shared_ptr<ObjectPool> pool)
+                : m_File(std::move(file)), m_Header(header), m_Symbols(std::move(symbols)), m_Pool(std::move(pool)),
+                  m_Loaded(header.nodeCount)
+            {
+                // Sorted (ID, table index) pairs: far smaller than a hash map for huge graphs
+                m_Index.reserve(header.nodeCount);
+                for (uint64_t i = 0; i < header.nodeCount; ++i)
+                    m_Index.emplace_back(UUID::from_bytes(Entry(i).id), i);
+                std::sort(m_Index.begin(), m_Index.end(), [](const auto &a, const auto &b)
+                          { return std::memcmp(a.first.data(), b.first.data(), 16) < 0; });
+            }
+
+            NodeTableEntry Entry(uint64_t index) const
+            {
+                NodeTableEntry entry;
+                std::memcpy(&entry, m_File->Data() + m_Header.nodeTableOffset + index * sizeof(NodeTableEntry),
+                            sizeof(entry));
+                return entry;
+            }
+
+            std::shared_ptr<const Node> Load(const Node &placeholder) const override
+            {
+                const uint64_t index = Find(placeholder.id);
+                std::shared_ptr<const Node> loaded = Loaded(index);
+                if (!loaded)
+                {
+                    // Decoded outside the lock; when two threads race, the first stored copy wins
+                    std::shared_ptr<const Node> decoded = Decode(index);
+                    std::lock_guard<std::mutex> lock(m_LoadedMutex);
+                    loaded = m_Loaded[index].lock();
+                    if (!loaded)
+                    {
+                        m_Loaded[index] = decoded;
+                        loaded = std::move(decoded);
+                    }
+                }
+                if (loaded->type == placeholder.type && loaded->position.x == placeholder.position.x &&
+                    loaded->position.y == placeholder.position.y)
+                    return loaded;
+                // The placeholder was edited (moved) before it was loaded
+                auto moved = MakePooled<Node>(m_Pool, *loaded);
+                moved->type = placeholder.type;
+                moved->position = placeholder.position;
+                return moved;
+            }
+
+            bool Outline(const Node &placeholder, NodeOutline &outline) const override
+            {
+                const uint64_t index = Find(placeholder.id);
+                if (std::shared_ptr<const Node> loaded = Loaded(index))
+                {
+                    outline.name = loaded->name;
+                    outline.pinIDs.clear();
+                    for (const auto &pair : loaded->inputPins)
+                        outline.pinIDs.push_back(pair.first);
+                    for (const auto &pair : loaded->outputPins)
+                        outline.pinIDs.push_back(pair.first);
+                    return true;
+                }
+                BinaryReader in = Record(Entry(index));
+                ReadNodeOutline(in, outline, m_Symbols, m_Header.formatVersion);
+                return true;
+            }
+
+        private:
+            /// @brief Table index of the node with the given ID.
+            uint64_t Find(const UUID &id) const
+            {
+                auto it = std::lower_bound(m_Index.begin(), m_Index.end(), id,
+                                           [](const auto &item, const UUID &key)
+                                           { return std::memcmp(item.first.data(), key.data(), 16) < 0; });
+                if (it == m_Index.end() || !(it->first == id))
+                    throw std::runtime_error("Node " + id.to_string() + " is not in '" + m_File->GetPath() + "'");
+                return it->second;
+            }
+
+            /// @brief The decoded node at index if someone still holds it, else null.
+            std::shared_ptr<const Node> Loaded(uint64_t index) const
+            {
+                std::lock_guard<std::mutex> lock(m_LoadedMutex);
+                return m_Loaded[index].lock();
+            }
+
+            BinaryReader Record(const NodeTableEntry &entry) const
+            {
+                if (entry.recordOffset > m_File->Size() || entry.recordSize > m_File->Size() - entry.recordOffset)
+                    throw std::runtime_error("Corrupt node record in '" + m_File->GetPath() + "'");
+                return BinaryReader(m_File->Data() + entry.recordOffset, entry.recordSize);
+            }
+
+            /// @brief The node as stored in the file (type and position from its table entry).
+            std::shared_ptr<Node> Decode(uint64_t index) const
+            {
+                const NodeTableEntry entry = Entry(index);
+                BinaryReader in = Record(entry);
+                // Allocated apart from its control block (unlike MakePooled), so that the weak
+                // reference kept in m_Loaded does not hold on to the node's memory once it is freed
+                std::shared_ptr<Node> node(
+                    new Node(UUID::from_bytes(entry.id), Symbol(), static_cast<NodeType>(entry.type), m_Pool));
+                node->position = Position(entry.x, entry.y);
+                ReadNodeRecord(in, *node, m_Symbols, m_Header.formatVersion);
+                return node;
+            }
+
+            std::shared_ptr<MappedFile> m_File;
+            GraphFileHeader m_Header;
+            std::vector<Symbol> m_Symbols; // The file's table, interned once at open
+            std::shared_ptr<ObjectPool> m_Pool;
+            std::vector<std::pair<UUID, uint64_t>> m_Index;
+            mutable std::mutex m_LoadedMutex;
+            mutable std::vector<std::weak_ptr<const Node>> m_Loaded; // By table index
+        };
+    } // namespace
+
+    GraphSnapshot OpenGraphFileLazily(const std::string &path, uint64_t *file_id)
+    {
+        auto file = std::make_shared<MappedFile>(path);
+        BinaryReader in(file->Data(), file->Size());
+        const GraphFileHeader header = ReadGraphFileHeader(in, path);
+        if (header.nodeTableOffset > file->Size() ||
+            header.nodeCount > (file->Size() - header.nodeTableOffset) / sizeof(NodeTableEntry))
+            throw std::runtime_error("Corrupt node table in '" + path + "'");
+        if (file_id)
+            *file_id = header.fileID;
+
+        // Placeholders, links and loaded nodes of one file share a pool
+        auto pool = std::make_shared<ObjectPool>();
+
+        GraphSnapshot snapshot;
+        snapshot.name = in.ReadString();
+        snapshot.version = header.graphVersion;
+
+        in.Seek(header.nodeTableOffset);
+        for (uint64_t i = 0; i < header.nodeCount; ++i)
+        {
+            const auto entry = in.Read<NodeTableEntry>();
+            auto node = MakePooled<Node>(pool, UUID::from_bytes(entry.id), Symbol(),
+                                         static_cast<NodeType>(entry.type), pool);
+            node->position = Position(entry.x, entry.y);
+            node->placeholder = true;
+            snapshot.nodes.push_back(std::move(node));
+        }
+
+        in.Seek(header.linkTableOffset);
+        for (uint64_t i = 0; i < header.linkCount; ++i)
+        {
+            const auto record = in.Read<LinkRecord>();
+            snapshot.links.push_back(MakePooled<Link>(pool, UUID::from_bytes(record.id), UUID::from_bytes(record.startPinID),
+                                                      UUID::from_bytes(record.endPinID)));
+        }
+
+        std::vector<Symbol> symbols;
+        if (header.formatVersion >= 2)
+        {
+            in.Seek(header.symbolTableOffset);
+            symbols = ReadSymbolTable(in);
+        }
+
+        snapshot.nodeSource = std::make_shared<MappedNodeSource>(std::move(file), header, std::move(symbols), std::move(pool));
+        return snapshot;
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,147 @@
+#include "io/MutationLog.h"
+
+#include "io/GraphFile.h"
+#include "runtime/MappedFile.h"
+
+#include <stdexcept>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        uint32_t Checksum(const char *data, size_t size)
+        {
+            uint32_t hash = 2166136261u; // FNV-1a
+            for (size_t i = 0; i < size; ++i)
+            {
+                hash ^= static_cast<uint8_t>(data[i]);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+    } // namespace
+
+    void AppendMutationRecord(BinaryWriter &out, const GraphMutation &mutation)
+    {
+        const size_t frame = out.Skip(2 * sizeof(uint32_t)); // Size and checksum, patched below
+        const size_t start = out.Size();
+
+        out.Write(static_cast<uint8_t>(mutation.kind));
+        out.Write(mutation.version);
+        switch (mutation.kind)
+        {
+        case GraphMutationKind::AddNode:
+            WriteNode(out, *mutation.node);
+            break;
+        case GraphMutationKind::RemoveNode:
+        case GraphMutationKind::RemoveLink:
+            out.WriteUUID(mutation.targetID);
+            break;
+        case GraphMutationKind::SetNodePosition:
+            out.WriteUUID(mutation.targetID);
+            out.Write(mutation.position.x);
+            out.Write(mutation.position.y);
+            break;
+        case GraphMutationKind::SetNodeParameter:
+            out.WriteUUID(mutation.targetID);
+            out.WriteString(mutation.paramName);
+            out.WriteString(mutation.paramValue);
+            break;
+        case GraphMutationKind::AddLink:
+            out.WriteUUID(mutation.link->id);
+            out.WriteUUID(mutation.link->startPinID);
+            out.WriteUUID(mutation.link->endPinID);
+            break;
+        }
+
+        const size_t size = out.Size() - start;
+        out.Patch(frame, static_cast<uint32_t>(size));
+        out.Patch(frame + sizeof(uint32_t), Checksum(out.Bytes().data() + start, size));
+    }
+
+    GraphMutation DecodeMutation(BinaryReader &in, const std::shared_ptr<ObjectPool> &pool, uint32_t format_version)
+    {
+        GraphMutation mutation;
+        mutation.kind = static_cast<GraphMutationKind>(in.Read<uint8_t>());
+        mutation.version = in.Read<uint64_t>();
+        switch (mutation.kind)
+        {
+        case GraphMutationKind::AddNode:
+            mutation.node = ReadNode(in, pool, format_version);
+            break;
+        case GraphMutationKind::RemoveNode:
+        case GraphMutationKind::RemoveLink:
+            mutation.targetID = in.ReadUUID();
+            break;
+        case GraphMutationKind::SetNodePosition:
+            mutation.targetID = in.ReadUUID();
+            mutation.position.x = in.Read<float>();
+            mutation.position.y = in.Read<float>();
+            break;
+        case GraphMutationKind::SetNodeParameter:
+            mutation.targetID = in.ReadUUID();
+            mutation.paramName = in.ReadString();
+            mutation.paramValue = in.ReadString();
+            break;
+        case GraphMutationKind::AddLink:
+        {
+            const UUID id = in.ReadUUID();
+            const UUID start = in.ReadUUID();
+            const UUID end = in.ReadUUID();
+            mutation.link = MakePooled<Link>(pool, id, start, end);
+            break;
+        }
+        default:
+            throw std::runtime_error("Unknown mutation kind in log");
+        }
+        return mutation;
+    }
+
+    std::vector<GraphMutation> ReadMutationLog(const std::string &path, uint64_t &base_file_id)
+    {
+        MappedFile file(path);
+        BinaryReader in(file.Data(), file.Size());
+        const auto header = in.Read<MutationLogHeader>();
+        if (header.magic != MutationLogHeader::kMagic)
+            throw std::runtime_error("'" + path + "' is not a MindWeaver mutation log");
+        if (header.formatVersion < MutationLogHeader::kOldestFormatVersion ||
+            header.formatVersion > MutationLogHeader::kFormatVersion)
+            throw std::runtime_error("'" + path + "' uses unsupported format version " +
+                                     std::to_string(header.formatVersion));
+        base_file_id = header.baseFileID;
+
+        std::vector<GraphMutation> mutations;
+        auto pool = std::make_shared<ObjectPool>(); // Recovered objects share one pool
+        while (in.Remaining() >= 2 * sizeof(uint32_t))
+        {
+            const uint32_t size = in.Read<uint32_t>();
+            const uint32_t checksum = in.Read<uint32_t>();
+            if (size > in.Remaining())
+                break; // Torn final record
+            const uint8_t *payload = in.Take(size);
+            if (Checksum(reinterpret_cast<const char *>(payload), size) != checksum)
+                break;
+            try
+            {
+                BinaryReader record(payload, size);
+                mutations.push_back(DecodeMutation(record, pool, header.formatVersion));
+            }
+            catch (const std::runtime_error &)
+            {
+                break;
+            }
+        }
+        return mutations;
+    }
+
+    std::string MakeMutationLogHeader(uint64_t base_file_id)
+    {
+        BinaryWriter out;
+        MutationLogHeader header;
+        header.baseFileID = base_file_id;
+        out.Write(header);
+        return out.Bytes();
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,225 @@
+#include "python/PythonInterop.h"
+#include "python/PythonNode.h"
+
+#include "runtime/Buffer.h"
+
+#include <pybind11/numpy.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace py = pybind11;
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        py::dtype ToNumpyType(ElementType type)
+        {
+            switch (type)
+            {
+            case ElementType::Bool:
+                return py::dtype::of<bool>();
+            case ElementType::UInt8:
+                return py::dtype::of<uint8_t>();
+            case ElementType::UInt16:
+                return py::dtype::of<uint16_t>();
+            case ElementType::Int32:
+                return py::dtype::of<int32_t>();
+            case ElementType::Int64:
+                return py::dtype::of<int64_t>();
+            case ElementType::Float16:
+                return py::dtype("float16");
+            case ElementType::Float32:
+                return py::dtype::of<float>();
+            case ElementType::Float64:
+                return py::dtype::of<double>();
+            }
+            throw std::runtime_error("Unknown buffer element type");
+        }
+
+        /// @brief Maps a native-endian NumPy dtype onto an ElementType; false if there is none.
+        bool FromNumpyType(const py::dtype &dtype, ElementType &type)
+        {
+            if (!dtype.attr("isnative").cast<bool>())
+                return false;
+            const char kind = dtype.kind();
+            const py::ssize_t size = dtype.itemsize();
+            if (kind == 'b' && size == 1)
+                type = ElementType::Bool;
+            else if (kind == 'u' && size == 1)
+                type = ElementType::UInt8;
+            else if (kind == 'u' && size == 2)
+                type = ElementType::UInt16;
+            else if (kind == 'i' && size == 4)
+                type = ElementType::Int32;
+            else if (kind == 'i' && size == 8)
+                type = ElementType::Int64;
+            else if (kind == 'f' && size == 2)
+                type = ElementType::Float16;
+            else if (kind == 'f' && size == 4)
+                type = ElementType::Float32;
+            else if (kind == 'f' && size == 8)
+                type = ElementType::Float64;
+            else
+                return false;
+            return true;
+        }
+
+        py::object BufferToNumpy(const Buffer &buffer)
+        {
+            // The capsule holds a reference to the buffer's owner for as long as the array (or any
+            // view of it) is alive; the elements themselves are never copied
+            auto *owner = new std::shared_ptr<const void>(buffer.owner);
+            py::capsule base(owner, [](void *ptr) { delete static_cast<std::shared_ptr<const void> *>(ptr); });
+
+            std::vector<py::ssize_t> shape(buffer.shape.begin(), buffer.shape.end());
+            std::vector<py::ssize_t> strides(buffer.strides.begin(), buffer.strides.end());
+            py::array array(ToNumpyType(buffer.dtype), shape, strides, buffer.data, base);
+            // Other consumers may share the same elements
+            array.attr("setflags")(py::arg("write") = false);
+            return std::move(array);
+        }
+
+        Buffer NumpyToBuffer(py::array array, ElementType type)
+        {
+            // Buffers are immutable, so Python must not be able to write the adopted elements: an
+            // array owning them is frozen in place, a writeable view of someone else's memory (which
+            // other views may still write through) is copied first
+            if (array.writeable())
+            {
+                if (array.owndata())
+                    array.attr("setflags")(py::arg("write") = false);
+                else
+                    array = py::array(array.attr("copy")());
+            }
+            std::vector<int64_t> shape(array.shape(), array.shape() + array.ndim());
+            std::vector<int64_t> strides(array.strides(), array.strides() + array.ndim());
+            // The array object itself is the owner: the elements stay valid while any Buffer copy
+            // holds it, and the last copy drops the reference under the GIL
+            PythonObject holder = MakePythonObject(array);
+            return Buffer::Wrap(std::shared_ptr<const void>(holder.object, array.data()), array.data(), type,
+                                std::move(shape), std::move(strides));
+        }
+    } // namespace
+
+    PythonObject MakePythonObject(py::object obj)
+    {
+        PythonObject wrapped;
+        wrapped.object = std::shared_ptr<py::object>(new py::object(std::move(obj)),
+                                                     [](py::object *ptr)
+                                                     {
+                                                         if (!Py_IsInitialized())
+                                                         {
+                                                             // Interpreter already gone; leak the reference
+                                                             ptr->release();
+                                                             delete ptr;
+                                                             return;
+                                                         }
+                                                         py::gil_scoped_acquire gil;
+                                                         delete ptr;
+                                                     });
+        return wrapped;
+    }
+
+    py::object ToPython(const Value &value)
+    {
+        switch (value.GetKind())
+        {
+        case ValueKind::Empty:
+            return py::none();
+        case ValueKind::Bool:
+            return py::bool_(value.GetBool());
+        case ValueKind::Int:
+            return py::int_(value.GetInt());
+        case ValueKind::Float:
+            return py::float_(value.GetFloat());
+        case ValueKind::String:
+        {
+            const std::string_view text = value.GetString();
+            return py::str(text.data(), text.size());
+        }
+        case ValueKind::Vector:
+        {
+            const FloatVector &vector = value.GetVector();
+            py::list list(vector.size());
+            for (size_t i = 0; i < vector.size(); ++i)
+                list[i] = py::float_(vector[i]);
+            return std::move(list);
+        }
+        case ValueKind::Buffer:
+            return BufferToNumpy(value.GetBuffer());
+        case ValueKind::Object:
+            if (const auto *v = value.GetObject<PythonObject>())
+                return v->object ? *v->object : py::none();
+            break;
+        }
+        throw std::runtime_error(std::string("Pin value of type '") + value.GetObjectType().name() +
+                                 "' has no Python representation");
+    }
+
+    Value FromPython(const py::handle &value)
+    {
+        PyObject *obj = value.ptr();
+        if (PyBool_Check(obj)) // Before PyLong_Check: bool is an int subclass
+            return static_cast<bool>(obj == Py_True);
+        if (PyLong_Check(obj))
+            return static_cast<int64_t>(value.cast<long long>());
+        if (PyFloat_Check(obj))
+            return value.cast<double>();
+        if (PyUnicode_Check(obj))
+        {
+            Py_ssize_t size = 0;
+            const char *text = PyUnicode_AsUTF8AndSize(obj, &size);
+            if (!text)
+                throw py::error_already_set();
+            return std::string_view(text, static_cast<size_t>(size));
+        }
+        if (py::isinstance<py::array>(value))
+        {
+            auto array = py::reinterpret_borrow<py::array>(value);
+            ElementType type;
+            if (FromNumpyType(array.dtype(), type))
+                return NumpyToBuffer(array, type);
+        }
+        return MakePythonObject(py::reinterpret_borrow<py::object>(value));
+    }
+
+    namespace
+    {
+        thread_local PyGILState_STATE t_GilState;
+    }
+
+    void PythonGilLock::Acquire() { t_GilState = PyGILState_Ensure(); }
+
+    void PythonGilLock::Release() { PyGILState_Release(t_GilState); }
+
+    ProcessForkHooks MakePythonForkHooks()
+    {
+        // fork() must happen with the GIL held so the child gets a consistent interpreter; the child
+        // then releases its copy so its own PythonGilLock can take it
+        static thread_local PyGILState_STATE fork_state;
+        ProcessForkHooks hooks;
+        hooks.prepare = []
+        {
+            fork_state = PyGILState_Ensure();
+            PyOS_BeforeFork();
+        };
+        hooks.parent = []
+        {
+            PyOS_AfterFork_Parent();
+            PyGILState_Release(fork_state);
+        };
+        hooks.child = []
+        {
+            PyOS_AfterFork_Child();
+            ResetPythonProcessPoolAfterFork();
+            PyGILState_Release(fork_state);
+        };
+        return hooks;
+    }
+
+} // namespace MindWeaver
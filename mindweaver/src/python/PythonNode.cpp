@@ -0,0 +1,145 @@
+#include "python/PythonNode.h"
+
+#include "python/PythonInterop.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        std::vector<std::string> DataOutputNames(const Node &node)
+        {
+            std::vector<std::string> names;
+            for (const auto &pair : node.outputPins)
+            {
+                if (pair.second->type != PinType::Exec)
+                    names.push_back(pair.second->name.str());
+            }
+            std::sort(names.begin(), names.end());
+            return names;
+        }
+
+        py::dict BuildArguments(const ExecutionContext &context)
+        {
+            const Node &node = context.GetNode();
+            py::dict kwargs;
+            for (const auto &param : node.parameters)
+                kwargs[py::str(param.first)] = py::str(param.second);
+            for (const auto &pair : node.inputPins)
+            {
+                const Symbol name = pair.second->name;
+                if (pair.second->type != PinType::Exec && context.HasInput(name))
+                    kwargs[py::str(name.str())] = ToPython(context.GetInput(name));
+            }
+            return kwargs;
+        }
+
+        void ApplyResult(ExecutionContext &context, const py::object &result)
+        {
+            const std::vector<std::string> outputs = DataOutputNames(context.GetNode());
+            if (py::isinstance<py::dict>(result))
+            {
+                for (const auto &item : result.cast<py::dict>())
+                    context.SetOutput(item.first.cast<std::string>(), FromPython(item.second));
+            }
+            else if (py::isinstance<py::tuple>(result) && outputs.size() > 1)
+            {
+                py::tuple values = result.cast<py::tuple>();
+                if (values.size() != outputs.size())
+                    throw std::runtime_error("Python node returned " + std::to_string(values.size()) +
+                                             " values for " + std::to_string(outputs.size()) + " outputs");
+                for (size_t i = 0; i < outputs.size(); ++i)
+                    context.SetOutput(outputs[i], FromPython(values[i]));
+            }
+            else if (outputs.size() == 1)
+                context.SetOutput(outputs[0], FromPython(result));
+            else if (!result.is_none())
+                throw std::runtime_error("Python node returned a value but has " + std::to_string(outputs.size()) +
+                                         " data outputs; return a dict keyed by output name");
+        }
+
+        // Shared process pool for CPU-bound nodes. Never destroyed: shutting the pool down at static
+        // destruction would need the interpreter
+        py::object *process_pool = nullptr;
+
+        /// @brief The process pool, created on first use. Caller holds the GIL.
+        py::object &GetProcessPool()
+        {
+            if (!process_pool)
+                process_pool = new py::object(py::module_::import("concurrent.futures")
+                                                  .attr("ProcessPoolExecutor")(
+                                                      py::arg("mp_context") =
+                                                          py::module_::import("multiprocessing").attr("get_context")("spawn")));
+            return *process_pool;
+        }
+    } // namespace
+
+    KernelInfo MakePythonKernel(py::object callable, const PythonNodeOptions &options)
+    {
+        PythonObject fn = MakePythonObject(std::move(callable));
+
+        KernelInfo info;
+        info.sideEffects = options.sideEffects;
+        if (!options.cpuBound)
+        {
+            // The executor already holds the GIL (via PythonGilLock) around interpreter batches
+            info.affinity = ExecutionAffinity::Interpreter;
+            info.kernel = [fn](ExecutionContext &context)
+            {
+                try
+                {
+                    py::object result = (*fn.object)(**BuildArguments(context));
+                    ApplyResult(context, result);
+                }
+                catch (py::error_already_set &e)
+                {
+                    throw std::runtime_error(e.what()); // Do not let the Python error escape the GIL
+                }
+            };
+        }
+        else
+        {
+            // Runs on a native worker; takes the GIL only around submit and unpacking
+            info.affinity = ExecutionAffinity::Any;
+            info.kernel = [fn](ExecutionContext &context)
+            {
+                py::gil_scoped_acquire gil;
+                try
+                {
+                    py::object future = GetProcessPool().attr("submit")(*fn.object, **BuildArguments(context));
+                    py::object result = future.attr("result")(); // Waits with the GIL released
+                    ApplyResult(context, result);
+                }
+                catch (py::error_already_set &e)
+                {
+                    throw std::runtime_error(e.what());
+                }
+            };
+        }
+        return info;
+    }
+
+    void ResetPythonProcessPoolAfterFork()
+    {
+        if (!process_pool)
+            return;
+        // The child's copy has no management thread, so shutting it down would wait forever; the
+        // reference is dropped without touching the object (the parent still owns the pool)
+        process_pool->release();
+        delete process_pool;
+        process_pool = nullptr;
+    }
+
+    void RegisterPythonNode(KernelRegistry &registry, const std::string &node_name, py::object callable,
+                            const PythonNodeOptions &options)
+    {
+        registry.Register(node_name, MakePythonKernel(std::move(callable), options));
+    }
+
+} // namespace MindWeaver
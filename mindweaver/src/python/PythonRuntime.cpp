@@ -0,0 +1,26 @@
+#include "python/PythonRuntime.h"
+
+#include <pybind11/embed.h>
+
+namespace py = pybind11;
+
+namespace MindWeaver
+{
+
+    PythonRuntime::PythonRuntime()
+    {
+        py::initialize_interpreter();
+#ifdef MINDWEAVER_PYTHON_EXECUTABLE
+        // Spawned worker processes (CPU-bound Python nodes) must start the real interpreter, not the editor
+        py::module_::import("multiprocessing").attr("set_executable")(MINDWEAVER_PYTHON_EXECUTABLE);
+#endif
+        m_MainThreadState = PyEval_SaveThread();
+    }
+
+    PythonRuntime::~PythonRuntime()
+    {
+        PyEval_RestoreThread(static_cast<PyThreadState *>(m_MainThreadState));
+        py::finalize_interpreter();
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,128 @@
+#include "runtime/Buffer.h"
+
+#include "runtime/ExecutionStats.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace MindWeaver
+{
+
+    size_t ElementSize(ElementType type)
+    {
+        switch (type)
+        {
+        case ElementType::Bool:
+        case ElementType::UInt8:
+            return 1;
+        case ElementType::UInt16:
+        case ElementType::Float16:
+            return 2;
+        case ElementType::Int32:
+        case ElementType::Float32:
+            return 4;
+        case ElementType::Int64:
+        case ElementType::Float64:
+            return 8;
+        }
+        return 0;
+    }
+
+    std::vector<int64_t> Buffer::ContiguousStrides(ElementType dtype, const std::vector<int64_t> &shape)
+    {
+        std::vector<int64_t> strides(shape.size());
+        int64_t stride = static_cast<int64_t>(ElementSize(dtype));
+        for (size_t i = shape.size(); i-- > 0;)
+        {
+            strides[i] = stride;
+            stride *= shape[i];
+        }
+        return strides;
+    }
+
+    Buffer Buffer::Allocate(ElementType dtype, std::vector<int64_t> shape)
+    {
+        size_t count = 1;
+        for (int64_t extent : shape)
+        {
+            if (extent < 0)
+                throw std::invalid_argument("Buffer::Allocate: negative extent");
+            count *= static_cast<size_t>(extent);
+        }
+        const size_t bytes = count * ElementSize(dtype);
+        std::shared_ptr<uint8_t> storage(new uint8_t[bytes], std::default_delete<uint8_t[]>());
+        GetThreadCounters().bytesAllocated += bytes;
+        const void *data = storage.get();
+        return Wrap(std::move(storage), data, dtype, std::move(shape));
+    }
+
+    Buffer Buffer::Wrap(std::shared_ptr<const void> owner, const void *data, ElementType dtype,
+                        std::vector<int64_t> shape, std::vector<int64_t> strides)
+    {
+        if (strides.empty())
+            strides = ContiguousStrides(dtype, shape);
+        else if (strides.size() != shape.size())
+            throw std::invalid_argument("Buffer::Wrap: shape and strides differ in rank");
+
+        Buffer buffer;
+        buffer.owner = std::move(owner);
+        buffer.data = data;
+        buffer.dtype = dtype;
+        buffer.shape = std::move(shape);
+        buffer.strides = std::move(strides);
+        return buffer;
+    }
+
+    size_t Buffer::ElementCount() const
+    {
+        size_t count = 1;
+        for (int64_t extent : shape)
+            count *= static_cast<size_t>(extent);
+        return count;
+    }
+
+    bool Buffer::IsContiguous() const { return strides == ContiguousStrides(dtype, shape); }
+
+    void Buffer::CopyTo(void *destination) const
+    {
+        const size_t bytes = ByteSize();
+        if (bytes == 0)
+            return;
+        if (IsContiguous())
+        {
+            std::memcpy(destination, data, bytes);
+            return;
+        }
+
+        // Walk the outer dimensions with an index counter and copy one innermost row at a time
+        const size_t element_size = ElementSize(dtype);
+        const size_t rank = shape.size();
+        const int64_t inner_extent = shape[rank - 1];
+        const bool inner_packed = strides[rank - 1] == static_cast<int64_t>(element_size);
+        std::vector<int64_t> index(rank, 0);
+        uint8_t *out = static_cast<uint8_t *>(destination);
+        while (true)
+        {
+            const uint8_t *row = static_cast<const uint8_t *>(data);
+            for (size_t d = 0; d + 1 < rank; ++d)
+                row += index[d] * strides[d];
+            if (inner_packed)
+            {
+                std::memcpy(out, row, inner_extent * element_size);
+                out += inner_extent * element_size;
+            }
+            else
+            {
+                for (int64_t i = 0; i < inner_extent; ++i, out += element_size)
+                    std::memcpy(out, row + i * strides[rank - 1], element_size);
+            }
+
+            size_t d = rank - 1;
+            while (d > 0 && ++index[d - 1] == shape[d - 1])
+                index[--d] = 0;
+            if (d == 0)
+                return;
+        }
+    }
+
+} // namespace MindWeaver
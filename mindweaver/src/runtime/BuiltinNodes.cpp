@@ -0,0 +1,43 @@
+#include "runtime/BuiltinNodes.h"
+
+#include "runtime/NodeCatalog.h"
+#include "runtime/ResourceCache.h"
+
+#include <stdexcept>
+
+namespace MindWeaver
+{
+
+    Buffer LoadFileNode::Execute(ExecutionContext &context)
+    {
+        const std::string path = context.GetParameter("path");
+        if (path.empty())
+            throw std::runtime_error("Load File: no path set");
+        // The buffer holds the cache handle, which keeps the entry pinned while the data is in use
+        std::shared_ptr<const MappedFile> file = context.GetResourceCache().AcquireMappedFile(path);
+        const void *data = file->Data();
+        const int64_t size = static_cast<int64_t>(file->Size());
+        return Buffer::Wrap(std::move(file), data, ElementType::UInt8, {size});
+    }
+
+    void RegisterBuiltinNodes(KernelRegistry &registry, NodeCatalog *catalog)
+    {
+        RegisterOperator<AddNode>(registry);
+        RegisterOperator<SubtractNode>(registry);
+        RegisterOperator<MultiplyNode>(registry);
+        RegisterOperator<DivideNode>(registry);
+        RegisterNode<ConcatenateNode>(registry);
+        RegisterNode<LoadFileNode>(registry);
+
+        if (catalog)
+        {
+            AddToCatalog<AddNode>(*catalog, "Math");
+            AddToCatalog<SubtractNode>(*catalog, "Math");
+            AddToCatalog<MultiplyNode>(*catalog, "Math");
+            AddToCatalog<DivideNode>(*catalog, "Math");
+            AddToCatalog<ConcatenateNode>(*catalog, "String");
+            AddToCatalog<LoadFileNode>(*catalog, "Files");
+        }
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,279 @@
+#include "runtime/ExecutionPlan.h"
+
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        PinType FindPinType(const PinMap &pins, Symbol name)
+        {
+            for (const auto &pair : pins)
+                if (pair.second->name == name)
+                    return pair.second->type;
+            return PinType::Exec;
+        }
+
+        /// @brief Whether values of the kind can be relied on to be of it: Empty (no value yet)
+        /// and Object (any C++ type, e.g. a Python object) only settle at run time.
+        bool IsStaticKind(ValueKind kind) { return kind != ValueKind::Empty && kind != ValueKind::Object; }
+
+        /// @brief Orders bindings as listed in the signature, so a typed kernel can address them by
+        /// position; throws if the node's data pins do not match the signature (in name and count
+        /// only unless check_types).
+        template <typename Binding>
+        void OrderBindings(std::vector<Binding> &bindings, const std::vector<KernelSignature::PinSpec> &specs,
+                           const Node &node, const PinMap &pins, const char *direction, bool check_types)
+        {
+            auto fail = [&](const std::string &reason)
+            {
+                throw std::runtime_error("ExecutionPlan: node '" + node.name.str() + "' does not match its kernel: " +
+                                         direction + " " + reason);
+            };
+            if (bindings.size() != specs.size())
+                fail("count is " + std::to_string(bindings.size()) + ", expected " + std::to_string(specs.size()));
+
+            for (size_t i = 0; i < specs.size(); ++i)
+            {
+                size_t found = i;
+                while (found < bindings.size() && bindings[found].pinName != specs[i].name)
+                    ++found;
+                if (found == bindings.size())
+                    fail("'" + specs[i].name.str() + "' is missing");
+                if (check_types && FindPinType(pins, specs[i].name) != specs[i].type)
+                    fail("'" + specs[i].name.str() + "' has the wrong type");
+                std::swap(bindings[i], bindings[found]);
+            }
+        }
+    } // namespace
+
+    ExecutionPlan BuildExecutionPlan(const GraphSnapshot &snapshot, const KernelRegistry &registry,
+                                     const ExecutionRequest &request)
+    {
+        // Index the snapshot once: snapshot node order, pin -> owning node, input pin -> source pins
+        std::vector<std::shared_ptr<const Node>> graph_nodes;
+        graph_nodes.reserve(snapshot.nodes.size());
+        std::unordered_map<UUID, size_t> pin_owner;
+        for (const auto &node : snapshot.nodes)
+        {
+            if (!node)
+                continue;
+            const size_t index = graph_nodes.size();
+            graph_nodes.push_back(node);
+            for (const auto &pair : node->inputPins)
+                pin_owner[pair.first] = index;
+            for (const auto &pair : node->outputPins)
+                pin_owner[pair.first] = index;
+        }
+
+        std::unordered_map<UUID, std::vector<UUID>> incoming;
+        for (const auto &link : snapshot.links)
+        {
+            if (link && pin_owner.count(link->startPinID) && pin_owner.count(link->endPinID))
+                incoming[link->endPinID].push_back(link->startPinID);
+        }
+
+        // Collect the required nodes by walking backwards from the roots
+        std::vector<char> required(graph_nodes.size(), 0);
+        std::vector<size_t> stack;
+        auto require = [&](size_t index)
+        {
+            if (!required[index])
+            {
+                required[index] = 1;
+                stack.push_back(index);
+            }
+        };
+
+        if (request.targetPins.empty())
+        {
+            for (size_t i = 0; i < graph_nodes.size(); ++i)
+                require(i);
+        }
+        for (const auto &pin_id : request.targetPins)
+        {
+            auto it = pin_owner.find(pin_id);
+            if (it == pin_owner.end())
+                throw std::runtime_error("ExecutionPlan: target pin " + pin_id.to_string() + " not found");
+            // For an input pin, the owner itself need not run, only whatever feeds the pin
+            if (graph_nodes[it->second]->GetOutputPin(pin_id))
+                require(it->second);
+            else
+            {
+                auto src = incoming.find(pin_id);
+                if (src != incoming.end())
+                {
+                    for (const auto &src_pin : src->second)
+                        require(pin_owner[src_pin]);
+                }
+            }
+        }
+        if (request.includeSideEffects)
+        {
+            for (size_t i = 0; i < graph_nodes.size(); ++i)
+            {
+                const KernelInfo *kernel = registry.Find(graph_nodes[i]->name);
+                if (kernel && kernel->sideEffects)
+                    require(i);
+            }
+        }
+
+        while (!stack.empty())
+        {
+            const size_t index = stack.back();
+            stack.pop_back();
+            for (const auto &pair : graph_nodes[index]->inputPins)
+            {
+                auto src = incoming.find(pair.first);
+                if (src == incoming.end())
+                    continue;
+                for (const auto &src_pin : src->second)
+                    require(pin_owner[src_pin]);
+            }
+        }
+
+        // Dependency edges between required nodes (graph index space)
+        std::vector<std::vector<size_t>> graph_dependents(graph_nodes.size());
+        std::vector<size_t> pending(graph_nodes.size(), 0);
+        for (size_t i = 0; i < graph_nodes.size(); ++i)
+        {
+            if (!required[i])
+                continue;
+            std::unordered_set<size_t> upstream;
+            for (const auto &pair : graph_nodes[i]->inputPins)
+            {
+                auto src = incoming.find(pair.first);
+                if (src == incoming.end())
+                    continue;
+                for (const auto &src_pin : src->second)
+                    upstream.insert(pin_owner[src_pin]);
+            }
+            upstream.erase(i); // A self-link cannot be satisfied; treated as unconnected
+            for (size_t up : upstream)
+            {
+                graph_dependents[up].push_back(i);
+                ++pending[i];
+            }
+        }
+
+        // Kahn's algorithm; ties keep snapshot order so plans are deterministic
+        std::vector<size_t> order;
+        std::vector<size_t> plan_index(graph_nodes.size(), PlannedNode::kNoSlot);
+        std::vector<size_t> remaining = pending;
+        for (size_t i = 0; i < graph_nodes.size(); ++i)
+        {
+            if (required[i] && remaining[i] == 0)
+                order.push_back(i);
+        }
+        for (size_t head = 0; head < order.size(); ++head)
+        {
+            plan_index[order[head]] = head;
+            for (size_t down : graph_dependents[order[head]])
+            {
+                if (--remaining[down] == 0)
+                    order.push_back(down);
+            }
+        }
+
+        size_t required_count = 0;
+        for (char r : required)
+            required_count += r ? 1 : 0;
+        if (order.size() != required_count)
+            throw std::runtime_error("ExecutionPlan: graph '" + snapshot.name + "' contains a cycle");
+
+        // Assign value slots to data outputs and bind inputs
+        ExecutionPlan plan;
+        plan.graphVersion = snapshot.version;
+        plan.nodes.resize(order.size());
+        std::unordered_map<UUID, size_t> output_slots;
+        std::vector<ValueKind> slot_kinds; // What each slot is expected to hold
+        for (size_t p = 0; p < order.size(); ++p)
+        {
+            PlannedNode &planned = plan.nodes[p];
+            planned.node = graph_nodes[order[p]];
+            planned.reportID = planned.node->id;
+            planned.reportName = planned.node->name;
+            planned.kernel = registry.Find(planned.node->name);
+            planned.dependencyCount = pending[order[p]];
+            for (size_t down : graph_dependents[order[p]])
+                planned.dependents.push_back(plan_index[down]);
+
+            for (const auto &pair : planned.node->outputPins)
+            {
+                if (pair.second->type == PinType::Exec)
+                    continue;
+                const size_t slot = plan.slotCount++;
+                planned.outputs.push_back({pair.second->name, pair.first, slot});
+                output_slots[pair.first] = slot;
+                slot_kinds.push_back(GetValueKind(pair.second->type));
+            }
+        }
+        for (auto &planned : plan.nodes)
+        {
+            for (const auto &pair : planned.node->inputPins)
+            {
+                if (pair.second->type == PinType::Exec)
+                    continue;
+                PlannedNode::InputBinding binding;
+                binding.pinName = pair.second->name;
+                auto src = incoming.find(pair.first);
+                if (src != incoming.end())
+                {
+                    auto slot = output_slots.find(src->second.front());
+                    if (slot != output_slots.end())
+                        binding.slot = slot->second;
+                }
+                planned.inputs.push_back(std::move(binding));
+            }
+
+            if (planned.kernel && planned.kernel->signature)
+            {
+                // An operator's pin types only say which operands it usually takes; the kinds actually
+                // connected are checked against its table below instead
+                const KernelSignature &signature = *planned.kernel->signature;
+                const bool check_types = !planned.kernel->binaryOperator;
+                OrderBindings(planned.inputs, signature.inputs, *planned.node, planned.node->inputPins, "input",
+                              check_types);
+                OrderBindings(planned.outputs, signature.outputs, *planned.node, planned.node->outputPins, "output",
+                              check_types);
+            }
+
+            // Resolve operators for the kinds of their operands, once; plan order is topological, so
+            // an operator's result kind is known before its consumers are visited. Operands of
+            // kinds only known at run time leave the lookup to the kernel, and so does its result.
+            if (planned.kernel && planned.kernel->binaryOperator && planned.inputs.size() == 2 &&
+                planned.outputs.size() == 1)
+            {
+                const size_t a_slot = planned.inputs[0].slot;
+                const size_t b_slot = planned.inputs[1].slot;
+                const ValueKind a = a_slot != PlannedNode::kNoSlot ? slot_kinds[a_slot] : ValueKind::Empty;
+                const ValueKind b = b_slot != PlannedNode::kNoSlot ? slot_kinds[b_slot] : ValueKind::Empty;
+                const BinaryOperatorEntry &entry = planned.kernel->binaryOperator->Find(a, b);
+                if (!entry.apply && IsStaticKind(a) && IsStaticKind(b))
+                    throw std::runtime_error("ExecutionPlan: node '" + planned.node->name.str() +
+                                             "': Unsupported operands: " + GetValueKindName(a) + " and " +
+                                             GetValueKindName(b));
+                planned.binaryOperator = entry.apply;
+                slot_kinds[planned.outputs[0].slot] = entry.apply ? entry.result : ValueKind::Empty;
+            }
+        }
+
+        for (const auto &pin_id : request.targetPins)
+        {
+            auto slot = output_slots.find(pin_id);
+            if (slot == output_slots.end())
+            {
+                auto src = incoming.find(pin_id);
+                if (src != incoming.end())
+                    slot = output_slots.find(src->second.front());
+            }
+            if (slot != output_slots.end())
+                plan.targetSlots[pin_id] = slot->second;
+        }
+        return plan;
+    }
+
+} // namespace MindWeaver
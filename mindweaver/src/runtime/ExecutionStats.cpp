@@ -0,0 +1,305 @@
+#include "runtime/ExecutionStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        uint64_t GetThreadCpuTimeNs()
+        {
+#ifdef _WIN32
+            FILETIME creation, exit, kernel, user;
+            if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+                return 0;
+            auto ticks = [](const FILETIME &time)
+            { return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime; };
+            return (ticks(kernel) + ticks(user)) * 100; // 100 ns ticks
+#else
+            timespec now;
+            if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0)
+                return 0;
+            return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+#endif
+        }
+
+        void AppendCSVField(std::string &out, const std::string &text)
+        {
+            if (text.find_first_of(",\"\n\r") == std::string::npos)
+            {
+                out += text;
+                return;
+            }
+            out += '"';
+            for (char c : text)
+            {
+                if (c == '"')
+                    out += '"';
+                out += c;
+            }
+            out += '"';
+        }
+
+        void AppendJSONString(std::string &out, const std::string &text)
+        {
+            out += '"';
+            for (char c : text)
+            {
+                switch (c)
+                {
+                case '"':
+                    out += "\\\"";
+                    break;
+                case '\\':
+                    out += "\\\\";
+                    break;
+                case '\n':
+                    out += "\\n";
+                    break;
+                case '\r':
+                    out += "\\r";
+                    break;
+                case '\t':
+                    out += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        out += escaped;
+                    }
+                    else
+                        out += c;
+                }
+            }
+            out += '"';
+        }
+    } // namespace
+
+    const char *GetNodeMetricName(NodeMetric metric)
+    {
+        switch (metric)
+        {
+        case NodeMetric::WallTime:
+            return "Wall time";
+        case NodeMetric::CpuTime:
+            return "CPU time";
+        case NodeMetric::BytesAllocated:
+            return "Bytes allocated";
+        case NodeMetric::CacheHits:
+            return "Cache hits";
+        case NodeMetric::Calls:
+            return "Calls";
+        }
+        return "Unknown";
+    }
+
+    // ---- NodeSampler ----
+
+    NodeSampler::NodeSampler()
+        : m_WallStart(std::chrono::steady_clock::now()), m_CpuStart(GetThreadCpuTimeNs()),
+          m_CountersStart(GetThreadCounters())
+    {
+    }
+
+    NodeSample NodeSampler::Stop(uint32_t plan_index, uint32_t thread) const
+    {
+        const auto wall_end = std::chrono::steady_clock::now();
+        const uint64_t cpu_end = GetThreadCpuTimeNs();
+        const ThreadCounters &counters = GetThreadCounters();
+
+        NodeSample sample;
+        sample.planIndex = plan_index;
+        sample.thread = thread;
+        sample.wallNs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wall_end - m_WallStart).count());
+        sample.cpuNs = cpu_end >= m_CpuStart ? cpu_end - m_CpuStart : 0;
+        sample.bytesAllocated = counters.bytesAllocated - m_CountersStart.bytesAllocated;
+        sample.cacheHits = counters.cacheHits - m_CountersStart.cacheHits;
+        return sample;
+    }
+
+    // ---- NodeStats ----
+
+    double NodeStats::Get(NodeMetric metric) const
+    {
+        switch (metric)
+        {
+        case NodeMetric::WallTime:
+            return static_cast<double>(wallNs);
+        case NodeMetric::CpuTime:
+            return static_cast<double>(cpuNs);
+        case NodeMetric::BytesAllocated:
+            return static_cast<double>(bytesAllocated);
+        case NodeMetric::CacheHits:
+            return static_cast<double>(cacheHits);
+        case NodeMetric::Calls:
+            return static_cast<double>(calls);
+        }
+        return 0.0;
+    }
+
+    // ---- ExecutionStats ----
+
+    void ExecutionStats::Add(const UUID &node_id, Symbol node_name, const NodeSample &sample)
+    {
+        AddToNode(node_id, node_name, sample);
+
+        if (m_Threads.size() <= sample.thread)
+            m_Threads.resize(sample.thread + 1);
+        ThreadStats &thread = m_Threads[sample.thread];
+        ++thread.calls;
+        thread.wallNs += sample.wallNs;
+        thread.cpuNs += sample.cpuNs;
+    }
+
+    void ExecutionStats::AddToNode(const UUID &node_id, Symbol node_name, const NodeSample &sample)
+    {
+        NodeStats &node = m_Nodes[node_id];
+        node.name = node_name;
+        ++node.calls;
+        node.wallNs += sample.wallNs;
+        node.maxWallNs = std::max(node.maxWallNs, sample.wallNs);
+        node.cpuNs += sample.cpuNs;
+        node.bytesAllocated += sample.bytesAllocated;
+        node.cacheHits += sample.cacheHits;
+    }
+
+    void ExecutionStats::Merge(const ExecutionStats &other)
+    {
+        for (const auto &pair : other.m_Nodes)
+        {
+            NodeStats &node = m_Nodes[pair.first];
+            node.name = pair.second.name;
+            node.calls += pair.second.calls;
+            node.wallNs += pair.second.wallNs;
+            node.maxWallNs = std::max(node.maxWallNs, pair.second.maxWallNs);
+            node.cpuNs += pair.second.cpuNs;
+            node.bytesAllocated += pair.second.bytesAllocated;
+            node.cacheHits += pair.second.cacheHits;
+        }
+        if (m_Threads.size() < other.m_Threads.size())
+            m_Threads.resize(other.m_Threads.size());
+        for (size_t i = 0; i < other.m_Threads.size(); ++i)
+        {
+            m_Threads[i].calls += other.m_Threads[i].calls;
+            m_Threads[i].wallNs += other.m_Threads[i].wallNs;
+            m_Threads[i].cpuNs += other.m_Threads[i].cpuNs;
+        }
+        m_RunCount += other.m_RunCount;
+    }
+
+    void ExecutionStats::Clear()
+    {
+        m_Nodes.clear();
+        m_Threads.clear();
+        m_RunCount = 0;
+    }
+
+    const NodeStats *ExecutionStats::Find(const UUID &node_id) const
+    {
+        auto it = m_Nodes.find(node_id);
+        return it != m_Nodes.end() ? &it->second : nullptr;
+    }
+
+    double ExecutionStats::GetMax(NodeMetric metric) const
+    {
+        double max_value = 0.0;
+        for (const auto &pair : m_Nodes)
+            max_value = std::max(max_value, pair.second.Get(metric));
+        return max_value;
+    }
+
+    std::vector<std::pair<UUID, const NodeStats *>> ExecutionStats::SortedByWallTime() const
+    {
+        std::vector<std::pair<UUID, const NodeStats *>> sorted;
+        sorted.reserve(m_Nodes.size());
+        for (const auto &pair : m_Nodes)
+            sorted.emplace_back(pair.first, &pair.second);
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const auto &a, const auto &b)
+                  {
+                      if (a.second->wallNs != b.second->wallNs)
+                          return a.second->wallNs > b.second->wallNs;
+                      return a.first < b.first; // Stable across runs
+                  });
+        return sorted;
+    }
+
+    std::string ExecutionStats::ToCSV() const
+    {
+        std::string out = "node_id,name,calls,wall_ns,max_wall_ns,cpu_ns,bytes_allocated,cache_hits\n";
+        for (const auto &pair : SortedByWallTime())
+        {
+            const NodeStats &node = *pair.second;
+            out += pair.first.to_string();
+            out += ',';
+            AppendCSVField(out, node.name.str());
+            for (uint64_t value : {node.calls, node.wallNs, node.maxWallNs, node.cpuNs, node.bytesAllocated, node.cacheHits})
+            {
+                out += ',';
+                out += std::to_string(value);
+            }
+            out += '\n';
+        }
+        return out;
+    }
+
+    std::string ExecutionStats::ToJSON() const
+    {
+        std::string out = "{\n  \"runs\": " + std::to_string(m_RunCount) + ",\n  \"nodes\": [";
+        bool first = true;
+        for (const auto &pair : SortedByWallTime())
+        {
+            const NodeStats &node = *pair.second;
+            out += first ? "\n    {\"id\": " : ",\n    {\"id\": ";
+            first = false;
+            AppendJSONString(out, pair.first.to_string());
+            out += ", \"name\": ";
+            AppendJSONString(out, node.name.str());
+            out += ", \"calls\": " + std::to_string(node.calls);
+            out += ", \"wall_ns\": " + std::to_string(node.wallNs);
+            out += ", \"max_wall_ns\": " + std::to_string(node.maxWallNs);
+            out += ", \"cpu_ns\": " + std::to_string(node.cpuNs);
+            out += ", \"bytes_allocated\": " + std::to_string(node.bytesAllocated);
+            out += ", \"cache_hits\": " + std::to_string(node.cacheHits) + "}";
+        }
+        out += m_Nodes.empty() ? "],\n  \"threads\": [" : "\n  ],\n  \"threads\": [";
+        for (size_t i = 0; i < m_Threads.size(); ++i)
+        {
+            const ThreadStats &thread = m_Threads[i];
+            out += i == 0 ? "\n    " : ",\n    ";
+            out += "{\"thread\": " + std::to_string(i) + ", \"calls\": " + std::to_string(thread.calls) +
+                   ", \"wall_ns\": " + std::to_string(thread.wallNs) + ", \"cpu_ns\": " + std::to_string(thread.cpuNs) +
+                   "}";
+        }
+        out += m_Threads.empty() ? "]\n}\n" : "\n  ]\n}\n";
+        return out;
+    }
+
+    void ExecutionStats::Save(const std::string &path) const
+    {
+        const bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+        const std::string text = json ? ToJSON() : ToCSV();
+        FILE *file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            throw std::runtime_error("Cannot write execution stats to '" + path + "'");
+        const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+        if (std::fclose(file) != 0 || !written)
+            throw std::runtime_error("Failed to write execution stats to '" + path + "'");
+    }
+
+} // namespace MindWeaver
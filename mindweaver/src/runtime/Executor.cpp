@@ -0,0 +1,400 @@
+#include "runtime/Executor.h"
+
+#include "runtime/ExecutionEvents.h"
+#include "runtime/GraphOptimizer.h"
+#include "runtime/ResourceCache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace MindWeaver
+{
+
+    // ---- ExecutionContext ----
+
+    const Node &ExecutionContext::GetNode() const { return *m_Plan.nodes[m_PlanIndex].node; }
+
+    std::string ExecutionContext::GetParameter(const std::string &param_name, const std::string &fallback) const
+    {
+        const auto &parameters = GetNode().parameters;
+        auto it = parameters.find(param_name);
+        return (it != parameters.end()) ? it->second : fallback;
+    }
+
+    bool ExecutionContext::HasInput(Symbol pin_name) const
+    {
+        for (const auto &binding : m_Plan.nodes[m_PlanIndex].inputs)
+        {
+            if (binding.pinName == pin_name)
+                return binding.slot != PlannedNode::kNoSlot && m_Values[binding.slot].HasValue();
+        }
+        return false;
+    }
+
+    const Value &ExecutionContext::GetInput(Symbol pin_name) const
+    {
+        for (const auto &binding : m_Plan.nodes[m_PlanIndex].inputs)
+        {
+            if (binding.pinName != pin_name)
+                continue;
+            if (binding.slot == PlannedNode::kNoSlot || !m_Values[binding.slot].HasValue())
+                throw std::runtime_error("Input '" + pin_name.str() + "' of '" + GetNode().name.str() +
+                                         "' is not connected");
+            return m_Values[binding.slot];
+        }
+        throw std::runtime_error("Node '" + GetNode().name.str() + "' has no input named '" + pin_name.str() + "'");
+    }
+
+    void ExecutionContext::SetOutput(Symbol pin_name, Value value)
+    {
+        for (const auto &binding : m_Plan.nodes[m_PlanIndex].outputs)
+        {
+            if (binding.pinName == pin_name)
+            {
+                m_Values[binding.slot] = std::move(value);
+                return;
+            }
+        }
+        throw std::runtime_error("Node '" + GetNode().name.str() + "' has no output named '" + pin_name.str() + "'");
+    }
+
+    const Value *ExecutionContext::FindInputAt(size_t index) const
+    {
+        const size_t slot = m_Plan.nodes[m_PlanIndex].inputs[index].slot;
+        return (slot != PlannedNode::kNoSlot && m_Values[slot].HasValue()) ? &m_Values[slot] : nullptr;
+    }
+
+    const Value &ExecutionContext::GetInputAt(size_t index) const
+    {
+        if (const Value *value = FindInputAt(index))
+            return *value;
+        throw std::runtime_error("Input '" + m_Plan.nodes[m_PlanIndex].inputs[index].pinName.str() + "' of '" +
+                                 GetNode().name.str() + "' is not connected");
+    }
+
+    void ExecutionContext::SetOutputAt(size_t index, Value value)
+    {
+        m_Values[m_Plan.nodes[m_PlanIndex].outputs[index].slot] = std::move(value);
+    }
+
+    void ExecutionContext::ReportProgress(float progress)
+    {
+        if (m_Events)
+            m_Events->PostProgress(m_Plan.nodes[m_PlanIndex].reportID, progress);
+    }
+
+    void ExecutionContext::ReportPreview(std::string preview)
+    {
+        if (m_Events)
+            m_Events->PostPreview(m_Plan.nodes[m_PlanIndex].reportID, std::move(preview));
+    }
+
+    ResourceCache &ExecutionContext::GetResourceCache() const
+    {
+        return m_Resources ? *m_Resources : ResourceCache::Instance();
+    }
+
+    void RecordSample(ExecutionStats &stats, const PlannedNode &planned, const NodeSample &sample)
+    {
+        stats.Add(planned.reportID, planned.reportName, sample);
+        for (const auto &merged : planned.mergedReports)
+            stats.AddToNode(merged.first, merged.second, sample);
+    }
+
+    // ---- NodeStatusReporter ----
+
+    NodeStatusReporter::NodeStatusReporter(ExecutionEventChannel *events, const ExecutionPlan &plan)
+        : m_Events(events), m_GroupOf(plan.nodes.size())
+    {
+        std::unordered_map<UUID, size_t> groups;
+        for (size_t i = 0; i < plan.nodes.size(); ++i)
+            m_GroupOf[i] = groups.emplace(plan.nodes[i].reportID, groups.size()).first->second;
+        m_GroupCount = groups.size();
+        m_Groups.reset(new Group[m_GroupCount]);
+        for (const auto &pair : groups)
+            m_Groups[pair.second].id = pair.first;
+        for (size_t group : m_GroupOf)
+            ++m_Groups[group].size;
+    }
+
+    void NodeStatusReporter::Queued()
+    {
+        if (!m_Events)
+            return;
+        for (size_t g = 0; g < m_GroupCount; ++g)
+            m_Events->PostStatus(m_Groups[g].id, NodeStatus::Queued);
+    }
+
+    void NodeStatusReporter::Started(size_t plan_index)
+    {
+        Group &group = m_Groups[m_GroupOf[plan_index]];
+        if (group.started.fetch_add(1, std::memory_order_relaxed) == 0 && m_Events)
+            m_Events->PostStatus(group.id, NodeStatus::Running);
+    }
+
+    void NodeStatusReporter::Finished(size_t plan_index, const std::string &error)
+    {
+        Group &group = m_Groups[m_GroupOf[plan_index]];
+        if (!error.empty())
+        {
+            if (!group.failed.exchange(true) && m_Events)
+                m_Events->PostStatus(group.id, NodeStatus::Error, error);
+            return;
+        }
+        if (group.finished.fetch_add(1) + 1 == group.size && !group.failed.load() && m_Events)
+            m_Events->PostStatus(group.id, NodeStatus::Done);
+    }
+
+    void NodeStatusReporter::Stopped()
+    {
+        if (!m_Events)
+            return;
+        for (size_t g = 0; g < m_GroupCount; ++g)
+        {
+            const Group &group = m_Groups[g];
+            if (!group.failed.load() && group.finished.load() < group.size)
+                m_Events->PostStatus(group.id, NodeStatus::Idle); // Never ran (completely)
+        }
+    }
+
+    // ---- Executor ----
+
+    Executor::Executor(std::shared_ptr<const KernelRegistry> registry, size_t worker_count)
+        : m_Registry(std::move(registry)), m_WorkerCount(worker_count)
+    {
+        if (!m_Registry)
+            throw std::invalid_argument("Executor requires a kernel registry");
+        if (m_WorkerCount == 0)
+            m_WorkerCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    void Executor::SetEventChannel(std::shared_ptr<ExecutionEventChannel> channel) { m_Events = channel; }
+
+    void Executor::SetInterpreterLock(std::shared_ptr<InterpreterLock> lock) { m_InterpreterLock = lock; }
+
+    void Executor::SetResourceCache(std::shared_ptr<ResourceCache> cache) { m_Resources = std::move(cache); }
+
+    ExecutionPlan Executor::Prepare(const GraphSnapshot &snapshot, const ExecutionRequest &request) const
+    {
+        return PrepareExecutionPlan(snapshot, *m_Registry, request);
+    }
+
+    ExecutionResult Executor::Run(const GraphSnapshot &snapshot, const ExecutionRequest &request)
+    {
+        ExecutionPlan plan;
+        try
+        {
+            plan = Prepare(snapshot, request);
+        }
+        catch (const std::exception &e)
+        {
+            ExecutionResult result;
+            result.success = false;
+            result.error = e.what();
+            return result;
+        }
+        return Run(plan);
+    }
+
+    std::future<ExecutionResult> Executor::RunAsync(GraphSnapshot snapshot, ExecutionRequest request)
+    {
+        return std::async(std::launch::async, [this, snapshot = std::move(snapshot), request = std::move(request)]
+                          { return Run(snapshot, request); });
+    }
+
+    ExecutionResult Executor::Run(const ExecutionPlan &plan)
+    {
+        ExecutionResult result;
+        const size_t total = plan.nodes.size();
+        ExecutionEventChannel *events = m_Events.get();
+        InterpreterLock *interpreter_lock = m_InterpreterLock.get();
+        ResourceCache *resources = m_Resources.get();
+        const bool collect_stats = m_CollectStats;
+
+        auto needs_interpreter = [&](size_t index)
+        {
+            const KernelInfo *kernel = plan.nodes[index].kernel;
+            return kernel && kernel->affinity == ExecutionAffinity::Interpreter;
+        };
+
+        std::vector<Value> values(plan.slotCount);
+        std::vector<size_t> pending(total);
+        std::vector<NodeStatus> outcome(total, NodeStatus::Queued);
+        std::deque<size_t> ready;             // Native nodes, any worker
+        std::deque<size_t> ready_interpreter; // Interpreter nodes, one worker at a time
+        for (size_t i = 0; i < total; ++i)
+        {
+            pending[i] = plan.nodes[i].dependencyCount;
+            if (pending[i] == 0)
+                (needs_interpreter(i) ? ready_interpreter : ready).push_back(i);
+        }
+        NodeStatusReporter status(events, plan);
+        status.Queued();
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t completed = 0;
+        bool failed = false;
+        bool interpreter_busy = false;
+
+        // One sample buffer per worker thread (on its own cache line), written without locking and
+        // merged after the run
+        struct alignas(64) SampleBuffer
+        {
+            std::vector<NodeSample> samples;
+        };
+        const size_t thread_count = std::min(m_WorkerCount, total);
+        std::vector<SampleBuffer> samples(collect_stats ? thread_count : 0);
+        for (auto &buffer : samples)
+            buffer.samples.reserve(total / thread_count + 1);
+
+        // Runs one node outside the scheduler lock; returns the error message (empty on success)
+        auto execute = [&](size_t index, size_t thread)
+        {
+            const PlannedNode &planned = plan.nodes[index];
+            std::string error;
+            status.Started(index);
+            std::optional<NodeSampler> sampler;
+            if (collect_stats)
+                sampler.emplace();
+            try
+            {
+                if (planned.binaryOperator)
+                    planned.binaryOperator(values[planned.inputs[0].slot], values[planned.inputs[1].slot],
+                                           values[planned.outputs[0].slot]);
+                else if (planned.kernel && planned.kernel->kernel)
+                {
+                    ExecutionContext context(plan, index, values, events, resources);
+                    planned.kernel->kernel(context);
+                }
+            }
+            catch (const std::exception &e)
+            {
+                error = e.what();
+                if (error.empty())
+                    error = "unknown error";
+            }
+            catch (...)
+            {
+                error = "unknown error";
+            }
+            if (sampler)
+                samples[thread].samples.push_back(
+                    sampler->Stop(static_cast<uint32_t>(index), static_cast<uint32_t>(thread)));
+            status.Finished(index, error);
+            return error;
+        };
+
+        // Records a finished node and releases its dependents. Caller holds mutex.
+        auto complete = [&](size_t index, const std::string &error)
+        {
+            ++completed;
+            outcome[index] = error.empty() ? NodeStatus::Done : NodeStatus::Error;
+            if (!error.empty())
+            {
+                if (!failed)
+                    result.error = "'" + plan.nodes[index].node->name.str() + "': " + error;
+                failed = true;
+                return;
+            }
+            for (size_t down : plan.nodes[index].dependents)
+            {
+                if (--pending[down] == 0)
+                    (needs_interpreter(down) ? ready_interpreter : ready).push_back(down);
+            }
+        };
+
+        auto worker = [&](size_t thread)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true)
+            {
+                cv.wait(lock,
+                        [&]
+                        {
+                            return failed || completed == total || !ready.empty() ||
+                                   (!ready_interpreter.empty() && !interpreter_busy);
+                        });
+                if (failed || completed == total)
+                    return;
+
+                if (!ready_interpreter.empty() && !interpreter_busy)
+                {
+                    // Drain interpreter nodes as one batch under a single lock acquisition,
+                    // including any that become ready while the batch runs
+                    interpreter_busy = true;
+                    lock.unlock();
+                    if (interpreter_lock)
+                        interpreter_lock->Acquire();
+                    lock.lock();
+                    while (!failed && !ready_interpreter.empty())
+                    {
+                        const size_t index = ready_interpreter.front();
+                        ready_interpreter.pop_front();
+                        lock.unlock();
+                        const std::string error = execute(index, thread);
+                        lock.lock();
+                        complete(index, error);
+                        cv.notify_all(); // Native dependents can start right away
+                    }
+                    lock.unlock();
+                    if (interpreter_lock)
+                        interpreter_lock->Release();
+                    lock.lock();
+                    interpreter_busy = false;
+                    cv.notify_all();
+                    continue;
+                }
+
+                const size_t index = ready.front();
+                ready.pop_front();
+                lock.unlock();
+                const std::string error = execute(index, thread);
+                lock.lock();
+                complete(index, error);
+                cv.notify_all();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < thread_count; ++t)
+            threads.emplace_back(worker, t);
+        if (total > 0)
+            worker(0); // The calling thread works too
+        for (auto &thread : threads)
+            thread.join();
+
+        result.success = !failed;
+        for (size_t i = 0; i < total; ++i)
+        {
+            if (outcome[i] == NodeStatus::Done)
+                ++result.nodesExecuted;
+        }
+        status.Stopped();
+        for (const auto &pair : plan.targetSlots)
+        {
+            if (values[pair.second].HasValue())
+                result.outputs[pair.first] = values[pair.second];
+        }
+        if (collect_stats)
+        {
+            result.stats.Reserve(total);
+            for (const auto &buffer : samples)
+            {
+                for (const NodeSample &sample : buffer.samples)
+                    RecordSample(result.stats, plan.nodes[sample.planIndex], sample);
+            }
+            result.stats.SetRunCount(1);
+        }
+        return result;
+    }
+
+} // namespace MindWeaver
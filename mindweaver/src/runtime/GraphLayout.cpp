@@ -0,0 +1,562 @@
+#include "runtime/GraphLayout.h"
+
+#include "core/Graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        // Virtual nodes allowed per real node for links spanning several layers; beyond that budget
+        // the longest links are left out of crossing reduction (they are still drawn, just not routed)
+        constexpr size_t kMaxVirtualNodesPerNode = 8;
+
+        // Vertical room taken by a virtual node, relative to LayoutOptions::nodeSpacing
+        constexpr float kVirtualNodeHeight = 0.25f;
+
+        // Alternating down/up passes aligning nodes with their neighbors
+        constexpr size_t kAlignmentPasses = 4;
+
+        /// @brief Runs fn(begin, end) over chunks of [0, count) on up to thread_count threads, the
+        /// caller included, and rethrows the first exception thrown by fn.
+        template <typename Fn> void ParallelFor(size_t count, size_t thread_count, size_t chunk, const Fn &fn)
+        {
+            std::atomic<size_t> next{0};
+            std::exception_ptr error;
+            std::mutex error_mutex;
+            auto worker = [&]
+            {
+                try
+                {
+                    for (size_t begin = next.fetch_add(chunk); begin < count; begin = next.fetch_add(chunk))
+                        fn(begin, std::min(begin + chunk, count));
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                        error = std::current_exception();
+                    next.store(count); // Stop handing out work
+                }
+            };
+
+            const size_t threads = std::min(thread_count, (count + chunk - 1) / chunk);
+            std::vector<std::thread> pool;
+            for (size_t t = 1; t < threads; ++t)
+                pool.emplace_back(worker);
+            worker();
+            for (auto &thread : pool)
+                thread.join();
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        using Edge = std::pair<uint32_t, uint32_t>; // Source -> target
+
+        /// @brief A weakly connected component, its edges in local node indices.
+        struct Component
+        {
+            std::vector<uint32_t> nodes; // Indices into the laid out nodes
+            std::vector<Edge> edges;
+        };
+
+        /// @brief Positions of a component's nodes, with its top-left corner at (0, 0).
+        struct ComponentLayout
+        {
+            std::vector<Position> positions; // Per local node
+            float width = 0.0f;
+            float height = 0.0f;
+            size_t layerCount = 0;
+        };
+
+        /// @brief Reverses the DFS back edges of a graph of n nodes so it becomes acyclic.
+        /// Searches start from the sources, then from the remaining nodes left to right.
+        std::vector<Edge> BreakCycles(uint32_t n, const std::vector<Edge> &edges, const std::vector<float> &current_x)
+        {
+            std::vector<std::vector<uint32_t>> out(n);
+            std::vector<uint32_t> indegree(n, 0);
+            for (const Edge &edge : edges)
+            {
+                out[edge.first].push_back(edge.second);
+                ++indegree[edge.second];
+            }
+
+            std::vector<uint32_t> roots(n);
+            std::iota(roots.begin(), roots.end(), 0u);
+            std::stable_sort(roots.begin(), roots.end(),
+                             [&](uint32_t a, uint32_t b)
+                             {
+                                 if ((indegree[a] == 0) != (indegree[b] == 0))
+                                     return indegree[a] == 0;
+                                 return current_x[a] < current_x[b];
+                             });
+
+            enum : uint8_t { kNew, kOnStack, kDone };
+            std::vector<uint8_t> state(n, kNew);
+            std::vector<Edge> acyclic;
+            acyclic.reserve(edges.size());
+            std::vector<std::pair<uint32_t, size_t>> stack; // Node, next out-edge to visit
+            for (uint32_t root : roots)
+            {
+                if (state[root] != kNew)
+                    continue;
+                state[root] = kOnStack;
+                stack.push_back({root, 0});
+                while (!stack.empty())
+                {
+                    const uint32_t u = stack.back().first;
+                    const size_t i = stack.back().second++;
+                    if (i == out[u].size())
+                    {
+                        state[u] = kDone;
+                        stack.pop_back();
+                        continue;
+                    }
+                    const uint32_t v = out[u][i];
+                    if (state[v] == kOnStack)
+                    {
+                        acyclic.push_back({v, u});
+                        continue;
+                    }
+                    acyclic.push_back({u, v});
+                    if (state[v] == kNew)
+                    {
+                        state[v] = kOnStack;
+                        stack.push_back({v, 0});
+                    }
+                }
+            }
+
+            std::sort(acyclic.begin(), acyclic.end());
+            acyclic.erase(std::unique(acyclic.begin(), acyclic.end()), acyclic.end());
+            return acyclic;
+        }
+
+        /// @brief Longest-path layering of a DAG; sources are then moved right to sit just before
+        /// their nearest successor, which shortens their links.
+        std::vector<uint32_t> AssignLayers(uint32_t n, const std::vector<Edge> &dag)
+        {
+            std::vector<std::vector<uint32_t>> successors(n);
+            std::vector<uint32_t> indegree(n, 0);
+            for (const Edge &edge : dag)
+            {
+                successors[edge.first].push_back(edge.second);
+                ++indegree[edge.second];
+            }
+
+            std::vector<uint32_t> layer(n, 0);
+            std::vector<uint32_t> order;
+            order.reserve(n);
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                if (indegree[v] == 0)
+                    order.push_back(v);
+            }
+            std::vector<uint32_t> remaining = indegree;
+            for (size_t head = 0; head < order.size(); ++head)
+            {
+                const uint32_t u = order[head];
+                for (uint32_t v : successors[u])
+                {
+                    layer[v] = std::max(layer[v], layer[u] + 1);
+                    if (--remaining[v] == 0)
+                        order.push_back(v);
+                }
+            }
+
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                if (indegree[v] != 0 || successors[v].empty())
+                    continue;
+                uint32_t nearest = layer[successors[v].front()];
+                for (uint32_t s : successors[v])
+                    nearest = std::min(nearest, layer[s]);
+                layer[v] = nearest - 1;
+            }
+
+            const uint32_t first = *std::min_element(layer.begin(), layer.end());
+            for (uint32_t &l : layer)
+                l -= first;
+            return layer;
+        }
+
+        /// @brief Sorts a layer by the mean rank of each node's neighbors in the adjacent layer
+        /// (nodes without neighbors keep their rank as key). Returns true if the order changed.
+        bool ReorderLayer(std::vector<uint32_t> &nodes, const std::vector<std::vector<uint32_t>> &neighbors,
+                          std::vector<uint32_t> &rank, std::vector<float> &key)
+        {
+            for (uint32_t v : nodes)
+            {
+                if (neighbors[v].empty())
+                {
+                    key[v] = static_cast<float>(rank[v]);
+                    continue;
+                }
+                float sum = 0.0f;
+                for (uint32_t w : neighbors[v])
+                    sum += static_cast<float>(rank[w]);
+                key[v] = sum / static_cast<float>(neighbors[v].size());
+            }
+
+            std::stable_sort(nodes.begin(), nodes.end(), [&](uint32_t a, uint32_t b) { return key[a] < key[b]; });
+            bool changed = false;
+            for (uint32_t i = 0; i < nodes.size(); ++i)
+            {
+                changed |= rank[nodes[i]] != i;
+                rank[nodes[i]] = i;
+            }
+            return changed;
+        }
+
+        ComponentLayout LayoutComponent(const Component &component, const std::vector<Position> &current,
+                                        const LayoutOptions &options)
+        {
+            const uint32_t n = static_cast<uint32_t>(component.nodes.size());
+            std::vector<float> current_x(n), current_y(n);
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                current_x[v] = current[component.nodes[v]].x;
+                current_y[v] = current[component.nodes[v]].y;
+            }
+
+            std::vector<Edge> dag = BreakCycles(n, component.edges, current_x);
+            const std::vector<uint32_t> real_layer = AssignLayers(n, dag);
+
+            // Layered graph: real nodes, then virtual nodes splitting links that span several layers.
+            // Short links are routed first so the budget goes to the links that matter most locally.
+            std::vector<uint32_t> layer = real_layer;
+            std::vector<float> initial_y = current_y;
+            std::vector<std::vector<uint32_t>> upper(n), lower(n);
+            auto connect = [&](uint32_t a, uint32_t b)
+            {
+                lower[a].push_back(b);
+                upper[b].push_back(a);
+            };
+            std::stable_sort(dag.begin(), dag.end(),
+                             [&](const Edge &a, const Edge &b)
+                             {
+                                 return real_layer[a.second] - real_layer[a.first] <
+                                        real_layer[b.second] - real_layer[b.first];
+                             });
+            size_t virtual_budget = kMaxVirtualNodesPerNode * n;
+            for (const Edge &edge : dag)
+            {
+                const uint32_t span = real_layer[edge.second] - real_layer[edge.first];
+                if (span == 1)
+                {
+                    connect(edge.first, edge.second);
+                    continue;
+                }
+                if (span - 1 > virtual_budget)
+                    continue;
+                virtual_budget -= span - 1;
+                uint32_t previous = edge.first;
+                for (uint32_t step = 1; step < span; ++step)
+                {
+                    const uint32_t v = static_cast<uint32_t>(layer.size());
+                    const float t = static_cast<float>(step) / static_cast<float>(span);
+                    layer.push_back(real_layer[edge.first] + step);
+                    initial_y.push_back(current_y[edge.first] + t * (current_y[edge.second] - current_y[edge.first]));
+                    upper.emplace_back();
+                    lower.emplace_back();
+                    connect(previous, v);
+                    previous = v;
+                }
+                connect(previous, edge.second);
+            }
+            const uint32_t total = static_cast<uint32_t>(layer.size());
+
+            // Starting order from the current positions, so tidy graphs stay recognizable
+            const uint32_t layer_count = *std::max_element(layer.begin(), layer.end()) + 1;
+            std::vector<std::vector<uint32_t>> layers(layer_count);
+            for (uint32_t v = 0; v < total; ++v)
+                layers[layer[v]].push_back(v);
+            std::vector<uint32_t> rank(total);
+            for (auto &nodes : layers)
+            {
+                std::stable_sort(nodes.begin(), nodes.end(),
+                                 [&](uint32_t a, uint32_t b) { return initial_y[a] < initial_y[b]; });
+                for (uint32_t i = 0; i < nodes.size(); ++i)
+                    rank[nodes[i]] = i;
+            }
+
+            // Crossing reduction: barycenter sweeps down then up until the order settles
+            std::vector<float> key(total);
+            for (size_t sweep = 0; sweep < options.orderingSweeps; ++sweep)
+            {
+                bool changed = false;
+                for (uint32_t l = 1; l < layer_count; ++l)
+                    changed |= ReorderLayer(layers[l], upper, rank, key);
+                for (uint32_t l = layer_count - 1; l-- > 0;)
+                    changed |= ReorderLayer(layers[l], lower, rank, key);
+                if (!changed)
+                    break;
+            }
+
+            // Vertical coordinates: stack each layer, then pull nodes toward their neighbors while
+            // keeping the layer's order and spacing
+            auto height = [&](uint32_t v) { return v < n ? options.nodeSpacing : options.nodeSpacing * kVirtualNodeHeight; };
+            std::vector<float> y(total, 0.0f);
+            for (const auto &nodes : layers)
+            {
+                float cursor = 0.0f;
+                for (size_t i = 0; i < nodes.size(); ++i)
+                {
+                    if (i > 0)
+                        cursor += 0.5f * (height(nodes[i - 1]) + height(nodes[i]));
+                    y[nodes[i]] = cursor;
+                }
+                for (uint32_t v : nodes)
+                    y[v] -= 0.5f * cursor; // Center the layer on 0
+            }
+
+            std::vector<float> desired(total);
+            for (size_t pass = 0; pass < kAlignmentPasses; ++pass)
+            {
+                const bool downward = pass % 2 == 0;
+                const auto &neighbors = downward ? upper : lower;
+                for (uint32_t step = 0; step < layer_count; ++step)
+                {
+                    const auto &nodes = layers[downward ? step : layer_count - 1 - step];
+                    if (nodes.empty())
+                        continue;
+                    float desired_sum = 0.0f, placed_sum = 0.0f;
+                    for (size_t i = 0; i < nodes.size(); ++i)
+                    {
+                        const uint32_t v = nodes[i];
+                        float target = y[v];
+                        if (!neighbors[v].empty())
+                        {
+                            target = 0.0f;
+                            for (uint32_t w : neighbors[v])
+                                target += y[w];
+                            target /= static_cast<float>(neighbors[v].size());
+                        }
+                        desired[v] = target;
+                        if (i > 0)
+                            target = std::max(target, y[nodes[i - 1]] + 0.5f * (height(nodes[i - 1]) + height(v)));
+                        y[v] = target;
+                        desired_sum += desired[v];
+                        placed_sum += target;
+                    }
+                    // Spacing only pushes nodes down; shift the layer back to balance it
+                    const float shift = (desired_sum - placed_sum) / static_cast<float>(nodes.size());
+                    for (uint32_t v : nodes)
+                        y[v] += shift;
+                }
+            }
+
+            ComponentLayout result;
+            result.layerCount = layer_count;
+            result.positions.resize(n);
+            float min_y = y[0], max_y = y[0];
+            uint32_t max_layer = 0;
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                min_y = std::min(min_y, y[v]);
+                max_y = std::max(max_y, y[v]);
+                max_layer = std::max(max_layer, layer[v]);
+            }
+            for (uint32_t v = 0; v < n; ++v)
+                result.positions[v] = Position(static_cast<float>(layer[v]) * options.layerSpacing, y[v] - min_y);
+            result.width = static_cast<float>(max_layer + 1) * options.layerSpacing;
+            result.height = max_y - min_y + options.nodeSpacing;
+            return result;
+        }
+
+        uint32_t FindRoot(std::vector<uint32_t> &parent, uint32_t v)
+        {
+            while (parent[v] != v)
+            {
+                parent[v] = parent[parent[v]];
+                v = parent[v];
+            }
+            return v;
+        }
+    } // namespace
+
+    GraphLayout ComputeGraphLayout(const GraphSnapshot &snapshot, const std::vector<UUID> &region,
+                                   const LayoutOptions &options)
+    {
+        GraphLayout result;
+        result.graphVersion = snapshot.version;
+        const size_t thread_count =
+            options.threadCount ? options.threadCount : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+        std::vector<std::shared_ptr<const Node>> nodes;
+        const std::unordered_set<UUID> wanted(region.begin(), region.end());
+        for (const auto &node : snapshot.nodes)
+        {
+            if (node && (wanted.empty() || wanted.count(node->id)))
+                nodes.push_back(node);
+        }
+        if (nodes.empty())
+            return result;
+        const uint32_t n = static_cast<uint32_t>(nodes.size());
+
+        // Placeholders only carry their position; their pins are needed to follow links
+        if (snapshot.nodeSource)
+        {
+            ParallelFor(nodes.size(), thread_count, 256,
+                        [&](size_t begin, size_t end)
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                                nodes[i] = snapshot.Resolve(nodes[i]);
+                        });
+        }
+
+        // Links become edges from the output side to the input side
+        struct PinOwner
+        {
+            uint32_t node;
+            bool input;
+        };
+        std::unordered_map<UUID, PinOwner> pin_owners;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            for (const auto &pair : nodes[i]->inputPins)
+                pin_owners.emplace(pair.first, PinOwner{i, true});
+            for (const auto &pair : nodes[i]->outputPins)
+                pin_owners.emplace(pair.first, PinOwner{i, false});
+        }
+        std::vector<Edge> edges;
+        for (const auto &link : snapshot.links)
+        {
+            if (!link)
+                continue;
+            auto start = pin_owners.find(link->startPinID);
+            auto end = pin_owners.find(link->endPinID);
+            if (start == pin_owners.end() || end == pin_owners.end() || start->second.node == end->second.node)
+                continue;
+            if (start->second.input && !end->second.input)
+                std::swap(start, end);
+            edges.push_back({start->second.node, end->second.node});
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        // Weakly connected components
+        std::vector<uint32_t> parent(n);
+        std::iota(parent.begin(), parent.end(), 0u);
+        for (const Edge &edge : edges)
+        {
+            const uint32_t a = FindRoot(parent, edge.first), b = FindRoot(parent, edge.second);
+            if (a != b)
+                parent[std::max(a, b)] = std::min(a, b);
+        }
+        std::vector<uint32_t> component_of(n), local(n);
+        std::vector<Component> components;
+        std::unordered_map<uint32_t, uint32_t> component_by_root;
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            auto inserted = component_by_root.emplace(FindRoot(parent, v), static_cast<uint32_t>(components.size()));
+            if (inserted.second)
+                components.emplace_back();
+            component_of[v] = inserted.first->second;
+            local[v] = static_cast<uint32_t>(components[component_of[v]].nodes.size());
+            components[component_of[v]].nodes.push_back(v);
+        }
+        for (const Edge &edge : edges)
+            components[component_of[edge.first]].edges.push_back({local[edge.first], local[edge.second]});
+        result.componentCount = components.size();
+
+        std::vector<Position> current(n);
+        Position origin = nodes[0]->position;
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            current[v] = nodes[v]->position;
+            origin.x = std::min(origin.x, current[v].x);
+            origin.y = std::min(origin.y, current[v].y);
+        }
+
+        // Connected parts are laid out in parallel, largest first so no worker is left with the
+        // biggest one at the end; single nodes are packed separately
+        std::vector<uint32_t> connected, singles;
+        for (uint32_t c = 0; c < components.size(); ++c)
+            (components[c].nodes.size() > 1 ? connected : singles).push_back(c);
+        std::stable_sort(connected.begin(), connected.end(),
+                         [&](uint32_t a, uint32_t b) { return components[a].nodes.size() > components[b].nodes.size(); });
+        std::vector<ComponentLayout> layouts(components.size());
+        ParallelFor(connected.size(), thread_count, 1,
+                    [&](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                            layouts[connected[i]] = LayoutComponent(components[connected[i]], current, options);
+                    });
+
+        // Stack the parts top to bottom in their current vertical order (largest first on ties)
+        auto top_of = [&](uint32_t c)
+        {
+            float top = current[components[c].nodes[0]].y;
+            for (uint32_t v : components[c].nodes)
+                top = std::min(top, current[v].y);
+            return top;
+        };
+        std::vector<float> tops(components.size());
+        for (uint32_t c : connected)
+            tops[c] = top_of(c);
+        std::stable_sort(connected.begin(), connected.end(), [&](uint32_t a, uint32_t b) { return tops[a] < tops[b]; });
+
+        result.positions.reserve(n);
+        float cursor_y = origin.y;
+        for (uint32_t c : connected)
+        {
+            const ComponentLayout &layout = layouts[c];
+            for (uint32_t v = 0; v < layout.positions.size(); ++v)
+            {
+                const Position &p = layout.positions[v];
+                result.positions.push_back({nodes[components[c].nodes[v]]->id, Position(origin.x + p.x, cursor_y + p.y)});
+            }
+            cursor_y += layout.height + options.componentSpacing;
+            result.layerCount = std::max(result.layerCount, layout.layerCount);
+        }
+
+        if (!singles.empty())
+        {
+            std::stable_sort(singles.begin(), singles.end(),
+                             [&](uint32_t a, uint32_t b)
+                             {
+                                 const Position &pa = current[components[a].nodes[0]];
+                                 const Position &pb = current[components[b].nodes[0]];
+                                 return pa.y != pb.y ? pa.y < pb.y : pa.x < pb.x;
+                             });
+            const size_t columns = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(singles.size()))));
+            for (size_t i = 0; i < singles.size(); ++i)
+            {
+                const uint32_t v = components[singles[i]].nodes[0];
+                result.positions.push_back(
+                    {nodes[v]->id, Position(origin.x + static_cast<float>(i % columns) * options.layerSpacing,
+                                            cursor_y + static_cast<float>(i / columns) * options.nodeSpacing)});
+            }
+            result.layerCount = std::max<size_t>(result.layerCount, 1);
+        }
+        return result;
+    }
+
+    std::future<GraphLayout> ComputeGraphLayoutAsync(GraphSnapshot snapshot, std::vector<UUID> region,
+                                                     LayoutOptions options)
+    {
+        return std::async(std::launch::async,
+                          [snapshot = std::move(snapshot), region = std::move(region), options]
+                          { return ComputeGraphLayout(snapshot, region, options); });
+    }
+
+    size_t ApplyGraphLayout(Graph &graph, const GraphLayout &layout, size_t begin, size_t max_count)
+    {
+        const size_t end = begin + std::min(max_count, layout.positions.size() - std::min(begin, layout.positions.size()));
+        for (size_t i = begin; i < end; ++i)
+            graph.SetNodePosition(layout.positions[i].first, layout.positions[i].second);
+        return end;
+    }
+
+} // namespace MindWeaver
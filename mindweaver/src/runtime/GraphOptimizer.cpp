@@ -0,0 +1,532 @@
+#include "runtime/GraphOptimizer.h"
+
+#include "core/Subgraph.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        constexpr size_t kNone = static_cast<size_t>(-1);
+
+        // FNV-1a, so hashes are stable across runs and platforms
+        uint64_t HashBytes(const void *data, size_t size, uint64_t h = 0xcbf29ce484222325ull)
+        {
+            const auto *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                h ^= bytes[i];
+                h *= 0x100000001b3ull;
+            }
+            return h;
+        }
+
+        uint64_t HashString(const std::string &str) { return HashBytes(str.data(), str.size()); }
+
+        void HashCombine(uint64_t &seed, uint64_t value)
+        {
+            // splitmix64 finalizer on the combined value
+            uint64_t z = seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            seed = z ^ (z >> 31);
+        }
+
+        std::vector<const Pin *> SortedPins(const PinMap &pins)
+        {
+            std::vector<const Pin *> sorted;
+            sorted.reserve(pins.size());
+            for (const auto &pair : pins)
+                sorted.push_back(pair.second.get());
+            std::sort(sorted.begin(), sorted.end(),
+                      [](const Pin *a, const Pin *b)
+                      { return a->name != b->name ? a->name.GetID() < b->name.GetID() : a->type < b->type; });
+            return sorted;
+        }
+
+        bool HasExecPins(const Node &node)
+        {
+            for (const auto &pair : node.inputPins)
+                if (pair.second->type == PinType::Exec)
+                    return true;
+            for (const auto &pair : node.outputPins)
+                if (pair.second->type == PinType::Exec)
+                    return true;
+            return false;
+        }
+
+        /// @brief Per-snapshot lookup tables plus a dependency order over all nodes.
+        struct GraphIndex
+        {
+            std::vector<std::shared_ptr<const Node>> nodes;
+            std::unordered_map<UUID, size_t> pinOwner;            // Pin -> index in nodes
+            std::unordered_map<UUID, std::vector<UUID>> incoming; // Input pin -> source pins
+            std::vector<size_t> order;                            // Upstream nodes first
+            std::vector<char> onCycle;
+
+            explicit GraphIndex(const GraphSnapshot &snapshot)
+            {
+                for (const auto &node : snapshot.nodes)
+                {
+                    if (!node)
+                        continue;
+                    for (const auto &pair : node->inputPins)
+                        pinOwner[pair.first] = nodes.size();
+                    for (const auto &pair : node->outputPins)
+                        pinOwner[pair.first] = nodes.size();
+                    nodes.push_back(node);
+                }
+                for (const auto &link : snapshot.links)
+                {
+                    if (link && pinOwner.count(link->startPinID) && pinOwner.count(link->endPinID))
+                        incoming[link->endPinID].push_back(link->startPinID);
+                }
+
+                std::vector<std::vector<size_t>> dependents(nodes.size());
+                std::vector<size_t> pending(nodes.size(), 0);
+                for (size_t i = 0; i < nodes.size(); ++i)
+                {
+                    for (const auto &pair : nodes[i]->inputPins)
+                    {
+                        auto src = incoming.find(pair.first);
+                        if (src == incoming.end())
+                            continue;
+                        for (const auto &src_pin : src->second)
+                        {
+                            dependents[pinOwner[src_pin]].push_back(i);
+                            ++pending[i];
+                        }
+                    }
+                }
+                for (size_t i = 0; i < nodes.size(); ++i)
+                    if (pending[i] == 0)
+                        order.push_back(i);
+                for (size_t head = 0; head < order.size(); ++head)
+                    for (size_t down : dependents[order[head]])
+                        if (--pending[down] == 0)
+                            order.push_back(down);
+
+                // Whatever Kahn's algorithm could not reach is on (or behind) a cycle
+                onCycle.assign(nodes.size(), 0);
+                for (size_t i = 0; i < nodes.size(); ++i)
+                {
+                    if (pending[i] != 0)
+                    {
+                        onCycle[i] = 1;
+                        order.push_back(i);
+                    }
+                }
+            }
+
+            const std::vector<UUID> *Sources(const UUID &input_pin) const
+            {
+                auto it = incoming.find(input_pin);
+                return (it != incoming.end()) ? &it->second : nullptr;
+            }
+        };
+
+        std::vector<uint64_t> HashNodes(const GraphIndex &index)
+        {
+            std::vector<uint64_t> hashes(index.nodes.size(), 0);
+            for (size_t i : index.order)
+            {
+                const Node &node = *index.nodes[i];
+                uint64_t h = node.name.GetID(); // Symbols hash as their IDs
+                HashCombine(h, static_cast<uint64_t>(node.type));
+                for (const auto &param : node.parameters)
+                {
+                    HashCombine(h, HashString(param.first));
+                    HashCombine(h, HashString(param.second));
+                }
+                for (const Pin *pin : SortedPins(node.outputPins))
+                {
+                    HashCombine(h, pin->name.GetID());
+                    HashCombine(h, static_cast<uint64_t>(pin->type));
+                }
+                for (const Pin *pin : SortedPins(node.inputPins))
+                {
+                    HashCombine(h, pin->name.GetID());
+                    HashCombine(h, static_cast<uint64_t>(pin->type));
+
+                    // Fan-in order is not meaningful, so combine the sources order-independently
+                    uint64_t sources = 0;
+                    if (const auto *src_pins = index.Sources(pin->id))
+                    {
+                        for (const auto &src_pin : *src_pins)
+                        {
+                            const size_t owner = index.pinOwner.at(src_pin);
+                            const auto src_pin_ptr = index.nodes[owner]->GetOutputPin(src_pin);
+                            uint64_t src = hashes[owner];
+                            HashCombine(src, src_pin_ptr ? src_pin_ptr->name.GetID() : 0);
+                            sources += src;
+                        }
+                    }
+                    HashCombine(h, sources);
+                }
+                if (index.onCycle[i])
+                    HashCombine(h, std::hash<UUID>{}(node.id));
+                hashes[i] = h;
+            }
+            return hashes;
+        }
+
+        const Pin *FindPinByName(const PinMap &pins, Symbol name)
+        {
+            for (const auto &pair : pins)
+                if (pair.second->name == name)
+                    return pair.second.get();
+            return nullptr;
+        }
+
+        struct PinPairHash
+        {
+            size_t operator()(const std::pair<UUID, UUID> &p) const noexcept
+            {
+                size_t h = std::hash<UUID>{}(p.first);
+                return h ^ (std::hash<UUID>{}(p.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+            }
+        };
+
+        /// @brief Loads the placeholders a request can reach: those its targets depend on, plus
+        /// side-effect nodes and their dependencies when it runs them. Links are followed through
+        /// placeholders by their outlines (see NodeSource::Outline()); placeholders not reached are
+        /// left out of the result. Everything is loaded for whole-graph runs, or when the source
+        /// cannot outline its nodes.
+        GraphSnapshot MaterializeRequired(const GraphSnapshot &snapshot, const KernelRegistry &registry,
+                                          const ExecutionRequest &request)
+        {
+            if (!snapshot.nodeSource || request.targetPins.empty())
+                return snapshot.Materialized();
+
+            std::vector<std::shared_ptr<const Node>> nodes;
+            std::vector<Symbol> names;
+            std::vector<std::vector<UUID>> pins;
+            std::unordered_map<UUID, size_t> pin_owner;
+            NodeOutline outline;
+            for (const auto &node : snapshot.nodes)
+            {
+                if (!node)
+                    continue;
+                std::vector<UUID> node_pins;
+                if (node->placeholder)
+                {
+                    if (!snapshot.nodeSource->Outline(*node, outline))
+                        return snapshot.Materialized();
+                    names.push_back(outline.name);
+                    node_pins = std::move(outline.pinIDs);
+                }
+                else
+                {
+                    names.push_back(node->name);
+                    for (const auto &pair : node->inputPins)
+                        node_pins.push_back(pair.first);
+                    for (const auto &pair : node->outputPins)
+                        node_pins.push_back(pair.first);
+                }
+                for (const UUID &pin_id : node_pins)
+                    pin_owner[pin_id] = nodes.size();
+                nodes.push_back(node);
+                pins.push_back(std::move(node_pins));
+            }
+
+            std::unordered_map<UUID, std::vector<UUID>> incoming;
+            for (const auto &link : snapshot.links)
+            {
+                if (link)
+                    incoming[link->endPinID].push_back(link->startPinID);
+            }
+
+            std::vector<char> required(nodes.size(), 0);
+            std::vector<size_t> stack;
+            auto require = [&](size_t index)
+            {
+                if (!required[index])
+                {
+                    required[index] = 1;
+                    stack.push_back(index);
+                }
+            };
+            for (const UUID &pin_id : request.targetPins)
+            {
+                auto owner = pin_owner.find(pin_id);
+                if (owner != pin_owner.end())
+                    require(owner->second);
+            }
+            if (request.includeSideEffects)
+            {
+                for (size_t i = 0; i < nodes.size(); ++i)
+                {
+                    const KernelInfo *info = registry.Find(names[i]);
+                    if (info && info->sideEffects)
+                        require(i);
+                }
+            }
+            while (!stack.empty())
+            {
+                const size_t index = stack.back();
+                stack.pop_back();
+                for (const UUID &pin_id : pins[index])
+                {
+                    auto sources = incoming.find(pin_id);
+                    if (sources == incoming.end())
+                        continue;
+                    for (const UUID &start_pin : sources->second)
+                    {
+                        auto owner = pin_owner.find(start_pin);
+                        if (owner != pin_owner.end())
+                            require(owner->second);
+                    }
+                }
+            }
+
+            GraphSnapshot result;
+            result.name = snapshot.name;
+            result.links = snapshot.links;
+            result.version = snapshot.version;
+            result.nodeSource = snapshot.nodeSource;
+            for (size_t i = 0; i < nodes.size(); ++i)
+            {
+                if (!nodes[i]->placeholder)
+                    result.nodes.push_back(nodes[i]);
+                else if (required[i])
+                    result.nodes.push_back(snapshot.nodeSource->Load(*nodes[i]));
+            }
+            return result;
+        }
+    } // namespace
+
+    std::unordered_map<UUID, uint64_t> ComputeStructuralHashes(const GraphSnapshot &snapshot)
+    {
+        GraphIndex index(snapshot);
+        std::vector<uint64_t> hashes = HashNodes(index);
+
+        std::unordered_map<UUID, uint64_t> result;
+        result.reserve(index.nodes.size());
+        for (size_t i = 0; i < index.nodes.size(); ++i)
+            result[index.nodes[i]->id] = hashes[i];
+        return result;
+    }
+
+    CseResult EliminateCommonSubexpressions(const GraphSnapshot &snapshot, const KernelRegistry &registry)
+    {
+        GraphIndex index(snapshot);
+        std::vector<uint64_t> hashes = HashNodes(index);
+
+        CseResult result;
+        std::unordered_map<UUID, UUID> &remap = result.pinRemap;
+        auto canonical = [&](const UUID &pin_id)
+        {
+            auto it = remap.find(pin_id);
+            return (it != remap.end()) ? it->second : pin_id;
+        };
+
+        // Canonical (post-merge) sources of an input pin, sorted so fan-in order does not matter
+        auto canonical_sources = [&](const UUID &input_pin)
+        {
+            std::vector<UUID> sources;
+            if (const auto *src_pins = index.Sources(input_pin))
+                for (const auto &src_pin : *src_pins)
+                    sources.push_back(canonical(src_pin));
+            std::sort(sources.begin(), sources.end());
+            return sources;
+        };
+
+        auto equivalent = [&](const Node &a, const Node &b)
+        {
+            if (a.name != b.name || a.type != b.type || a.parameters != b.parameters ||
+                a.inputPins.size() != b.inputPins.size() || a.outputPins.size() != b.outputPins.size())
+                return false;
+            for (const auto &pair : a.outputPins)
+            {
+                const Pin *other = FindPinByName(b.outputPins, pair.second->name);
+                if (!other || other->type != pair.second->type)
+                    return false;
+            }
+            for (const auto &pair : a.inputPins)
+            {
+                const Pin *other = FindPinByName(b.inputPins, pair.second->name);
+                if (!other || other->type != pair.second->type ||
+                    canonical_sources(pair.first) != canonical_sources(other->id))
+                    return false;
+            }
+            return true;
+        };
+
+        std::vector<char> removed(index.nodes.size(), 0);
+        std::unordered_map<uint64_t, std::vector<size_t>> survivors; // Structural hash -> surviving nodes
+        for (size_t i : index.order)
+        {
+            const Node &node = *index.nodes[i];
+            const KernelInfo *kernel = registry.Find(node.name);
+            if (index.onCycle[i] || HasExecPins(node) || (kernel && kernel->sideEffects))
+                continue;
+
+            auto &bucket = survivors[hashes[i]];
+            size_t match = kNone;
+            for (size_t candidate : bucket)
+            {
+                if (equivalent(*index.nodes[candidate], node))
+                {
+                    match = candidate;
+                    break;
+                }
+            }
+            if (match == kNone)
+            {
+                bucket.push_back(i);
+                continue;
+            }
+
+            const Node &survivor = *index.nodes[match];
+            for (const auto &pair : node.outputPins)
+                remap[pair.first] = FindPinByName(survivor.outputPins, pair.second->name)->id;
+            for (const auto &pair : node.inputPins)
+                remap[pair.first] = FindPinByName(survivor.inputPins, pair.second->name)->id;
+            result.nodeRemap[node.id] = survivor.id;
+            removed[i] = 1;
+            ++result.nodesRemoved;
+        }
+
+        if (result.nodesRemoved == 0)
+        {
+            result.graph = snapshot;
+            return result;
+        }
+
+        // Rebuild: drop merged nodes, rewire consumers to survivors, and drop links made redundant
+        GraphSnapshot &graph = result.graph;
+        graph.name = snapshot.name;
+        graph.version = snapshot.version;
+        for (size_t i = 0; i < index.nodes.size(); ++i)
+            if (!removed[i])
+                graph.nodes.push_back(index.nodes[i]);
+
+        std::unordered_set<std::pair<UUID, UUID>, PinPairHash> seen;
+        std::shared_ptr<ObjectPool> pool; // For rewired links, created on first use
+        for (const auto &link : snapshot.links)
+        {
+            if (!link)
+                continue;
+            auto owner = index.pinOwner.find(link->endPinID);
+            if (owner == index.pinOwner.end() || removed[owner->second])
+                continue;
+            const UUID start = canonical(link->startPinID);
+            if (!seen.insert({start, link->endPinID}).second)
+                continue;
+            if (start == link->startPinID)
+                graph.links.push_back(link);
+            else
+            {
+                if (!pool)
+                    pool = std::make_shared<ObjectPool>();
+                graph.links.push_back(MakePooled<Link>(pool, link->id, start, link->endPinID));
+            }
+        }
+        return result;
+    }
+
+    GraphSnapshot InlineSubgraphs(const GraphSnapshot &snapshot, std::unordered_map<UUID, UUID> *pin_remap,
+                                  std::unordered_map<UUID, UUID> *node_owners)
+    {
+        const bool has_subgraphs = std::any_of(snapshot.nodes.begin(), snapshot.nodes.end(),
+                                               [](const auto &node) { return node && node->subgraph; });
+        if (!has_subgraphs)
+            return snapshot;
+
+        FlatGraph flat = FlattenSubgraphs(snapshot.nodes, snapshot.links, pin_remap, node_owners);
+        GraphSnapshot result;
+        result.name = snapshot.name;
+        result.version = snapshot.version;
+        result.nodeSource = snapshot.nodeSource;
+        for (auto &node : flat.nodes)
+            result.nodes.push_back(std::move(node));
+        for (auto &link : flat.links)
+            result.links.push_back(std::move(link));
+        return result;
+    }
+
+    ExecutionPlan PrepareExecutionPlan(const GraphSnapshot &lazy_snapshot, const KernelRegistry &registry,
+                                       const ExecutionRequest &request)
+    {
+        // Scheduling needs the pin tables of the nodes that run, so the placeholders of a lazily
+        // opened file those depend on are loaded here, on the executor's thread
+        const GraphSnapshot materialized = MaterializeRequired(lazy_snapshot, registry, request);
+        std::unordered_map<UUID, UUID> inlined_pins, inlined_nodes;
+        const GraphSnapshot snapshot = InlineSubgraphs(materialized, &inlined_pins, &inlined_nodes);
+
+        ExecutionRequest planned_request = request;
+        auto remap_targets = [&](const std::unordered_map<UUID, UUID> &remap)
+        {
+            for (auto &pin_id : planned_request.targetPins)
+            {
+                auto it = remap.find(pin_id);
+                if (it != remap.end())
+                    pin_id = it->second;
+            }
+        };
+        remap_targets(inlined_pins);
+
+        CseResult cse;
+        if (request.eliminateCommonSubexpressions)
+            cse = EliminateCommonSubexpressions(snapshot, registry);
+        if (cse.nodesRemoved > 0)
+            remap_targets(cse.pinRemap);
+        ExecutionPlan plan = BuildExecutionPlan(cse.nodesRemoved > 0 ? cse.graph : snapshot, registry, planned_request);
+
+        // Report results under the pins the caller asked for
+        for (size_t i = 0; i < request.targetPins.size(); ++i)
+        {
+            if (planned_request.targetPins[i] == request.targetPins[i])
+                continue;
+            auto slot = plan.targetSlots.find(planned_request.targetPins[i]);
+            if (slot != plan.targetSlots.end())
+                plan.targetSlots[request.targetPins[i]] = slot->second;
+        }
+
+        // The editor shows subgraph nodes, not their bodies
+        std::unordered_map<UUID, Symbol> instance_names;
+        if (!inlined_nodes.empty())
+        {
+            for (const auto &node : materialized.nodes)
+                if (node && node->subgraph)
+                    instance_names[node->id] = node->name;
+        }
+        std::unordered_map<UUID, size_t> plan_index;
+        for (size_t i = 0; i < plan.nodes.size(); ++i)
+        {
+            PlannedNode &planned = plan.nodes[i];
+            plan_index[planned.node->id] = i;
+            auto owner = inlined_nodes.find(planned.node->id);
+            if (owner != inlined_nodes.end())
+            {
+                planned.reportID = owner->second;
+                planned.reportName = instance_names[owner->second];
+            }
+        }
+
+        // ... and the nodes merged away, with the stats of the node they were merged into
+        for (const auto &pair : cse.nodeRemap)
+        {
+            auto survivor = plan_index.find(pair.second);
+            if (survivor == plan_index.end())
+                continue;
+            PlannedNode &planned = plan.nodes[survivor->second];
+            auto owner = inlined_nodes.find(pair.first);
+            const UUID report_id = owner != inlined_nodes.end() ? owner->second : pair.first;
+            const Symbol report_name = owner != inlined_nodes.end() ? instance_names[owner->second] : planned.node->name;
+            const bool listed = report_id == planned.reportID ||
+                                std::any_of(planned.mergedReports.begin(), planned.mergedReports.end(),
+                                            [&](const auto &merged) { return merged.first == report_id; });
+            if (!listed)
+                planned.mergedReports.emplace_back(report_id, report_name);
+        }
+        return plan;
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,253 @@
+#include "runtime/GraphPartitioner.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        double DefaultValueBytes(PinType type)
+        {
+            switch (type)
+            {
+            case PinType::Buffer:
+                return 4.0 * 1024.0 * 1024.0;
+            case PinType::String:
+                return 256.0;
+            default:
+                return 16.0;
+            }
+        }
+
+        /// @brief Undirected weighted dependency graph between plan nodes.
+        struct WeightedEdge
+        {
+            size_t other;
+            double bytes;
+        };
+
+        std::vector<std::vector<WeightedEdge>> BuildEdges(const ExecutionPlan &plan, const PartitionCostModel &model)
+        {
+            const size_t total = plan.nodes.size();
+
+            // Slot -> producing plan index and the estimated size of its value
+            std::vector<size_t> producer(plan.slotCount, PlannedNode::kNoSlot);
+            std::vector<double> slot_bytes(plan.slotCount, 0.0);
+            for (size_t i = 0; i < total; ++i)
+            {
+                const PlannedNode &planned = plan.nodes[i];
+                for (const auto &output : planned.outputs)
+                {
+                    producer[output.slot] = i;
+                    auto pin = planned.node->outputPins.find(output.pinID);
+                    const PinType type = (pin != planned.node->outputPins.end()) ? pin->second->type : PinType::Class;
+                    slot_bytes[output.slot] = model.valueBytes ? model.valueBytes(type) : DefaultValueBytes(type);
+                }
+            }
+
+            std::vector<std::unordered_map<size_t, double>> weights(total);
+            auto add = [&](size_t a, size_t b, double bytes)
+            {
+                weights[a][b] += bytes;
+                weights[b][a] += bytes;
+            };
+            for (size_t i = 0; i < total; ++i)
+            {
+                for (const auto &input : plan.nodes[i].inputs)
+                {
+                    if (input.slot != PlannedNode::kNoSlot && producer[input.slot] != PlannedNode::kNoSlot)
+                        add(producer[input.slot], i, slot_bytes[input.slot]);
+                }
+                for (size_t down : plan.nodes[i].dependents)
+                {
+                    if (weights[i].find(down) == weights[i].end())
+                        add(i, down, model.controlBytes); // Exec-only dependency
+                }
+            }
+
+            std::vector<std::vector<WeightedEdge>> edges(total);
+            for (size_t i = 0; i < total; ++i)
+            {
+                for (const auto &pair : weights[i])
+                    edges[i].push_back({pair.first, pair.second});
+            }
+            return edges;
+        }
+
+        /// @brief Most nodes that can run at once: the size of the largest level, where a node's
+        /// level is the length of the longest dependency chain leading to it. Feeders (sources with
+        /// a single dependent) are not counted; they are placed with their dependent.
+        size_t MaxParallelism(const ExecutionPlan &plan, const std::vector<bool> &feeder)
+        {
+            std::vector<size_t> level(plan.nodes.size(), 0);
+            std::vector<size_t> width;
+            for (size_t i = 0; i < plan.nodes.size(); ++i) // Plan order is topological
+            {
+                if (feeder[i])
+                    continue;
+                if (width.size() <= level[i])
+                    width.resize(level[i] + 1, 0);
+                ++width[level[i]];
+                for (size_t down : plan.nodes[i].dependents)
+                    level[down] = std::max(level[down], level[i] + 1);
+            }
+            return width.empty() ? 0 : *std::max_element(width.begin(), width.end());
+        }
+    } // namespace
+
+    PartitionResult PartitionExecutionPlan(const ExecutionPlan &plan, size_t partition_count,
+                                           const PartitionCostModel &model)
+    {
+        const size_t total = plan.nodes.size();
+        std::vector<std::vector<size_t>> predecessors(total);
+        for (size_t i = 0; i < total; ++i)
+            for (size_t down : plan.nodes[i].dependents)
+                predecessors[down].push_back(i);
+        std::vector<bool> feeder(total);
+        for (size_t i = 0; i < total; ++i)
+            feeder[i] = predecessors[i].empty() && plan.nodes[i].dependents.size() == 1;
+
+        const size_t k = std::max<size_t>(1, std::min(partition_count, MaxParallelism(plan, feeder)));
+
+        PartitionResult result;
+        result.assignment.assign(total, 0);
+        result.loads.assign(k, 0.0);
+        if (total == 0)
+            return result;
+
+        std::vector<double> cost(total);
+        for (size_t i = 0; i < total; ++i)
+            cost[i] = model.nodeCost ? std::max(0.0, model.nodeCost(plan.nodes[i])) : 1.0;
+        const double total_cost = std::accumulate(cost.begin(), cost.end(), 0.0);
+        const double max_cost = *std::max_element(cost.begin(), cost.end());
+        const double capacity = std::max(max_cost, (1.0 + std::max(0.0, model.imbalance)) * total_cost / k);
+
+        const auto edges = BuildEdges(plan, model);
+        constexpr uint32_t kUnassigned = static_cast<uint32_t>(-1);
+        std::vector<uint32_t> &part = result.assignment;
+        std::fill(part.begin(), part.end(), kUnassigned);
+
+        // A node continuing a chain (all its placed predecessors in one partition, one of which has
+        // no other dependents) could not run in parallel with them anyway, so it stays with them
+        // even past the capacity. Feeders are not placed yet and do not count.
+        auto chain_partition = [&](size_t i)
+        {
+            uint32_t p = kUnassigned;
+            bool continues = false;
+            for (size_t pred : predecessors[i])
+            {
+                if (feeder[pred])
+                    continue;
+                if (p != kUnassigned && part[pred] != p)
+                    return kUnassigned;
+                p = part[pred];
+                continues = continues || plan.nodes[pred].dependents.size() == 1;
+            }
+            return continues ? p : kUnassigned;
+        };
+
+        // Greedy placement in plan (topological) order: join the partition holding most of the
+        // node's already placed neighbours, among those with room left; ties go to the lightest
+        std::vector<double> affinity(k);
+        for (size_t i = 0; i < total; ++i)
+        {
+            if (feeder[i])
+                continue;
+            const uint32_t chain = chain_partition(i);
+            if (chain != kUnassigned)
+            {
+                part[i] = chain;
+                result.loads[chain] += cost[i];
+                continue;
+            }
+
+            std::fill(affinity.begin(), affinity.end(), 0.0);
+            for (const auto &edge : edges[i])
+            {
+                if (part[edge.other] != kUnassigned)
+                    affinity[part[edge.other]] += edge.bytes;
+            }
+            uint32_t best = kUnassigned;
+            for (uint32_t p = 0; p < k; ++p)
+            {
+                if (result.loads[p] + cost[i] > capacity)
+                    continue;
+                if (best == kUnassigned || affinity[p] > affinity[best] ||
+                    (affinity[p] == affinity[best] && result.loads[p] < result.loads[best]))
+                    best = p;
+            }
+            if (best == kUnassigned)
+                best = static_cast<uint32_t>(std::min_element(result.loads.begin(), result.loads.end()) -
+                                             result.loads.begin());
+            part[i] = best;
+            result.loads[best] += cost[i];
+        }
+        for (size_t i = 0; i < total; ++i)
+        {
+            if (feeder[i])
+            {
+                part[i] = part[plan.nodes[i].dependents.front()];
+                result.loads[part[i]] += cost[i];
+            }
+        }
+
+        // Refinement: move single nodes to the neighbouring partition that shrinks the cut the most
+        constexpr int kRefinementPasses = 4;
+        for (int pass = 0; pass < kRefinementPasses; ++pass)
+        {
+            bool moved = false;
+            for (size_t i = 0; i < total; ++i)
+            {
+                std::fill(affinity.begin(), affinity.end(), 0.0);
+                for (const auto &edge : edges[i])
+                    affinity[part[edge.other]] += edge.bytes;
+                const uint32_t from = part[i];
+                uint32_t best = from;
+                for (uint32_t p = 0; p < k; ++p)
+                {
+                    if (p != from && affinity[p] > affinity[best] && result.loads[p] + cost[i] <= capacity)
+                        best = p;
+                }
+                if (best != from)
+                {
+                    result.loads[from] -= cost[i];
+                    result.loads[best] += cost[i];
+                    part[i] = best;
+                    moved = true;
+                }
+            }
+            if (!moved)
+                break;
+        }
+
+        // Renumber so that used partitions are 0..n-1
+        std::vector<uint32_t> renumber(k, kUnassigned);
+        std::vector<double> loads;
+        for (size_t i = 0; i < total; ++i)
+        {
+            if (renumber[part[i]] == kUnassigned)
+            {
+                renumber[part[i]] = static_cast<uint32_t>(loads.size());
+                loads.push_back(0.0);
+            }
+            part[i] = renumber[part[i]];
+            loads[part[i]] += cost[i];
+        }
+        result.loads = std::move(loads);
+        result.partitionCount = result.loads.size();
+
+        for (size_t i = 0; i < total; ++i)
+        {
+            for (const auto &edge : edges[i])
+            {
+                if (edge.other > i && part[edge.other] != part[i])
+                    result.cutBytes += edge.bytes;
+            }
+        }
+        return result;
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,108 @@
+#include "runtime/MappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MindWeaver
+{
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::string &path) : m_Path(path)
+    {
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("MappedFile: failed to open '" + path + "'");
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size))
+        {
+            CloseHandle(file);
+            throw std::runtime_error("MappedFile: failed to query size of '" + path + "'");
+        }
+        m_FileHandle = file;
+        m_Size = static_cast<size_t>(file_size.QuadPart);
+        if (m_Size == 0)
+            return; // Nothing to map; Data() stays nullptr
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            CloseHandle(file);
+            throw std::runtime_error("MappedFile: failed to create mapping for '" + path + "'");
+        }
+        m_MappingHandle = mapping;
+
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("MappedFile: failed to map '" + path + "'");
+        }
+        m_Data = static_cast<const uint8_t *>(view);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_MappingHandle)
+            CloseHandle(static_cast<HANDLE>(m_MappingHandle));
+        if (m_FileHandle)
+            CloseHandle(static_cast<HANDLE>(m_FileHandle));
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string &path) : m_Path(path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error("MappedFile: failed to open '" + path + "'");
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: failed to stat '" + path + "'");
+        }
+        m_Size = static_cast<size_t>(st.st_size);
+        if (m_Size == 0)
+        {
+            ::close(fd);
+            return; // Nothing to map; Data() stays nullptr
+        }
+
+        void *addr = ::mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps its own reference to the file
+        if (addr == MAP_FAILED)
+            throw std::runtime_error("MappedFile: failed to map '" + path + "'");
+
+        // No readahead hint for the whole file: pages fault in as they are touched, so readers
+        // that only look at part of a large file (lazy graph files) never load the rest
+        m_Data = static_cast<const uint8_t *>(addr);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (m_Data)
+            ::munmap(const_cast<uint8_t *>(m_Data), m_Size);
+    }
+
+#endif
+
+} // namespace MindWeaver
@@ -0,0 +1,61 @@
+#include "runtime/NodeCatalog.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace MindWeaver
+{
+
+    void NodeCatalog::Add(NodeCatalogEntry entry)
+    {
+        Remove(entry.name);
+
+        const TrigramIndex::EntryID index_id = m_Index.Add(entry.name.str() + " " + entry.category);
+        if (index_id >= m_NamesByIndexID.size())
+            m_NamesByIndexID.resize(index_id + 1);
+        m_NamesByIndexID[index_id] = entry.name;
+
+        const Symbol name = entry.name;
+        m_Entries.emplace(name, Item{std::move(entry), index_id});
+    }
+
+    void NodeCatalog::Remove(Symbol name)
+    {
+        auto it = m_Entries.find(name);
+        if (it == m_Entries.end())
+            return;
+        m_Index.Remove(it->second.indexID);
+        m_Entries.erase(it);
+    }
+
+    const NodeCatalogEntry *NodeCatalog::Find(Symbol name) const
+    {
+        auto it = m_Entries.find(name);
+        return (it != m_Entries.end()) ? &it->second.entry : nullptr;
+    }
+
+    std::vector<const NodeCatalogEntry *> NodeCatalog::Search(std::string_view query, size_t max_results) const
+    {
+        std::vector<const NodeCatalogEntry *> results;
+        if (query.find_first_not_of(" \t") == std::string_view::npos)
+        {
+            // Nothing typed yet: browse the catalog by category, then name
+            results.reserve(m_Entries.size());
+            for (const auto &pair : m_Entries)
+                results.push_back(&pair.second.entry);
+            auto before = [](const NodeCatalogEntry *a, const NodeCatalogEntry *b)
+            { return a->category != b->category ? a->category < b->category : a->name.str() < b->name.str(); };
+            const size_t count = std::min(max_results, results.size());
+            std::partial_sort(results.begin(), results.begin() + count, results.end(), before);
+            results.resize(count);
+            return results;
+        }
+        for (const auto &match : m_Index.Search(query, max_results))
+        {
+            if (const NodeCatalogEntry *entry = Find(m_NamesByIndexID[match.id]))
+                results.push_back(entry);
+        }
+        return results;
+    }
+
+} // namespace MindWeaver
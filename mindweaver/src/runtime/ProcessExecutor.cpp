@@ -0,0 +1,861 @@
+#include "runtime/ProcessExecutor.h"
+
+#include "runtime/Buffer.h"
+#include "runtime/ExecutionEvents.h"
+#include "runtime/GraphOptimizer.h"
+#include "runtime/SharedMemory.h"
+#include "runtime/Value.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace MindWeaver
+{
+
+    ProcessExecutor::ProcessExecutor(std::shared_ptr<const KernelRegistry> registry, size_t process_count)
+        : m_Registry(std::move(registry)), m_ProcessCount(process_count)
+    {
+        if (!m_Registry)
+            throw std::invalid_argument("ProcessExecutor requires a kernel registry");
+        if (m_ProcessCount == 0)
+            m_ProcessCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    void ProcessExecutor::SetEventChannel(std::shared_ptr<ExecutionEventChannel> channel) { m_Events = channel; }
+
+    void ProcessExecutor::SetInterpreterLock(std::shared_ptr<InterpreterLock> lock) { m_InterpreterLock = lock; }
+
+    void ProcessExecutor::SetResourceCache(std::shared_ptr<ResourceCache> cache) { m_Resources = std::move(cache); }
+
+    void ProcessExecutor::SetForkHooks(ProcessForkHooks hooks) { m_ForkHooks = std::move(hooks); }
+
+    void ProcessExecutor::SetCostModel(PartitionCostModel model) { m_CostModel = std::move(model); }
+
+    void ProcessExecutor::SetSharedMemoryThreshold(size_t bytes) { m_SharedMemoryThreshold = bytes; }
+
+    ExecutionPlan ProcessExecutor::Prepare(const GraphSnapshot &snapshot, const ExecutionRequest &request) const
+    {
+        return PrepareExecutionPlan(snapshot, *m_Registry, request);
+    }
+
+    ExecutionResult ProcessExecutor::Run(const GraphSnapshot &snapshot, const ExecutionRequest &request)
+    {
+        ExecutionPlan plan;
+        try
+        {
+            plan = Prepare(snapshot, request);
+        }
+        catch (const std::exception &e)
+        {
+            ExecutionResult result;
+            result.success = false;
+            result.error = e.what();
+            return result;
+        }
+        return Run(plan);
+    }
+
+    std::future<ExecutionResult> ProcessExecutor::RunAsync(GraphSnapshot snapshot, ExecutionRequest request)
+    {
+        return std::async(std::launch::async, [this, snapshot = std::move(snapshot), request = std::move(request)]
+                          { return Run(snapshot, request); });
+    }
+
+#ifdef _WIN32
+
+    ExecutionResult ProcessExecutor::Run(const ExecutionPlan &)
+    {
+        ExecutionResult result;
+        result.success = false;
+        result.error = "Multi-process execution is not available on this platform";
+        return result;
+    }
+
+#else
+
+    namespace
+    {
+        // ---- Wire format ----
+        // Every message is a fixed header followed by `size` payload bytes. Workers only talk to the
+        // parent; the parent forwards messages verbatim to the workers that need them.
+
+        enum class MessageType : uint32_t
+        {
+            Value = 1,      /// @brief Encoded value of `slot`.
+            NodeDone = 2,   /// @brief Plan node `node` finished; its values were sent before.
+            NodeFailed = 3, /// @brief Plan node `node` threw; payload is the error text.
+            Event = 4,      /// @brief Progress/preview/status event of plan node `node`.
+            Finished = 5,   /// @brief The worker ran its whole partition and is exiting.
+        };
+
+        struct MessageHeader
+        {
+            uint32_t type = 0;
+            uint32_t node = 0;
+            uint64_t slot = 0;
+            uint64_t size = 0;
+        };
+
+        enum class ValueTag : uint8_t
+        {
+            Empty,
+            Int64,
+            Double,
+            Bool,
+            String,
+            Vector,
+            InlineBuffer,
+            SharedBuffer,
+        };
+
+        class ByteWriter
+        {
+        public:
+            template <typename T> void Put(const T &value)
+            {
+                const char *bytes = reinterpret_cast<const char *>(&value);
+                m_Bytes.append(bytes, sizeof(T));
+            }
+
+            void PutString(std::string_view value)
+            {
+                Put<uint64_t>(value.size());
+                m_Bytes.append(value);
+            }
+
+            /// @brief Reserves n bytes and returns where to write them.
+            char *Extend(size_t n)
+            {
+                const size_t offset = m_Bytes.size();
+                m_Bytes.resize(offset + n);
+                return &m_Bytes[offset];
+            }
+
+            std::string &Bytes() { return m_Bytes; }
+
+        private:
+            std::string m_Bytes;
+        };
+
+        class ByteReader
+        {
+        public:
+            ByteReader(const char *data, size_t size) : m_Data(data), m_Size(size) {}
+
+            template <typename T> T Get()
+            {
+                T value;
+                std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+                return value;
+            }
+
+            std::string GetString()
+            {
+                const size_t n = static_cast<size_t>(Get<uint64_t>());
+                return std::string(Take(n), n);
+            }
+
+            const char *Take(size_t n)
+            {
+                if (n > m_Size - m_Offset)
+                    throw std::runtime_error("Truncated message from worker process");
+                const char *at = m_Data + m_Offset;
+                m_Offset += n;
+                return at;
+            }
+
+            size_t Remaining() const { return m_Size - m_Offset; }
+
+        private:
+            const char *m_Data;
+            size_t m_Size;
+            size_t m_Offset = 0;
+        };
+
+        /// @brief Bytes of a C-contiguous buffer of the given element type and shape, as sent by a
+        /// worker; throws unless the type is known and the size is representable.
+        size_t DecodedByteSize(ElementType dtype, const std::vector<int64_t> &shape)
+        {
+            size_t bytes = ElementSize(dtype);
+            if (bytes == 0)
+                throw std::runtime_error("Invalid buffer from worker process");
+            for (int64_t extent : shape)
+            {
+                if (extent < 0 || (extent > 0 && bytes > SIZE_MAX / static_cast<uint64_t>(extent)))
+                    throw std::runtime_error("Invalid buffer from worker process");
+                bytes *= static_cast<size_t>(extent);
+            }
+            return bytes;
+        }
+
+        std::string EncodeMessage(MessageType type, uint32_t node, uint64_t slot, const std::string &payload)
+        {
+            MessageHeader header;
+            header.type = static_cast<uint32_t>(type);
+            header.node = node;
+            header.slot = slot;
+            header.size = payload.size();
+            std::string message(reinterpret_cast<const char *>(&header), sizeof(header));
+            message += payload;
+            return message;
+        }
+
+        /// @brief Name of the shared-memory segment carrying a slot's value in a given run.
+        /// Derived from the run rather than chosen by the worker, so the parent can unlink every
+        /// segment afterwards even if a worker crashed before reporting it.
+        std::string SegmentName(const std::string &run_prefix, size_t slot)
+        {
+            return run_prefix + "-" + std::to_string(slot);
+        }
+
+        std::string EncodeValue(const Value &value, const std::string &segment_name, size_t shm_threshold)
+        {
+            ByteWriter out;
+            switch (value.GetKind())
+            {
+            case ValueKind::Empty:
+                out.Put(ValueTag::Empty);
+                break;
+            case ValueKind::Int:
+                out.Put(ValueTag::Int64);
+                out.Put(value.GetInt());
+                break;
+            case ValueKind::Float:
+                out.Put(ValueTag::Double);
+                out.Put(value.GetFloat());
+                break;
+            case ValueKind::Bool:
+                out.Put(ValueTag::Bool);
+                out.Put<uint8_t>(value.GetBool() ? 1 : 0);
+                break;
+            case ValueKind::String:
+                out.Put(ValueTag::String);
+                out.PutString(value.GetString());
+                break;
+            case ValueKind::Vector:
+            {
+                const FloatVector &vector = value.GetVector();
+                out.Put(ValueTag::Vector);
+                out.Put<uint64_t>(vector.size());
+                const size_t bytes = vector.size() * sizeof(double);
+                if (bytes > 0)
+                    std::memcpy(out.Extend(bytes), vector.data(), bytes);
+                break;
+            }
+            case ValueKind::Buffer:
+            {
+                const Buffer &buffer = value.GetBuffer();
+                const size_t bytes = buffer.ByteSize();
+                const bool shared = bytes >= shm_threshold && bytes > 0;
+                out.Put(shared ? ValueTag::SharedBuffer : ValueTag::InlineBuffer);
+                out.Put(static_cast<uint8_t>(buffer.dtype));
+                out.Put<uint32_t>(static_cast<uint32_t>(buffer.shape.size()));
+                for (int64_t extent : buffer.shape)
+                    out.Put(extent);
+                if (shared)
+                {
+                    auto segment = SharedMemorySegment::Create(segment_name, bytes);
+                    buffer.CopyTo(segment->Data());
+                    out.PutString(segment_name);
+                }
+                else
+                    buffer.CopyTo(out.Extend(bytes));
+                break;
+            }
+            case ValueKind::Object:
+                throw std::runtime_error(std::string("value of type '") + value.GetObjectType().name() +
+                                         "' cannot be sent to another process");
+            }
+            return out.Bytes();
+        }
+
+        Value DecodeValue(const char *data, size_t size)
+        {
+            ByteReader in(data, size);
+            const auto tag = in.Get<ValueTag>();
+            switch (tag)
+            {
+            case ValueTag::Empty:
+                return {};
+            case ValueTag::Int64:
+                return in.Get<int64_t>();
+            case ValueTag::Double:
+                return in.Get<double>();
+            case ValueTag::Bool:
+                return in.Get<uint8_t>() != 0;
+            case ValueTag::String:
+                return in.GetString();
+            case ValueTag::Vector:
+            {
+                // The count is checked before anything is allocated for it
+                const uint64_t count = in.Get<uint64_t>();
+                if (count > in.Remaining() / sizeof(double))
+                    throw std::runtime_error("Truncated message from worker process");
+                FloatVector vector(static_cast<size_t>(count));
+                const size_t bytes = vector.size() * sizeof(double);
+                if (bytes > 0)
+                    std::memcpy(vector.data(), in.Take(bytes), bytes);
+                return vector;
+            }
+            case ValueTag::InlineBuffer:
+            case ValueTag::SharedBuffer:
+            {
+                const auto dtype = static_cast<ElementType>(in.Get<uint8_t>());
+                const uint32_t rank = in.Get<uint32_t>();
+                if (rank > in.Remaining() / sizeof(int64_t))
+                    throw std::runtime_error("Truncated message from worker process");
+                std::vector<int64_t> shape(rank);
+                for (auto &extent : shape)
+                    extent = in.Get<int64_t>();
+                const size_t bytes = DecodedByteSize(dtype, shape);
+                if (tag == ValueTag::SharedBuffer)
+                {
+                    // Map the producer's pages; the segment stays mapped while any Buffer copy lives
+                    auto segment = SharedMemorySegment::Open(in.GetString());
+                    if (segment->Size() < bytes)
+                        throw std::runtime_error("Shared buffer from worker process is too small");
+                    const void *elements = segment->Data();
+                    return Buffer::Wrap(std::move(segment), elements, dtype, std::move(shape));
+                }
+                if (bytes > in.Remaining())
+                    throw std::runtime_error("Truncated message from worker process");
+                Buffer buffer = Buffer::Allocate(dtype, std::move(shape));
+                std::memcpy(buffer.MutableData(), in.Take(buffer.ByteSize()), buffer.ByteSize());
+                return buffer;
+            }
+            }
+            throw std::runtime_error("Unknown value encoding from worker process");
+        }
+
+        std::string EncodeEvent(const ExecutionEvent &event)
+        {
+            ByteWriter out;
+            out.Put(static_cast<uint8_t>(event.kind));
+            out.Put(static_cast<uint8_t>(event.status));
+            out.Put(event.progress);
+            out.PutString(event.message);
+            return out.Bytes();
+        }
+
+        /// @brief Posts an event a worker sent for a plan node; status changes go through status.
+        void ForwardEvent(ExecutionEventChannel &events, NodeStatusReporter &status, const ExecutionPlan &plan,
+                          size_t index, const char *data, size_t size)
+        {
+            const UUID &node_id = plan.nodes[index].reportID;
+            ByteReader in(data, size);
+            const auto kind = static_cast<ExecutionEventKind>(in.Get<uint8_t>());
+            const auto node_status = static_cast<NodeStatus>(in.Get<uint8_t>());
+            const float progress = in.Get<float>();
+            std::string message = in.GetString();
+            switch (kind)
+            {
+            case ExecutionEventKind::Status:
+                if (node_status == NodeStatus::Running)
+                    status.Started(index);
+                else if (node_status == NodeStatus::Done || node_status == NodeStatus::Error)
+                    status.Finished(index, node_status == NodeStatus::Done ? std::string() : message);
+                else
+                    events.PostStatus(node_id, node_status, std::move(message));
+                break;
+            case ExecutionEventKind::Progress:
+                events.PostProgress(node_id, progress);
+                break;
+            case ExecutionEventKind::Preview:
+                events.PostPreview(node_id, std::move(message));
+                break;
+            }
+        }
+
+        /// @brief Blocking write of a whole message (workers only).
+        bool SendAll(int fd, const std::string &bytes)
+        {
+            size_t sent = 0;
+            while (sent < bytes.size())
+            {
+                const ssize_t n = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                sent += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        /// @brief Blocking read of exactly size bytes (workers only); false on EOF or error.
+        bool ReceiveAll(int fd, char *data, size_t size)
+        {
+            size_t received = 0;
+            while (received < size)
+            {
+                const ssize_t n = ::recv(fd, data + received, size - received, 0);
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n <= 0)
+                    return false;
+                received += static_cast<size_t>(n);
+            }
+            return true;
+        }
+
+        /// @brief Who needs what across partitions, derived once per run from the plan.
+        struct RoutingTable
+        {
+            std::vector<uint32_t> partition;                    /// @brief Plan index -> partition.
+            std::vector<std::vector<uint32_t>> slotConsumers;   /// @brief Slot -> partitions reading it.
+            std::vector<std::vector<uint32_t>> remoteDependents; /// @brief Plan index -> other partitions waiting on it.
+            std::vector<bool> targetSlot;                        /// @brief Slot is a requested output.
+        };
+
+        RoutingTable BuildRoutingTable(const ExecutionPlan &plan, std::vector<uint32_t> assignment)
+        {
+            RoutingTable table;
+            table.partition = std::move(assignment);
+            table.slotConsumers.resize(plan.slotCount);
+            table.remoteDependents.resize(plan.nodes.size());
+            table.targetSlot.assign(plan.slotCount, false);
+
+            auto add_unique = [](std::vector<uint32_t> &list, uint32_t value)
+            {
+                if (std::find(list.begin(), list.end(), value) == list.end())
+                    list.push_back(value);
+            };
+            for (size_t i = 0; i < plan.nodes.size(); ++i)
+            {
+                for (const auto &input : plan.nodes[i].inputs)
+                {
+                    if (input.slot != PlannedNode::kNoSlot)
+                        add_unique(table.slotConsumers[input.slot], table.partition[i]);
+                }
+                for (size_t down : plan.nodes[i].dependents)
+                {
+                    if (table.partition[down] != table.partition[i])
+                        add_unique(table.remoteDependents[i], table.partition[down]);
+                }
+            }
+            for (const auto &pair : plan.targetSlots)
+                table.targetSlot[pair.second] = true;
+            return table;
+        }
+
+        /// @brief Body of a worker process: runs every node of its partition, then exits.
+        [[noreturn]] void RunWorker(const ExecutionPlan &plan, const RoutingTable &routing, uint32_t self, int fd,
+                                    InterpreterLock *interpreter_lock, ResourceCache *resources,
+                                    const std::string &run_prefix, size_t shm_threshold, bool collect_stats)
+        {
+            const size_t total = plan.nodes.size();
+            std::vector<Value> values(plan.slotCount);
+            std::vector<size_t> pending(total);
+            std::vector<size_t> ready;
+            size_t remaining = 0;
+            for (size_t i = 0; i < total; ++i)
+            {
+                pending[i] = plan.nodes[i].dependencyCount;
+                if (routing.partition[i] != self)
+                    continue;
+                ++remaining;
+                if (pending[i] == 0)
+                    ready.push_back(i);
+            }
+
+            auto release_local = [&](size_t index)
+            {
+                for (size_t down : plan.nodes[index].dependents)
+                {
+                    if (routing.partition[down] == self && --pending[down] == 0)
+                        ready.push_back(down);
+                }
+            };
+
+            // Events of the running node are collected locally and forwarded after it
+            ExecutionEventChannel local_events;
+            auto forward_events = [&](uint32_t index)
+            {
+                local_events.Drain([&](const ExecutionEvent &event)
+                                   { SendAll(fd, EncodeMessage(MessageType::Event, index, 0, EncodeEvent(event))); });
+            };
+
+            while (remaining > 0)
+            {
+                if (ready.empty())
+                {
+                    // Wait for values and completions from other partitions
+                    MessageHeader header;
+                    if (!ReceiveAll(fd, reinterpret_cast<char *>(&header), sizeof(header)))
+                        ::_exit(1); // The parent is gone
+                    std::string payload(header.size, '\0');
+                    if (!ReceiveAll(fd, &payload[0], payload.size()))
+                        ::_exit(1);
+                    if (header.type == static_cast<uint32_t>(MessageType::Value))
+                        values[header.slot] = DecodeValue(payload.data(), payload.size());
+                    else if (header.type == static_cast<uint32_t>(MessageType::NodeDone))
+                        release_local(header.node);
+                    continue;
+                }
+
+                const size_t index = ready.back();
+                ready.pop_back();
+                const PlannedNode &planned = plan.nodes[index];
+                const uint32_t node = static_cast<uint32_t>(index);
+
+                ExecutionEvent running;
+                running.status = NodeStatus::Running;
+                SendAll(fd, EncodeMessage(MessageType::Event, node, 0, EncodeEvent(running)));
+
+                std::string error;
+                std::string stats; // Encoded NodeSample, sent with NodeDone
+                const bool interpreter = planned.kernel && planned.kernel->affinity == ExecutionAffinity::Interpreter;
+                if (interpreter && interpreter_lock)
+                    interpreter_lock->Acquire();
+                try
+                {
+                    if (planned.kernel && planned.kernel->kernel)
+                    {
+                        std::optional<NodeSampler> sampler;
+                        if (collect_stats)
+                            sampler.emplace();
+                        if (planned.binaryOperator)
+                            planned.binaryOperator(values[planned.inputs[0].slot], values[planned.inputs[1].slot],
+                                                   values[planned.outputs[0].slot]);
+                        else
+                        {
+                            ExecutionContext context(plan, index, values, &local_events, resources);
+                            planned.kernel->kernel(context);
+                        }
+                        if (sampler)
+                        {
+                            const NodeSample sample = sampler->Stop(node, self);
+                            stats.assign(reinterpret_cast<const char *>(&sample), sizeof(sample));
+                        }
+                    }
+                    // Publish what other partitions and the caller need
+                    for (const auto &output : planned.outputs)
+                    {
+                        const bool remote = std::any_of(routing.slotConsumers[output.slot].begin(),
+                                                        routing.slotConsumers[output.slot].end(),
+                                                        [&](uint32_t p) { return p != self; });
+                        if (!remote && !routing.targetSlot[output.slot])
+                            continue;
+                        try
+                        {
+                            std::string encoded = EncodeValue(values[output.slot],
+                                                              SegmentName(run_prefix, output.slot), shm_threshold);
+                            SendAll(fd, EncodeMessage(MessageType::Value, node, output.slot, encoded));
+                        }
+                        catch (const std::exception &e)
+                        {
+                            throw std::runtime_error("output '" + output.pinName.str() + "': " + e.what());
+                        }
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    error = e.what();
+                    if (error.empty())
+                        error = "unknown error";
+                }
+                catch (...)
+                {
+                    error = "unknown error";
+                }
+                if (interpreter && interpreter_lock)
+                    interpreter_lock->Release();
+
+                forward_events(node);
+                if (!error.empty())
+                {
+                    SendAll(fd, EncodeMessage(MessageType::NodeFailed, node, 0, error));
+                    ::_exit(0);
+                }
+                SendAll(fd, EncodeMessage(MessageType::NodeDone, node, 0, stats));
+                release_local(index);
+                --remaining;
+            }
+
+            SendAll(fd, EncodeMessage(MessageType::Finished, 0, 0, {}));
+            ::_exit(0);
+        }
+
+        /// @brief Parent-side state of one worker process.
+        struct WorkerProcess
+        {
+            pid_t pid = -1;
+            int fd = -1;
+            std::string inbound;  /// @brief Bytes received but not yet parsed.
+            std::string outbound; /// @brief Bytes queued for the worker.
+            bool finished = false;
+            bool closed = false;
+        };
+
+        std::string DescribeExit(pid_t pid)
+        {
+            int status = 0;
+            if (::waitpid(pid, &status, 0) != pid)
+                return "worker process exited unexpectedly";
+            if (WIFSIGNALED(status))
+                return "worker process was killed by signal " + std::to_string(WTERMSIG(status));
+            return "worker process exited unexpectedly with status " + std::to_string(WEXITSTATUS(status));
+        }
+
+        std::atomic<uint64_t> g_RunCounter{0};
+    } // namespace
+
+    ExecutionResult ProcessExecutor::Run(const ExecutionPlan &plan)
+    {
+        ExecutionResult result;
+        const size_t total = plan.nodes.size();
+        if (total == 0)
+            return result;
+
+        ExecutionEventChannel *events = m_Events.get();
+        const PartitionResult partitions = PartitionExecutionPlan(plan, m_ProcessCount, m_CostModel);
+        const RoutingTable routing = BuildRoutingTable(plan, partitions.assignment);
+        const std::string run_prefix =
+            "/mindweaver-" + std::to_string(::getpid()) + "-" + std::to_string(g_RunCounter.fetch_add(1));
+
+        NodeStatusReporter status(events, plan);
+        status.Queued();
+
+        // ---- Spawn one worker per partition ----
+        std::vector<WorkerProcess> workers(partitions.partitionCount);
+        for (uint32_t p = 0; p < workers.size(); ++p)
+        {
+            int fds[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0)
+            {
+                result.success = false;
+                result.error = "Failed to create worker socket";
+                break;
+            }
+            if (m_ForkHooks.prepare)
+                m_ForkHooks.prepare();
+            const pid_t pid = ::fork();
+            if (pid == 0)
+            {
+                // Worker: drop every parent-side descriptor, including those of earlier workers
+                ::close(fds[0]);
+                for (uint32_t q = 0; q < p; ++q)
+                    ::close(workers[q].fd);
+                if (m_ForkHooks.child)
+                    m_ForkHooks.child();
+                RunWorker(plan, routing, p, fds[1], m_InterpreterLock.get(), m_Resources.get(), run_prefix,
+                          m_SharedMemoryThreshold, m_CollectStats);
+            }
+            if (m_ForkHooks.parent)
+                m_ForkHooks.parent();
+            ::close(fds[1]);
+            if (pid < 0)
+            {
+                ::close(fds[0]);
+                result.success = false;
+                result.error = "Failed to fork worker process";
+                break;
+            }
+            ::fcntl(fds[0], F_SETFL, ::fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+            workers[p].pid = pid;
+            workers[p].fd = fds[0];
+        }
+
+        // ---- Coordinate: route messages until every worker finished or one failed ----
+        std::vector<NodeStatus> outcome(total, NodeStatus::Queued);
+        std::vector<Value> values(plan.slotCount);
+        bool failed = !result.success;
+        auto fail = [&](const std::string &error)
+        {
+            if (!failed)
+                result.error = error;
+            failed = true;
+        };
+
+        auto handle_message = [&](uint32_t from, const MessageHeader &header, const char *payload)
+        {
+            const auto type = static_cast<MessageType>(header.type);
+            if (type != MessageType::Finished && header.node >= total)
+                throw std::runtime_error("Invalid node index from worker process");
+            const std::string raw =
+                EncodeMessage(type, header.node, header.slot, std::string(payload, header.size));
+            switch (type)
+            {
+            case MessageType::Value:
+                if (header.slot >= plan.slotCount)
+                    throw std::runtime_error("Invalid value slot from worker process");
+                for (uint32_t p : routing.slotConsumers[header.slot])
+                {
+                    if (p != from)
+                        workers[p].outbound += raw;
+                }
+                if (routing.targetSlot[header.slot])
+                    values[header.slot] = DecodeValue(payload, header.size);
+                break;
+            case MessageType::NodeDone:
+            {
+                outcome[header.node] = NodeStatus::Done;
+                status.Finished(header.node, {});
+                if (header.size == sizeof(NodeSample))
+                {
+                    NodeSample sample;
+                    std::memcpy(&sample, payload, sizeof(sample));
+                    sample.planIndex = header.node;
+                    sample.thread = from;
+                    RecordSample(result.stats, plan.nodes[header.node], sample);
+                }
+                // Other workers only need to know the node is done, not its stats
+                const std::string done = EncodeMessage(type, header.node, 0, {});
+                for (uint32_t p : routing.remoteDependents[header.node])
+                    workers[p].outbound += done;
+                break;
+            }
+            case MessageType::NodeFailed:
+            {
+                outcome[header.node] = NodeStatus::Error;
+                const std::string error(payload, header.size);
+                status.Finished(header.node, error);
+                fail("'" + plan.nodes[header.node].node->name.str() + "': " + error);
+                break;
+            }
+            case MessageType::Event:
+                if (events)
+                    ForwardEvent(*events, status, plan, header.node, payload, header.size);
+                break;
+            case MessageType::Finished:
+                workers[from].finished = true;
+                break;
+            }
+        };
+
+        std::vector<pollfd> polls;
+        std::vector<uint32_t> poll_owner;
+        char chunk[64 * 1024];
+        while (!failed)
+        {
+            polls.clear();
+            poll_owner.clear();
+            for (uint32_t p = 0; p < workers.size(); ++p)
+            {
+                if (workers[p].closed)
+                    continue;
+                pollfd entry{};
+                entry.fd = workers[p].fd;
+                entry.events = POLLIN | (workers[p].outbound.empty() ? 0 : POLLOUT);
+                polls.push_back(entry);
+                poll_owner.push_back(p);
+            }
+            if (polls.empty())
+                break;
+            if (::poll(polls.data(), polls.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                fail("Failed to wait for worker processes");
+                break;
+            }
+
+            for (size_t k = 0; k < polls.size() && !failed; ++k)
+            {
+                WorkerProcess &worker = workers[poll_owner[k]];
+                if (polls[k].revents & POLLOUT)
+                {
+                    const ssize_t n = ::send(worker.fd, worker.outbound.data(), worker.outbound.size(), MSG_NOSIGNAL);
+                    if (n > 0)
+                        worker.outbound.erase(0, static_cast<size_t>(n));
+                }
+                if (!(polls[k].revents & (POLLIN | POLLHUP | POLLERR)))
+                    continue;
+
+                const ssize_t n = ::recv(worker.fd, chunk, sizeof(chunk), 0);
+                if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+                    continue;
+                if (n > 0)
+                    worker.inbound.append(chunk, static_cast<size_t>(n));
+
+                try
+                {
+                    size_t offset = 0;
+                    while (worker.inbound.size() - offset >= sizeof(MessageHeader))
+                    {
+                        MessageHeader header;
+                        std::memcpy(&header, worker.inbound.data() + offset, sizeof(header));
+                        if (worker.inbound.size() - offset - sizeof(header) < header.size)
+                            break;
+                        handle_message(poll_owner[k], header, worker.inbound.data() + offset + sizeof(header));
+                        offset += sizeof(header) + header.size;
+                    }
+                    worker.inbound.erase(0, offset);
+                }
+                catch (const std::exception &e)
+                {
+                    fail(e.what());
+                }
+
+                if (n == 0 || (n < 0 && !(polls[k].revents & POLLIN)))
+                {
+                    worker.closed = true;
+                    if (!worker.finished && !failed)
+                    {
+                        fail(DescribeExit(worker.pid)); // Crashed: report how
+                        worker.pid = -1;                // Already reaped
+                    }
+                }
+            }
+        }
+
+        // ---- Tear down ----
+        for (auto &worker : workers)
+        {
+            if (worker.pid > 0 && failed)
+                ::kill(worker.pid, SIGKILL); // Stop the rest of the run
+        }
+        for (auto &worker : workers)
+        {
+            if (worker.fd >= 0)
+                ::close(worker.fd);
+            if (worker.pid > 0)
+                ::waitpid(worker.pid, nullptr, 0);
+        }
+        // Target buffers stay mapped; the names are no longer needed by anyone
+        for (size_t slot = 0; slot < plan.slotCount; ++slot)
+        {
+            if (routing.targetSlot[slot] || !routing.slotConsumers[slot].empty())
+                SharedMemorySegment::Unlink(SegmentName(run_prefix, slot));
+        }
+
+        result.success = !failed;
+        for (size_t i = 0; i < total; ++i)
+        {
+            if (outcome[i] == NodeStatus::Done)
+                ++result.nodesExecuted;
+        }
+        status.Stopped();
+        for (const auto &pair : plan.targetSlots)
+        {
+            if (values[pair.second].HasValue())
+                result.outputs[pair.first] = values[pair.second];
+        }
+        if (m_CollectStats)
+            result.stats.SetRunCount(1);
+        return result;
+    }
+
+#endif
+
+} // namespace MindWeaver
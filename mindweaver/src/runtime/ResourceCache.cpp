@@ -0,0 +1,185 @@
+#include "runtime/ResourceCache.h"
+
+#include "runtime/ExecutionStats.h"
+
+#include <stdexcept>
+
+namespace MindWeaver
+{
+
+    ResourceCache &ResourceCache::Instance()
+    {
+        static ResourceCache instance;
+        return instance;
+    }
+
+    ResourceCache::ResourceCache(size_t budget_bytes) : m_BudgetBytes(budget_bytes) {}
+
+    ResourceCache::~ResourceCache()
+    {
+        // Outstanding handles keep their Entry (and resource) alive on their own; they only call
+        // back into the cache on release, which must not happen after this point.
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Lru.clear();
+        m_Entries.clear();
+    }
+
+    std::shared_ptr<void> ResourceCache::AcquireErased(const ResourceKey &key, std::type_index type,
+                                                       const ErasedLoader &loader)
+    {
+        std::shared_ptr<Entry> entry;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            auto it = m_Entries.find(key);
+            if (it != m_Entries.end())
+            {
+                entry = it->second;
+                if (entry->type != type)
+                    throw std::runtime_error("ResourceCache: '" + key.path + "' is cached with a different type");
+
+                m_Hits.fetch_add(1, std::memory_order_relaxed);
+                ++GetThreadCounters().cacheHits;
+                if (entry->pins++ == 0 && entry->ready)
+                    m_BytesPinned += entry->bytes;
+
+                // Another thread is loading this key; wait for it rather than loading twice
+                m_LoadFinished.wait(lock, [&] { return entry->ready || entry->error; });
+                if (entry->error)
+                {
+                    --entry->pins;
+                    std::rethrow_exception(entry->error);
+                }
+
+                m_Lru.splice(m_Lru.begin(), m_Lru, entry->lruPos);
+                return MakeHandle(entry);
+            }
+
+            entry = std::make_shared<Entry>();
+            entry->key = key;
+            entry->type = type;
+            entry->pins = 1;
+            m_Entries.emplace(key, entry);
+            m_Misses.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Run the loader without holding the lock; loads can take seconds
+        std::shared_ptr<void> resource;
+        size_t bytes = 0;
+        try
+        {
+            resource = loader(bytes);
+            if (!resource)
+                throw std::runtime_error("ResourceCache: loader for '" + key.path + "' returned null");
+        }
+        catch (...)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                entry->error = std::current_exception();
+                m_Entries.erase(key);
+            }
+            m_LoadFinished.notify_all();
+            throw;
+        }
+
+        std::vector<std::shared_ptr<void>> graveyard;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            entry->resource = std::move(resource);
+            entry->bytes = bytes;
+            entry->ready = true;
+            entry->lruPos = m_Lru.insert(m_Lru.begin(), entry);
+            m_BytesResident += bytes;
+            m_BytesPinned += bytes;
+            EvictLocked(m_BudgetBytes.load(std::memory_order_relaxed), graveyard);
+        }
+        m_LoadFinished.notify_all();
+        return MakeHandle(entry);
+    }
+
+    std::shared_ptr<void> ResourceCache::MakeHandle(const std::shared_ptr<Entry> &entry)
+    {
+        // One pin per handle; copies of the handle share it through the shared_ptr control block
+        return std::shared_ptr<void>(entry->resource.get(), Unpinner{this, entry});
+    }
+
+    void ResourceCache::Unpin(const std::shared_ptr<Entry> &entry)
+    {
+        std::vector<std::shared_ptr<void>> graveyard;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (--entry->pins == 0)
+            {
+                m_BytesPinned -= entry->bytes;
+                EvictLocked(m_BudgetBytes.load(std::memory_order_relaxed), graveyard);
+            }
+        }
+    }
+
+    std::shared_ptr<const MappedFile> ResourceCache::AcquireMappedFile(const std::string &path)
+    {
+        return Acquire<const MappedFile>({path, "mmap"},
+                                         [&](size_t &out_bytes)
+                                         {
+                                             auto file = std::make_shared<const MappedFile>(path);
+                                             out_bytes = file->Size();
+                                             return file;
+                                         });
+    }
+
+    bool ResourceCache::Contains(const ResourceKey &key) const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Entries.find(key);
+        return it != m_Entries.end() && it->second->ready;
+    }
+
+    void ResourceCache::SetBudget(size_t budget_bytes)
+    {
+        m_BudgetBytes.store(budget_bytes, std::memory_order_relaxed);
+        std::vector<std::shared_ptr<void>> graveyard;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        EvictLocked(budget_bytes, graveyard);
+    }
+
+    void ResourceCache::Trim()
+    {
+        std::vector<std::shared_ptr<void>> graveyard;
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        EvictLocked(0, graveyard);
+    }
+
+    ResourceCacheStats ResourceCache::GetStats() const
+    {
+        ResourceCacheStats stats;
+        stats.hits = m_Hits.load(std::memory_order_relaxed);
+        stats.misses = m_Misses.load(std::memory_order_relaxed);
+        stats.evictions = m_Evictions.load(std::memory_order_relaxed);
+        stats.budgetBytes = m_BudgetBytes.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        stats.bytesResident = m_BytesResident;
+        stats.bytesPinned = m_BytesPinned;
+        stats.entryCount = m_Lru.size();
+        return stats;
+    }
+
+    void ResourceCache::EvictLocked(size_t target_bytes, std::vector<std::shared_ptr<void>> &graveyard)
+    {
+        auto it = m_Lru.end();
+        while (m_BytesResident > target_bytes && it != m_Lru.begin())
+        {
+            --it;
+            const std::shared_ptr<Entry> &entry = *it;
+            if (entry->pins > 0)
+                continue;
+
+            m_BytesResident -= entry->bytes;
+            graveyard.push_back(std::move(entry->resource));
+            m_Entries.erase(entry->key);
+            it = m_Lru.erase(it);
+            m_Evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,93 @@
+#include "runtime/SharedMemory.h"
+
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MindWeaver
+{
+
+    std::shared_ptr<SharedMemorySegment> SharedMemorySegment::Create(const std::string &name, size_t size)
+    {
+        return std::shared_ptr<SharedMemorySegment>(new SharedMemorySegment(name, true, size));
+    }
+
+    std::shared_ptr<SharedMemorySegment> SharedMemorySegment::Open(const std::string &name)
+    {
+        return std::shared_ptr<SharedMemorySegment>(new SharedMemorySegment(name, false, 0));
+    }
+
+#ifdef _WIN32
+
+    SharedMemorySegment::SharedMemorySegment(const std::string &name, bool, size_t) : m_Name(name)
+    {
+        throw std::runtime_error("SharedMemorySegment: POSIX shared memory is not available on this platform");
+    }
+
+    SharedMemorySegment::~SharedMemorySegment() {}
+
+    void SharedMemorySegment::Unlink(const std::string &) {}
+
+#else
+
+    SharedMemorySegment::SharedMemorySegment(const std::string &name, bool create, size_t size) : m_Name(name)
+    {
+        const int flags = create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDONLY;
+        int fd = ::shm_open(name.c_str(), flags | O_CLOEXEC, 0600);
+        if (fd < 0)
+            throw std::runtime_error("SharedMemorySegment: failed to open '" + name + "'");
+
+        if (create)
+        {
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                throw std::runtime_error("SharedMemorySegment: failed to size '" + name + "'");
+            }
+            m_Size = size;
+        }
+        else
+        {
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("SharedMemorySegment: failed to stat '" + name + "'");
+            }
+            m_Size = static_cast<size_t>(st.st_size);
+        }
+
+        if (m_Size == 0)
+        {
+            ::close(fd);
+            return; // Nothing to map; Data() stays nullptr
+        }
+
+        void *addr = ::mmap(nullptr, m_Size, create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd); // The mapping keeps its own reference
+        if (addr == MAP_FAILED)
+        {
+            if (create)
+                ::shm_unlink(name.c_str());
+            throw std::runtime_error("SharedMemorySegment: failed to map '" + name + "'");
+        }
+        m_Data = static_cast<uint8_t *>(addr);
+    }
+
+    SharedMemorySegment::~SharedMemorySegment()
+    {
+        if (m_Data)
+            ::munmap(m_Data, m_Size);
+    }
+
+    void SharedMemorySegment::Unlink(const std::string &name) { ::shm_unlink(name.c_str()); }
+
+#endif
+
+} // namespace MindWeaver
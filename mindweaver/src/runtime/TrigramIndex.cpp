@@ -0,0 +1,153 @@
+#include "runtime/TrigramIndex.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace MindWeaver
+{
+
+    namespace
+    {
+        std::string ToLower(std::string_view text)
+        {
+            std::string lower(text);
+            for (char &c : lower)
+                c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            return lower;
+        }
+
+        uint32_t Pack(char a, char b, char c)
+        {
+            return (static_cast<uint32_t>(static_cast<uint8_t>(a)) << 16) |
+                   (static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8) | static_cast<uint8_t>(c);
+        }
+
+        /// @brief Distinct trigrams of the words of lowercased text, each word padded as "  word ".
+        std::vector<uint32_t> Trigrams(const std::string &lower)
+        {
+            std::vector<uint32_t> trigrams;
+            std::string padded;
+            size_t i = 0;
+            while (i < lower.size())
+            {
+                while (i < lower.size() && !std::isalnum(static_cast<unsigned char>(lower[i])))
+                    ++i;
+                const size_t start = i;
+                while (i < lower.size() && std::isalnum(static_cast<unsigned char>(lower[i])))
+                    ++i;
+                if (start == i)
+                    break;
+
+                padded.assign("  ");
+                padded.append(lower, start, i - start);
+                padded.push_back(' ');
+                for (size_t t = 0; t + 3 <= padded.size(); ++t)
+                    trigrams.push_back(Pack(padded[t], padded[t + 1], padded[t + 2]));
+            }
+            std::sort(trigrams.begin(), trigrams.end());
+            trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+            return trigrams;
+        }
+    } // namespace
+
+    TrigramIndex::EntryID TrigramIndex::Add(std::string_view text)
+    {
+        EntryID id;
+        if (!m_FreeIDs.empty())
+        {
+            id = m_FreeIDs.back();
+            m_FreeIDs.pop_back();
+        }
+        else
+        {
+            id = static_cast<EntryID>(m_Entries.size());
+            m_Entries.emplace_back();
+        }
+
+        Entry &entry = m_Entries[id];
+        entry.text = ToLower(text);
+        entry.trigrams = Trigrams(entry.text);
+        entry.alive = true;
+        for (uint32_t trigram : entry.trigrams)
+            m_Postings[trigram].push_back(id);
+        return id;
+    }
+
+    void TrigramIndex::Remove(EntryID id)
+    {
+        if (id >= m_Entries.size() || !m_Entries[id].alive)
+            return;
+
+        Entry &entry = m_Entries[id];
+        for (uint32_t trigram : entry.trigrams)
+        {
+            auto it = m_Postings.find(trigram);
+            if (it == m_Postings.end())
+                continue;
+            auto &posting = it->second;
+            posting.erase(std::find(posting.begin(), posting.end(), id));
+            if (posting.empty())
+                m_Postings.erase(it);
+        }
+        entry = Entry();
+        m_FreeIDs.push_back(id);
+    }
+
+    std::vector<TrigramIndex::Match> TrigramIndex::Search(std::string_view query, size_t max_results) const
+    {
+        const std::string lower = ToLower(query);
+        const std::vector<uint32_t> query_trigrams = Trigrams(lower);
+        if (query_trigrams.empty() || max_results == 0)
+            return {};
+
+        // Gather the query trigrams' postings; after sorting, each entry's run length is the number
+        // of query trigrams it contains. Work and memory stay proportional to the postings visited,
+        // not to the size of the index
+        std::vector<EntryID> candidates;
+        for (uint32_t trigram : query_trigrams)
+        {
+            auto it = m_Postings.find(trigram);
+            if (it != m_Postings.end())
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // Keep entries sharing at least half of the query's trigrams
+        const size_t min_hits = (query_trigrams.size() + 1) / 2;
+        const float total = static_cast<float>(query_trigrams.size());
+        std::vector<Match> matches;
+        for (size_t run = 0; run < candidates.size();)
+        {
+            const EntryID id = candidates[run];
+            size_t hits = 0;
+            for (; run < candidates.size() && candidates[run] == id; ++run)
+                ++hits;
+            if (hits < min_hits)
+                continue;
+            const std::string &text = m_Entries[id].text;
+            float score = static_cast<float>(hits) / total;
+            const size_t position = text.find(lower);
+            if (position != std::string::npos)
+            {
+                score += 0.5f;
+                if (position == 0)
+                    score += 0.25f; // Prefix of the name
+                if (position == 0 && (text.size() == lower.size() || text[lower.size()] == ' '))
+                    score += 0.25f; // Whole first word, i.e. the exact name for single-word names
+            }
+            score -= 0.001f * static_cast<float>(text.size()); // Prefer shorter entries on ties
+            matches.push_back({id, score});
+        }
+
+        auto better = [](const Match &a, const Match &b) { return a.score != b.score ? a.score > b.score : a.id < b.id; };
+        if (matches.size() > max_results)
+        {
+            std::partial_sort(matches.begin(), matches.begin() + max_results, matches.end(), better);
+            matches.resize(max_results);
+        }
+        else
+            std::sort(matches.begin(), matches.end(), better);
+        return matches;
+    }
+
+} // namespace MindWeaver
@@ -0,0 +1,71 @@
+#include "runtime/Value.h"
+
+#include <stdexcept>
+
+namespace MindWeaver
+{
+
+    const char *GetValueKindName(ValueKind kind)
+    {
+        switch (kind)
+        {
+        case ValueKind::Empty:
+            return "Empty";
+        case ValueKind::Bool:
+            return "Bool";
+        case ValueKind::Int:
+            return "Int";
+        case ValueKind::Float:
+            return "Float";
+        case ValueKind::String:
+            return "String";
+        case ValueKind::Vector:
+            return "Vector";
+        case ValueKind::Buffer:
+            return "Buffer";
+        case ValueKind::Object:
+            return "Object";
+        }
+        return "Unknown";
+    }
+
+    ValueKind GetValueKind(PinType type)
+    {
+        switch (type)
+        {
+        case PinType::Exec:
+            return ValueKind::Empty;
+        case PinType::Int:
+            return ValueKind::Int;
+        case PinType::Float:
+            return ValueKind::Float;
+        case PinType::Bool:
+            return ValueKind::Bool;
+        case PinType::String:
+            return ValueKind::String;
+        case PinType::Vector:
+            return ValueKind::Vector;
+        case PinType::Class:
+            return ValueKind::Object;
+        case PinType::Buffer:
+            return ValueKind::Buffer;
+        }
+        return ValueKind::Empty;
+    }
+
+    void Value::ThrowKindMismatch(ValueKind expected) const
+    {
+        throw std::runtime_error(std::string("Expected a value of kind ") + GetValueKindName(expected) + ", got " +
+                                 GetValueKindName(m_Kind));
+    }
+
+    void Value::ThrowObjectMismatch(const std::type_info &expected) const
+    {
+        if (m_Kind != ValueKind::Object)
+            throw std::runtime_error(std::string("Expected an object of type '") + expected.name() +
+                                     "', got a value of kind " + GetValueKindName(m_Kind));
+        throw std::runtime_error(std::string("Expected an object of type '") + expected.name() + "', got '" +
+                                 GetObjectType().name() + "'");
+    }
+
+} // namespace MindWeaver
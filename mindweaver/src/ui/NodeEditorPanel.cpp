@@ -6,18 +6,114 @@
 #include "core/Node.h"
 #include "core/Pin.h"
 #include "core/Position.h"
+#include "core/Subgraph.h"
 #include "core/UUID.h"
+#include "runtime/NodeCatalog.h"
 
 // ImGui and ImNodes
 #include <imgui.h>
 #include <imnodes.h> // Include ImNodes header
 
 #include <algorithm> // For std::remove_if
+#include <cmath>
+#include <cstdio>
 #include <iostream>  // For debugging
+#include <unordered_set>
+#include <vector>
 
 namespace MindWeaver
 {
 
+    namespace
+    {
+        // Upper bound on events applied per frame so a burst from the executor cannot stall the UI
+        constexpr size_t kMaxEventsPerFrame = 4096;
+
+        // Nodes of a lazily loaded graph materialized per frame, and how far outside the visible
+        // area (in grid units) they are loaded ahead of panning
+        constexpr size_t kMaxMaterializedPerFrame = 2000;
+        constexpr float kMaterializeMargin = 400.0f;
+
+        // Rows listed by the node palette; searching the catalog for them takes well under a frame
+        constexpr size_t kMaxPaletteResults = 50;
+        constexpr const char *kPalettePopup = "Create Node";
+
+        // Share of a link's length its bezier tangents reach out horizontally (as drawn by ImNodes)
+        constexpr float kLinkTangentFactor = 0.25f;
+
+        // Title bar colors (normal, hovered/selected) per execution status
+        bool GetStatusColors(NodeStatus status, unsigned int &color, unsigned int &highlight)
+        {
+            switch (status)
+            {
+            case NodeStatus::Queued:
+                color = IM_COL32(70, 90, 130, 255);
+                highlight = IM_COL32(90, 115, 165, 255);
+                return true;
+            case NodeStatus::Running:
+                color = IM_COL32(170, 120, 30, 255);
+                highlight = IM_COL32(205, 150, 45, 255);
+                return true;
+            case NodeStatus::Done:
+                color = IM_COL32(45, 125, 70, 255);
+                highlight = IM_COL32(60, 160, 90, 255);
+                return true;
+            case NodeStatus::Error:
+                color = IM_COL32(160, 45, 45, 255);
+                highlight = IM_COL32(200, 60, 60, 255);
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Node background for a heatmap value, from cold (0) to hot (1)
+        unsigned int GetHeatColor(float heat, int brighten = 0)
+        {
+            heat = std::min(std::max(heat, 0.0f), 1.0f);
+            auto mix = [](int a, int b, float t) { return static_cast<int>(a + (b - a) * t); };
+            int r, g, b;
+            if (heat < 0.5f)
+            {
+                const float t = heat * 2.0f; // Blue to amber
+                r = mix(40, 170, t), g = mix(55, 130, t), b = mix(95, 35, t);
+            }
+            else
+            {
+                const float t = (heat - 0.5f) * 2.0f; // Amber to red
+                r = mix(170, 190, t), g = mix(130, 40, t), b = mix(35, 35, t);
+            }
+            return IM_COL32(std::min(r + brighten, 255), std::min(g + brighten, 255), std::min(b + brighten, 255), 255);
+        }
+
+        std::string FormatMetric(NodeMetric metric, double value)
+        {
+            char text[64];
+            switch (metric)
+            {
+            case NodeMetric::WallTime:
+            case NodeMetric::CpuTime:
+                if (value >= 1e9)
+                    std::snprintf(text, sizeof(text), "%.2f s", value / 1e9);
+                else if (value >= 1e6)
+                    std::snprintf(text, sizeof(text), "%.2f ms", value / 1e6);
+                else
+                    std::snprintf(text, sizeof(text), "%.1f us", value / 1e3);
+                break;
+            case NodeMetric::BytesAllocated:
+                if (value >= 1024.0 * 1024.0)
+                    std::snprintf(text, sizeof(text), "%.1f MiB", value / (1024.0 * 1024.0));
+                else
+                    std::snprintf(text, sizeof(text), "%.1f KiB", value / 1024.0);
+                break;
+            default:
+                std::snprintf(text, sizeof(text), "%.0f", value);
+                break;
+            }
+            return std::string(GetNodeMetricName(metric)) + ": " + text;
+        }
+    } // namespace
+
     // Static helper method implementation
     int NodeEditorPanel::GetImNodeID(const MindWeaver::UUID &uuid) { return uuid.to_int_for_imnodes(); }
 
@@ -38,7 +134,48 @@ namespace MindWeaver
         }
     }
 
-    void NodeEditorPanel::SetGraph(std::shared_ptr<Graph> graph_ptr) { m_Graph = graph_ptr; }
+    void NodeEditorPanel::SetGraph(std::shared_ptr<Graph> graph_ptr)
+    {
+        m_Graph = graph_ptr;
+        m_CacheGraph = nullptr; // Rebuilt on the next frame
+    }
+
+    void NodeEditorPanel::SetEventChannel(std::shared_ptr<ExecutionEventChannel> channel)
+    {
+        m_EventChannel = channel;
+    }
+
+    void NodeEditorPanel::DrainExecutionEvents()
+    {
+        if (!m_EventChannel)
+            return;
+
+        m_EventChannel->Drain(
+            [this](ExecutionEvent &event)
+            {
+                NodeRunState &state = m_NodeRunStates[event.nodeID];
+                switch (event.kind)
+                {
+                case ExecutionEventKind::Status:
+                    state.status = event.status;
+                    if (event.status == NodeStatus::Queued)
+                    {
+                        state.progress = -1.0f;
+                        state.message.clear();
+                    }
+                    if (!event.message.empty())
+                        state.message = std::move(event.message);
+                    break;
+                case ExecutionEventKind::Progress:
+                    state.progress = event.progress;
+                    break;
+                case ExecutionEventKind::Preview:
+                    state.message = std::move(event.message);
+                    break;
+                }
+            },
+            kMaxEventsPerFrame);
+    }
 
     void NodeEditorPanel::Render()
     {
@@ -51,8 +188,12 @@ namespace MindWeaver
             return;
         }
 
-        ImGui::Begin(m_PanelName.c_str()); // ImGui window for the panel
+        ImGui::Begin(m_PanelName.c_str(), nullptr, ImGuiWindowFlags_MenuBar); // ImGui window for the panel
+
+        DrainExecutionEvents();
+        DrawMenuBar();
 
+        const ImVec2 editor_origin = ImGui::GetCursorScreenPos(); // Screen position of the grid origin
         ImNodes::BeginNodeEditor();
 
         DrawNodes();
@@ -64,51 +205,243 @@ namespace MindWeaver
         HandleLinkCreation();
         HandleLinkDeletion();
         HandleNodeInteraction();
+        DrawNodePalette(editor_origin);
 
         ImGui::End(); // End ImGui window
     }
 
+    void NodeEditorPanel::DrawMenuBar()
+    {
+        if (!ImGui::BeginMenuBar())
+            return;
+        if (ImGui::BeginMenu("Graph"))
+        {
+            if (ImGui::MenuItem("Run", nullptr, false, static_cast<bool>(m_OnRun)))
+                m_OnRun();
+            if (ImGui::MenuItem("Run in Worker Processes", nullptr, false, static_cast<bool>(m_OnRunInProcesses)))
+                m_OnRunInProcesses();
+            ImGui::Separator();
+            if (ImGui::MenuItem("Auto Layout", nullptr, false, static_cast<bool>(m_OnLayout)))
+                m_OnLayout({});
+            const int num_selected_nodes = ImNodes::NumSelectedNodes();
+            if (ImGui::MenuItem("Layout Selection", nullptr, false, m_OnLayout && num_selected_nodes > 1))
+                m_OnLayout(GetSelectedNodeIDs());
+            ImGui::Separator();
+            if (ImGui::MenuItem("Collapse Selection", nullptr, false, num_selected_nodes > 0))
+            {
+                CollapseToSubgraph(*m_Graph, GetSelectedNodeIDs(), "Subgraph");
+                ImNodes::ClearNodeSelection();
+            }
+            if (ImGui::MenuItem("Expand Subgraph", nullptr, false, num_selected_nodes > 0))
+            {
+                for (const UUID &node_id : GetSelectedNodeIDs())
+                    ExpandSubgraph(*m_Graph, node_id);
+                ImNodes::ClearNodeSelection();
+            }
+            ImGui::EndMenu();
+        }
+        if (ImGui::BeginMenu("Stats"))
+        {
+            const bool has_stats = m_ExecutionStats && !m_ExecutionStats->Empty();
+            if (ImGui::MenuItem("No Heatmap", nullptr, !m_ShowHeatmap))
+                m_ShowHeatmap = false;
+            for (size_t i = 0; i < kNodeMetricCount; ++i)
+            {
+                const NodeMetric metric = static_cast<NodeMetric>(i);
+                if (ImGui::MenuItem(GetNodeMetricName(metric), nullptr, m_ShowHeatmap && m_HeatmapMetric == metric,
+                                    has_stats))
+                {
+                    m_ShowHeatmap = true;
+                    m_HeatmapMetric = metric;
+                    m_HeatmapMax = m_ExecutionStats->GetMax(metric);
+                }
+            }
+            ImGui::Separator();
+            const bool can_export = has_stats && static_cast<bool>(m_OnExportStats);
+            if (ImGui::MenuItem("Export as CSV", nullptr, false, can_export))
+                m_OnExportStats(false);
+            if (ImGui::MenuItem("Export as JSON", nullptr, false, can_export))
+                m_OnExportStats(true);
+            ImGui::EndMenu();
+        }
+        ImGui::EndMenuBar();
+    }
+
+    void NodeEditorPanel::SetExecutionStats(std::shared_ptr<const ExecutionStats> stats)
+    {
+        m_ExecutionStats = std::move(stats);
+        m_HeatmapMax = m_ExecutionStats ? m_ExecutionStats->GetMax(m_HeatmapMetric) : 0.0;
+    }
+
+    std::vector<UUID> NodeEditorPanel::GetSelectedNodeIDs() const
+    {
+        std::vector<UUID> selected_ids;
+        const int num_selected_nodes = ImNodes::NumSelectedNodes();
+        // Selection IDs are matched through the draw cache, which must describe the current nodes
+        if (num_selected_nodes <= 0 || m_CacheGraph != m_Graph.get() ||
+            m_CacheTopologyVersion != m_Graph->GetTopologyVersion())
+            return selected_ids;
+
+        std::vector<int> selected(num_selected_nodes);
+        ImNodes::GetSelectedNodes(selected.data());
+        std::sort(selected.begin(), selected.end());
+        size_t node_index = 0;
+        for (const auto &backend_node : m_Graph->GetNodes())
+        {
+            const int node_imnodes_id = m_NodeCache[node_index++].imnodesID;
+            if (backend_node && !backend_node->placeholder &&
+                std::binary_search(selected.begin(), selected.end(), node_imnodes_id))
+                selected_ids.push_back(backend_node->id);
+        }
+        return selected_ids;
+    }
+
     void NodeEditorPanel::DrawNodes()
     {
         if (!m_Graph)
             return;
+        RefreshDrawCache();
+
+        // Placeholders of a lazily loaded graph are loaded once they scroll into view
+        const ImVec2 panning = ImNodes::EditorContextGetPanning();
+        const ImVec2 window_size = ImGui::GetWindowSize();
+        const float min_x = -panning.x - kMaterializeMargin, max_x = -panning.x + window_size.x + kMaterializeMargin;
+        const float min_y = -panning.y - kMaterializeMargin, max_y = -panning.y + window_size.y + kMaterializeMargin;
+        auto is_visible = [&](const Node &node)
+        {
+            return node.position.x >= min_x && node.position.x <= max_x && node.position.y >= min_y &&
+                   node.position.y <= max_y;
+        };
+        std::vector<uint32_t> to_materialize;
+        uint32_t index = 0;
+        for (const auto &backend_node : m_Graph->GetNodes())
+        {
+            if (backend_node && backend_node->placeholder && is_visible(*backend_node))
+            {
+                to_materialize.push_back(index);
+                if (to_materialize.size() == kMaxMaterializedPerFrame)
+                    break;
+            }
+            ++index;
+        }
+        if (!to_materialize.empty())
+            CacheMaterializedNodes(to_materialize);
 
         const auto &nodes = m_Graph->GetNodes();
+        size_t node_index = 0;
         for (const auto &backend_node : nodes)
         {
-            if (!backend_node)
+            NodeDrawCache &cached = m_NodeCache[node_index++];
+            if (!backend_node || backend_node->placeholder)
                 continue;
 
-            const int node_imnodes_id = GetImNodeID(backend_node->id);
+            const int node_imnodes_id = cached.imnodesID;
             ImNodes::SetNodeGridSpacePos(node_imnodes_id, ImVec2(backend_node->position.x, backend_node->position.y));
 
+            const NodeRunState *run_state = nullptr;
+            auto state_it = m_NodeRunStates.find(backend_node->id);
+            if (state_it != m_NodeRunStates.end())
+                run_state = &state_it->second;
+
+            unsigned int title_color = 0, title_highlight = 0;
+            bool has_status_color = run_state && GetStatusColors(run_state->status, title_color, title_highlight);
+            if (!has_status_color && backend_node->subgraph)
+            {
+                // Subgraph nodes stand out unless a run status is shown
+                title_color = IM_COL32(95, 70, 130, 255);
+                title_highlight = IM_COL32(120, 90, 165, 255);
+                has_status_color = true;
+            }
+            if (has_status_color)
+            {
+                ImNodes::PushColorStyle(ImNodesCol_TitleBar, title_color);
+                ImNodes::PushColorStyle(ImNodesCol_TitleBarHovered, title_highlight);
+                ImNodes::PushColorStyle(ImNodesCol_TitleBarSelected, title_highlight);
+            }
+
+            // Heatmap: the body is colored by the node's share of the hottest value, on a log scale
+            // so that nodes orders of magnitude apart stay distinguishable. Executors record the
+            // samples of inlined and merged nodes under the node shown here (PlannedNode::reportID)
+            const NodeStats *stats =
+                m_ShowHeatmap && m_ExecutionStats ? m_ExecutionStats->Find(backend_node->id) : nullptr;
+            if (stats)
+            {
+                const double value = stats->Get(m_HeatmapMetric);
+                const float heat =
+                    m_HeatmapMax > 0.0 ? static_cast<float>(std::log1p(value) / std::log1p(m_HeatmapMax)) : 0.0f;
+                ImNodes::PushColorStyle(ImNodesCol_NodeBackground, GetHeatColor(heat));
+                ImNodes::PushColorStyle(ImNodesCol_NodeBackgroundHovered, GetHeatColor(heat, 25));
+                ImNodes::PushColorStyle(ImNodesCol_NodeBackgroundSelected, GetHeatColor(heat, 25));
+            }
+
             ImNodes::BeginNode(node_imnodes_id);
 
             ImNodes::BeginNodeTitleBar();
             ImGui::TextUnformatted(backend_node->name.c_str());
+            if (run_state && run_state->status == NodeStatus::Running && run_state->progress >= 0.0f)
+                ImGui::ProgressBar(run_state->progress, ImVec2(120.0f, 0.0f));
             ImNodes::EndNodeTitleBar();
 
+            size_t pin_index = 0;
             for (const auto &pair : backend_node->inputPins)
             {
                 const auto &pin = pair.second;
+                const int pin_imnodes_id = cached.inputPinIDs[pin_index++];
                 if (!pin)
                     continue;
-                ImNodes::BeginInputAttribute(GetImNodeID(pin->id));
+                ImNodes::BeginInputAttribute(pin_imnodes_id);
                 ImGui::TextUnformatted(pin->name.c_str());
                 ImNodes::EndInputAttribute();
             }
 
+            pin_index = 0;
             for (const auto &pair : backend_node->outputPins)
             {
                 const auto &pin = pair.second;
+                const int pin_imnodes_id = cached.outputPinIDs[pin_index++];
                 if (!pin)
                     continue;
-                ImNodes::BeginOutputAttribute(GetImNodeID(pin->id));
+                ImNodes::BeginOutputAttribute(pin_imnodes_id);
                 ImGui::TextUnformatted(pin->name.c_str());
                 ImNodes::EndOutputAttribute();
             }
 
+            if (run_state && !run_state->message.empty())
+            {
+                ImGui::PushTextWrapPos(ImGui::GetCursorPosX() + 200.0f);
+                ImGui::TextUnformatted(run_state->message.c_str());
+                ImGui::PopTextWrapPos();
+            }
+            if (stats)
+                ImGui::TextUnformatted(FormatMetric(m_HeatmapMetric, stats->Get(m_HeatmapMetric)).c_str());
+
             ImNodes::EndNode();
+
+            // Links are only re-measured when one of their nodes moved or changed size
+            const ImVec2 size = ImNodes::GetNodeDimensions(node_imnodes_id);
+            if (cached.x != backend_node->position.x || cached.y != backend_node->position.y ||
+                cached.width != size.x || cached.height != size.y)
+            {
+                cached.x = backend_node->position.x;
+                cached.y = backend_node->position.y;
+                cached.width = size.x;
+                cached.height = size.y;
+                for (uint32_t link_index : cached.links)
+                    UpdateLinkBounds(m_LinkCache[link_index]);
+            }
+
+            if (stats)
+            {
+                ImNodes::PopColorStyle();
+                ImNodes::PopColorStyle();
+                ImNodes::PopColorStyle();
+            }
+            if (has_status_color)
+            {
+                ImNodes::PopColorStyle();
+                ImNodes::PopColorStyle();
+                ImNodes::PopColorStyle();
+            }
         }
     }
 
@@ -117,14 +450,159 @@ namespace MindWeaver
         if (!m_Graph)
             return;
 
-        const auto &links = m_Graph->GetLinks();
-        for (const auto &backend_link : links)
+        // Only links whose curve can reach the visible area are submitted
+        const ImVec2 panning = ImNodes::EditorContextGetPanning();
+        const ImVec2 window_size = ImGui::GetWindowSize();
+        const float min_x = -panning.x, max_x = -panning.x + window_size.x;
+        const float min_y = -panning.y, max_y = -panning.y + window_size.y;
+        for (const LinkDrawCache &link : m_LinkCache)
         {
-            if (!backend_link)
+            if (link.maxX < min_x || link.minX > max_x || link.maxY < min_y || link.minY > max_y)
                 continue;
-            ImNodes::Link(GetImNodeID(backend_link->id), GetImNodeID(backend_link->startPinID),
-                          GetImNodeID(backend_link->endPinID));
+            ImNodes::Link(link.imnodesID, link.startPinID, link.endPinID);
+        }
+    }
+
+    void NodeEditorPanel::RefreshDrawCache()
+    {
+        if (m_CacheGraph == m_Graph.get() && m_CacheTopologyVersion == m_Graph->GetTopologyVersion())
+            return;
+
+        // IDs of objects that were already cached are reused instead of hashed again
+        const std::unordered_map<UUID, int> previous_ids = std::move(m_ImNodeIDs);
+        m_ImNodeIDs.clear();
+        m_ImNodeIDs.reserve(previous_ids.size());
+
+        const auto &nodes = m_Graph->GetNodes();
+        m_NodeCache.assign(nodes.size(), NodeDrawCache());
+        m_PinOwners.clear();
+        uint32_t node_index = 0;
+        for (const auto &backend_node : nodes)
+        {
+            if (backend_node && !backend_node->placeholder)
+                CacheNode(node_index, *backend_node, &previous_ids);
+            ++node_index;
+        }
+
+        m_LinkCache.clear();
+        m_LinkCache.reserve(m_Graph->GetLinks().size());
+        for (const auto &backend_link : m_Graph->GetLinks())
+        {
+            if (backend_link)
+                CacheLink(*backend_link, &previous_ids);
+        }
+
+        // Forget the run state of removed nodes (and of every node when the graph was replaced)
+        for (auto it = m_NodeRunStates.begin(); it != m_NodeRunStates.end();)
+        {
+            if (m_CacheGraph == m_Graph.get() && m_Graph->GetNode(it->first))
+                ++it;
+            else
+                it = m_NodeRunStates.erase(it);
         }
+
+        m_CacheGraph = m_Graph.get();
+        m_CacheTopologyVersion = m_Graph->GetTopologyVersion();
+    }
+
+    void NodeEditorPanel::CacheMaterializedNodes(const std::vector<uint32_t> &node_indices)
+    {
+        // Loading a placeholder changes no topology: only its entry and the links reaching it
+        // (now that its pins are known) are added to the cache
+        std::unordered_set<UUID> new_pins;
+        const auto &nodes = m_Graph->GetNodes();
+        for (uint32_t node_index : node_indices)
+        {
+            if (!m_Graph->MaterializeNode(nodes[node_index]->id))
+                continue;
+            const auto &backend_node = nodes[node_index];
+            CacheNode(node_index, *backend_node, nullptr);
+            for (const auto &pair : backend_node->inputPins)
+                new_pins.insert(pair.first);
+            for (const auto &pair : backend_node->outputPins)
+                new_pins.insert(pair.first);
+        }
+        if (new_pins.empty())
+            return;
+
+        for (const auto &backend_link : m_Graph->GetLinks())
+        {
+            if (backend_link && (new_pins.count(backend_link->startPinID) || new_pins.count(backend_link->endPinID)))
+                CacheLink(*backend_link, nullptr);
+        }
+    }
+
+    int NodeEditorPanel::CacheImNodeID(const UUID &uuid, const std::unordered_map<UUID, int> *previous_ids)
+    {
+        auto it = m_ImNodeIDs.find(uuid);
+        if (it != m_ImNodeIDs.end())
+            return it->second;
+        int id = 0;
+        if (previous_ids && previous_ids->count(uuid))
+            id = previous_ids->at(uuid);
+        else
+            id = GetImNodeID(uuid);
+        m_ImNodeIDs.emplace(uuid, id);
+        return id;
+    }
+
+    void NodeEditorPanel::CacheNode(uint32_t node_index, const Node &node,
+                                    const std::unordered_map<UUID, int> *previous_ids)
+    {
+        NodeDrawCache &cached = m_NodeCache[node_index];
+        cached.imnodesID = CacheImNodeID(node.id, previous_ids);
+        cached.inputPinIDs.reserve(node.inputPins.size());
+        for (const auto &pair : node.inputPins)
+        {
+            cached.inputPinIDs.push_back(pair.second ? CacheImNodeID(pair.first, previous_ids) : 0);
+            m_PinOwners.emplace(pair.first, node_index);
+        }
+        cached.outputPinIDs.reserve(node.outputPins.size());
+        for (const auto &pair : node.outputPins)
+        {
+            cached.outputPinIDs.push_back(pair.second ? CacheImNodeID(pair.first, previous_ids) : 0);
+            m_PinOwners.emplace(pair.first, node_index);
+        }
+        // Geometry is taken from the node's position until it has been drawn once
+        cached.x = node.position.x;
+        cached.y = node.position.y;
+    }
+
+    void NodeEditorPanel::CacheLink(const Link &link, const std::unordered_map<UUID, int> *previous_ids)
+    {
+        // Links into nodes that are not loaded yet have no attribute to attach to
+        auto start_it = m_PinOwners.find(link.startPinID);
+        auto end_it = m_PinOwners.find(link.endPinID);
+        if (start_it == m_PinOwners.end() || end_it == m_PinOwners.end())
+            return;
+
+        LinkDrawCache cached;
+        cached.imnodesID = CacheImNodeID(link.id, previous_ids);
+        cached.startPinID = CacheImNodeID(link.startPinID, previous_ids);
+        cached.endPinID = CacheImNodeID(link.endPinID, previous_ids);
+        cached.startNode = start_it->second;
+        cached.endNode = end_it->second;
+        UpdateLinkBounds(cached);
+
+        const uint32_t link_index = static_cast<uint32_t>(m_LinkCache.size());
+        m_NodeCache[cached.startNode].links.push_back(link_index);
+        if (cached.endNode != cached.startNode)
+            m_NodeCache[cached.endNode].links.push_back(link_index);
+        m_LinkCache.push_back(cached);
+    }
+
+    void NodeEditorPanel::UpdateLinkBounds(LinkDrawCache &link) const
+    {
+        // The curve stays within both node rectangles, widened by how far its tangents reach out
+        const NodeDrawCache &start = m_NodeCache[link.startNode];
+        const NodeDrawCache &end = m_NodeCache[link.endNode];
+        link.minX = std::min(start.x, end.x);
+        link.minY = std::min(start.y, end.y);
+        link.maxX = std::max(start.x + start.width, end.x + end.width);
+        link.maxY = std::max(start.y + start.height, end.y + end.height);
+        const float reach = kLinkTangentFactor * std::hypot(link.maxX - link.minX, link.maxY - link.minY);
+        link.minX -= reach;
+        link.maxX += reach;
     }
 
     void NodeEditorPanel::HandleLinkCreation()
@@ -206,7 +684,7 @@ namespace MindWeaver
             {
                 // TODO: Add validation (e.g., type compatibility, prevent input-to-input)
                 MindWeaver::UUID new_link_uuid = MindWeaver::UUID::generate();
-                m_Graph->AddLink(std::make_shared<MindWeaver::Link>(new_link_uuid, start_pin_uuid, end_pin_uuid));
+                m_Graph->AddLink(m_Graph->CreateLink(new_link_uuid, start_pin_uuid, end_pin_uuid));
                 std::cout << "Link created in backend: " << new_link_uuid.to_string() << std::endl;
             }
             else
@@ -250,6 +728,73 @@ namespace MindWeaver
         }
     }
 
+    void NodeEditorPanel::DrawNodePalette(const ImVec2 &editor_origin)
+    {
+        if (!m_NodeCatalog || !m_Graph)
+            return;
+
+        const bool editor_hovered = ImNodes::IsEditorHovered();
+        if (editor_hovered && (ImGui::IsMouseReleased(1) || ImGui::IsKeyPressed(ImGuiKey_Tab, false)))
+        {
+            // The new node goes where the palette was opened
+            const ImVec2 mouse = ImGui::GetMousePos();
+            const ImVec2 panning = ImNodes::EditorContextGetPanning();
+            m_PaletteGridX = mouse.x - editor_origin.x - panning.x;
+            m_PaletteGridY = mouse.y - editor_origin.y - panning.y;
+            m_PaletteQuery[0] = '\0';
+            m_PaletteSelection = 0;
+            ImGui::OpenPopup(kPalettePopup);
+        }
+
+        if (!ImGui::BeginPopup(kPalettePopup))
+            return;
+
+        if (ImGui::IsWindowAppearing())
+            ImGui::SetKeyboardFocusHere();
+        const bool submitted = ImGui::InputText("##Search", m_PaletteQuery, sizeof(m_PaletteQuery),
+                                                ImGuiInputTextFlags_EnterReturnsTrue);
+
+        // Searched every frame: the trigram index only visits entries sharing trigrams with the query.
+        // Before anything is typed the palette lists the catalog
+        const std::vector<const NodeCatalogEntry *> results = m_NodeCatalog->Search(m_PaletteQuery, kMaxPaletteResults);
+        const int result_count = static_cast<int>(results.size());
+        const int previous_selection = m_PaletteSelection;
+        if (ImGui::IsKeyPressed(ImGuiKey_DownArrow))
+            ++m_PaletteSelection;
+        if (ImGui::IsKeyPressed(ImGuiKey_UpArrow))
+            --m_PaletteSelection;
+        m_PaletteSelection = result_count == 0 ? 0 : std::clamp(m_PaletteSelection, 0, result_count - 1);
+        const bool selection_moved = m_PaletteSelection != previous_selection;
+
+        const NodeCatalogEntry *chosen = submitted && result_count > 0 ? results[m_PaletteSelection] : nullptr;
+        if (m_PaletteQuery[0] != '\0' && result_count == 0)
+            ImGui::TextDisabled("No matching node types");
+        for (int i = 0; i < result_count; ++i)
+        {
+            const NodeCatalogEntry &entry = *results[i];
+            ImGui::PushID(i);
+            if (ImGui::Selectable(entry.name.c_str(), i == m_PaletteSelection))
+                chosen = &entry;
+            if (i == m_PaletteSelection && selection_moved)
+                ImGui::SetScrollHereY();
+            if (!entry.category.empty())
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("%s", entry.category.c_str());
+            }
+            ImGui::PopID();
+        }
+
+        if (chosen)
+        {
+            std::shared_ptr<Node> node = chosen->create(m_Graph->GetPool());
+            node->position = Position(m_PaletteGridX, m_PaletteGridY);
+            m_Graph->AddNode(std::move(node));
+            ImGui::CloseCurrentPopup();
+        }
+        ImGui::EndPopup();
+    }
+
     void NodeEditorPanel::HandleNodeInteraction()
     {
         if (!m_Graph)
@@ -273,8 +818,8 @@ namespace MindWeaver
                         if (backend_node_ptr->position.x != current_imnodes_pos.x ||
                             backend_node_ptr->position.y != current_imnodes_pos.y)
                         {
-                            backend_node_ptr->SetPosition(
-                                MindWeaver::Position(current_imnodes_pos.x, current_imnodes_pos.y));
+                            m_Graph->SetNodePosition(backend_node_ptr->id, MindWeaver::Position(current_imnodes_pos.x,
+                                                                                                current_imnodes_pos.y));
                             // std::cout << "Backend Node " << backend_node_ptr->name << " position updated." << std::endl;
                         }
                         break;
@@ -0,0 +1,408 @@
+// Autosave: saving and recovering a graph, torn logs, unrecoverable files and older formats, and
+// how much of a lazily opened graph gets loaded.
+
+#undef NDEBUG
+#include "core/Graph.h"
+#include "core/NodeSource.h"
+#include "io/BinaryStream.h"
+#include "io/GraphAutosave.h"
+#include "io/GraphFile.h"
+#include "io/LazyGraphFile.h"
+#include "io/MutationLog.h"
+#include "runtime/GraphOptimizer.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace MindWeaver;
+
+namespace
+{
+    std::string TempPath(const char *name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+    void RemoveAutosave(const std::string &path)
+    {
+        for (const char *suffix : {"", ".log", ".corrupt", ".log.corrupt"})
+            std::remove((path + suffix).c_str());
+    }
+
+    std::shared_ptr<Node> AddNumber(Graph &graph, const char *value)
+    {
+        auto node = graph.CreateNode(UUID::generate(), "Number", NodeType::Function);
+        node->AddOutputPin("value", PinType::Float);
+        node->SetParameter("value", value);
+        graph.AddNode(node);
+        return node;
+    }
+
+    std::shared_ptr<Node> AddSum(Graph &graph)
+    {
+        auto node = graph.CreateNode(UUID::generate(), "Add", NodeType::Operator);
+        node->AddInputPin("a", PinType::Float);
+        node->AddInputPin("b", PinType::Float);
+        node->AddOutputPin("result", PinType::Float);
+        graph.AddNode(node);
+        return node;
+    }
+
+    UUID PinID(const Node &node, const char *name)
+    {
+        for (const auto &pair : node.inputPins)
+            if (pair.second->name == Symbol(name))
+                return pair.first;
+        for (const auto &pair : node.outputPins)
+            if (pair.second->name == Symbol(name))
+                return pair.first;
+        assert(false && "no such pin");
+        return UUID();
+    }
+
+    std::string ReadBytes(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    uint32_t Fnv1a(const std::string &bytes, size_t start)
+    {
+        uint32_t h = 2166136261u;
+        for (size_t i = start; i < bytes.size(); ++i)
+        {
+            h ^= static_cast<uint8_t>(bytes[i]);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    void TestRoundTrip()
+    {
+        const std::string path = TempPath("mindweaver_autosave_test.mwgraph");
+        RemoveAutosave(path);
+
+        Graph graph("Saved");
+        auto a = AddNumber(graph, "1");
+        auto b = AddNumber(graph, "2");
+        auto sum = AddSum(graph);
+        {
+            AutosaveOptions options;
+            options.flushInterval = std::chrono::milliseconds(1);
+            GraphAutosave autosave(path, options);
+            autosave.Attach(graph);
+
+            // Edits after attaching go to the log
+            graph.AddLink(graph.CreateLink(UUID::generate(), PinID(*a, "value"), PinID(*sum, "a")));
+            graph.AddLink(graph.CreateLink(UUID::generate(), PinID(*b, "value"), PinID(*sum, "b")));
+            graph.SetNodePosition(sum->id, Position{10.0f, 20.0f});
+            graph.SetNodeParameter(b->id, "value", "5");
+            auto extra = AddNumber(graph, "3");
+            graph.RemoveNode(extra->id);
+            autosave.Flush();
+            autosave.Detach();
+        }
+
+        assert(GraphAutosave::Exists(path));
+        const GraphSnapshot recovered = GraphAutosave::Recover(path);
+        assert(recovered.name == "Saved");
+        assert(recovered.nodes.size() == 3 && recovered.links.size() == 2);
+        const auto moved = recovered.Resolve(recovered.nodes[2]);
+        assert(moved->id == sum->id && moved->position.x == 10.0f && moved->position.y == 20.0f);
+        assert(recovered.Resolve(recovered.nodes[1])->parameters.at("value") == "5");
+
+        // A torn record at the end of the log (a crash mid-write) is ignored
+        {
+            std::ofstream log(path + ".log", std::ios::binary | std::ios::app);
+            log.write("\x01\x02\x03", 3);
+        }
+        const GraphSnapshot torn = GraphAutosave::Recover(path);
+        assert(torn.nodes.size() == 3 && torn.links.size() == 2);
+
+        RemoveAutosave(path);
+    }
+
+    void TestResume()
+    {
+        const std::string path = TempPath("mindweaver_autosave_resume.mwgraph");
+        RemoveAutosave(path);
+        AutosaveOptions options;
+        options.flushInterval = std::chrono::milliseconds(1);
+
+        Graph graph("Resumed");
+        auto a = AddNumber(graph, "1");
+        auto b = AddNumber(graph, "2");
+        {
+            GraphAutosave autosave(path, options);
+            autosave.Attach(graph);
+            graph.SetNodeParameter(a->id, "value", "4");
+            autosave.Flush();
+        }
+        {
+            std::ofstream log(path + ".log", std::ios::binary | std::ios::app);
+            log.write("\x01\x02\x03", 3);
+        }
+        const std::string base = ReadBytes(path);
+
+        // Attaching the recovered graph keeps the base file, and new edits follow the intact records
+        Graph recovered(GraphAutosave::Recover(path));
+        assert(recovered.GetNode(b->id)->placeholder);
+        {
+            GraphAutosave autosave(path, options);
+            autosave.Attach(recovered, true);
+            recovered.SetNodeParameter(b->id, "value", "5");
+            autosave.Flush();
+        }
+        assert(ReadBytes(path) == base);
+
+        const GraphSnapshot again = GraphAutosave::Recover(path);
+        assert(again.nodes.size() == 2);
+        assert(again.Resolve(again.nodes[0])->parameters.at("value") == "4");
+        assert(again.Resolve(again.nodes[1])->parameters.at("value") == "5");
+        RemoveAutosave(path);
+    }
+
+    // Forwards to the source of a lazily opened file, counting the nodes loaded through it
+    class CountingSource : public NodeSource
+    {
+    public:
+        explicit CountingSource(std::shared_ptr<const NodeSource> source) : m_Source(std::move(source)) {}
+
+        std::shared_ptr<const Node> Load(const Node &placeholder) const override
+        {
+            ++loads;
+            return m_Source->Load(placeholder);
+        }
+
+        bool Outline(const Node &placeholder, NodeOutline &outline) const override
+        {
+            return m_Source->Outline(placeholder, outline);
+        }
+
+        mutable size_t loads = 0;
+
+    private:
+        std::shared_ptr<const NodeSource> m_Source;
+    };
+
+    void TestTargetedPlanStaysLazy()
+    {
+        const std::string path = TempPath("mindweaver_lazy_plan.mwgraph");
+        Graph graph("Lazy");
+        auto a = AddNumber(graph, "1");
+        auto b = AddNumber(graph, "2");
+        auto sum = AddSum(graph);
+        graph.AddLink(graph.CreateLink(UUID::generate(), PinID(*a, "value"), PinID(*sum, "a")));
+        graph.AddLink(graph.CreateLink(UUID::generate(), PinID(*b, "value"), PinID(*sum, "b")));
+        AddNumber(graph, "3");
+        AddNumber(graph, "4");
+        WriteGraphFile(path, graph.Snapshot());
+
+        GraphSnapshot lazy = OpenGraphFileLazily(path);
+        auto source = std::make_shared<CountingSource>(lazy.nodeSource);
+        lazy.nodeSource = source;
+        KernelRegistry registry;
+        registry.Register("Number", [](ExecutionContext &context) { context.SetOutput("value", 1.0); });
+        registry.Register("Add", [](ExecutionContext &context) { context.SetOutput("result", 2.0); });
+
+        // Only the sum and the numbers feeding it are loaded for a run that wants the sum
+        ExecutionRequest request;
+        request.targetPins = {PinID(*sum, "result")};
+        assert(PrepareExecutionPlan(lazy, registry, request).nodes.size() == 3);
+        assert(source->loads == 3);
+
+        assert(PrepareExecutionPlan(lazy, registry, ExecutionRequest{}).nodes.size() == 5);
+        assert(source->loads == 8);
+        RemoveAutosave(path);
+    }
+
+    void TestSetAside()
+    {
+        const std::string path = TempPath("mindweaver_autosave_corrupt.mwgraph");
+        RemoveAutosave(path);
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "not a graph file";
+            std::ofstream log(path + ".log", std::ios::binary);
+            log << "nor a log";
+        }
+
+        bool threw = false;
+        try
+        {
+            GraphAutosave::Recover(path);
+        }
+        catch (const std::runtime_error &)
+        {
+            threw = true;
+        }
+        assert(threw);
+
+        const std::string moved = GraphAutosave::SetAside(path);
+        assert(moved == path + ".corrupt");
+        assert(!std::filesystem::exists(path) && !std::filesystem::exists(path + ".log"));
+        assert(std::filesystem::exists(path + ".corrupt") && std::filesystem::exists(path + ".log.corrupt"));
+        assert(!GraphAutosave::Exists(path));
+
+        RemoveAutosave(path);
+    }
+
+    // Writes a one-node, one-link graph file the way format 1 (names inline, no symbol table) or
+    // format 2 (symbol table, no subgraph flag) did; input_count overrides the node's pin count
+    void WriteOldGraphFile(const std::string &path, uint32_t version, const UUID &node_id, const UUID &pin_id,
+                           uint64_t file_id, uint32_t input_count = 1)
+    {
+        BinaryWriter out;
+        out.Write<uint32_t>(GraphFileHeader::kMagic);
+        out.Write<uint32_t>(version);
+        out.Write<uint64_t>(file_id);
+        out.Write<uint64_t>(7); // Graph version
+        out.Write<uint64_t>(1); // Nodes
+        out.Write<uint64_t>(1); // Links
+        const size_t offsets = out.Skip(8 * (version >= 2 ? 3 : 2));
+        out.WriteString("Old");
+
+        const size_t table = out.Size();
+        out.Skip(sizeof(NodeTableEntry));
+        const size_t record = out.Size();
+        if (version >= 2)
+            out.Write<uint32_t>(0); // Symbol "Add"
+        else
+            out.WriteString("Add");
+        out.Write<uint32_t>(1);
+        out.WriteString("k");
+        out.WriteString("v");
+        out.Write<uint32_t>(input_count);
+        out.WriteUUID(pin_id);
+        out.Write<uint8_t>(static_cast<uint8_t>(PinType::Int));
+        if (version >= 2)
+            out.Write<uint32_t>(1); // Symbol "a"
+        else
+            out.WriteString("a");
+        out.Write<uint32_t>(0);
+
+        NodeTableEntry entry{};
+        std::memcpy(entry.id, node_id.data(), 16);
+        entry.type = static_cast<uint32_t>(NodeType::Operator);
+        entry.x = 1.0f;
+        entry.y = 2.0f;
+        entry.recordOffset = record;
+        entry.recordSize = out.Size() - record;
+        out.Patch(table, entry);
+
+        const uint64_t links = out.Size();
+        LinkRecord link{};
+        std::memcpy(link.id, UUID::generate().data(), 16);
+        std::memcpy(link.startPinID, pin_id.data(), 16);
+        std::memcpy(link.endPinID, pin_id.data(), 16);
+        out.Write(link);
+
+        const uint64_t symbols = out.Size();
+        if (version >= 2)
+        {
+            out.Write<uint32_t>(2);
+            out.WriteString("Add");
+            out.WriteString("a");
+        }
+        out.Patch(offsets, static_cast<uint64_t>(table));
+        out.Patch(offsets + 8, links);
+        if (version >= 2)
+            out.Patch(offsets + 16, symbols);
+        WriteFileAtomically(path, out.Bytes());
+    }
+
+    // Appends one AddNode record in the given format to a fresh mutation log
+    void WriteOldMutationLog(const std::string &path, uint32_t version, uint64_t file_id, const UUID &added)
+    {
+        BinaryWriter log;
+        log.Write<uint32_t>(MutationLogHeader::kMagic);
+        log.Write<uint32_t>(version);
+        log.Write<uint64_t>(file_id);
+        const size_t frame = log.Skip(8);
+        const size_t start = log.Size();
+        log.Write<uint8_t>(static_cast<uint8_t>(GraphMutationKind::AddNode));
+        log.Write<uint64_t>(8);
+        log.WriteUUID(added);
+        log.Write<uint32_t>(static_cast<uint32_t>(NodeType::Function));
+        log.Write(3.0f);
+        log.Write(4.0f);
+        if (version >= 2)
+        {
+            log.Write<uint32_t>(1);
+            log.WriteString("Late");
+            log.Write<uint32_t>(0);
+        }
+        else
+            log.WriteString("Late");
+        log.Write<uint32_t>(0);
+        log.Write<uint32_t>(0);
+        log.Write<uint32_t>(0);
+        log.Patch(frame, static_cast<uint32_t>(log.Size() - start));
+        log.Patch(frame + 4, Fnv1a(log.Bytes(), start));
+        WriteFileAtomically(path, log.Bytes());
+    }
+
+    void TestOlderFormats()
+    {
+        const std::string path = TempPath("mindweaver_autosave_old.mwgraph");
+        for (uint32_t version = 1; version <= 2; ++version)
+        {
+            RemoveAutosave(path);
+            const UUID node_id = UUID::generate();
+            const UUID pin_id = UUID::generate();
+            WriteOldGraphFile(path, version, node_id, pin_id, 42);
+
+            uint64_t file_id = 0;
+            const GraphSnapshot file = ReadGraphFile(path, &file_id);
+            assert(file_id == 42 && file.name == "Old" && file.nodes.size() == 1 && file.links.size() == 1);
+            const auto &node = file.nodes[0];
+            assert(node->id == node_id && node->name.str() == "Add" && !node->subgraph);
+            assert(node->parameters.at("k") == "v" && node->position.y == 2.0f);
+            assert(node->inputPins.size() == 1 && node->inputPins.begin()->second->name.str() == "a");
+
+            const UUID added = UUID::generate();
+            WriteOldMutationLog(path + ".log", version, 42, added);
+            const GraphSnapshot recovered = GraphAutosave::Recover(path);
+            assert(recovered.nodes.size() == 2);
+            assert(recovered.Resolve(recovered.nodes[0])->name.str() == "Add");
+            const auto late = recovered.Resolve(recovered.nodes[1]);
+            assert(late->id == added && late->name.str() == "Late");
+        }
+        RemoveAutosave(path);
+    }
+
+    void TestCorruptCounts()
+    {
+        // A pin count the record cannot hold is rejected before anything is reserved for it
+        const std::string path = TempPath("mindweaver_autosave_counts.mwgraph");
+        WriteOldGraphFile(path, 2, UUID::generate(), UUID::generate(), 42, 0xFFFFFFFFu);
+        bool threw = false;
+        try
+        {
+            ReadGraphFile(path);
+        }
+        catch (const std::runtime_error &e)
+        {
+            threw = std::string(e.what()) == "Corrupt pin count";
+        }
+        assert(threw);
+        RemoveAutosave(path);
+    }
+} // namespace
+
+int main()
+{
+    TestRoundTrip();
+    TestResume();
+    TestTargetedPlanStaysLazy();
+    TestSetAside();
+    TestOlderFormats();
+    TestCorruptCounts();
+    std::printf("AutosaveTest passed\n");
+    return 0;
+}
@@ -0,0 +1,191 @@
+// Values and binary operators: storage of each kind, the generated operator tables, and how the
+// planner resolves operators from the kinds connected to them.
+
+#undef NDEBUG
+#include "core/Graph.h"
+#include "runtime/BuiltinNodes.h"
+#include "runtime/Executor.h"
+#include "runtime/Value.h"
+
+#include <cassert>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+using namespace MindWeaver;
+
+namespace
+{
+    struct Point
+    {
+        int x = 0;
+    };
+
+    template <typename Fn> bool Throws(Fn fn, const char *expected = nullptr)
+    {
+        try
+        {
+            fn();
+        }
+        catch (const std::runtime_error &e)
+        {
+            return !expected || std::string(e.what()).find(expected) != std::string::npos;
+        }
+        return false;
+    }
+
+    void TestValue()
+    {
+        assert(sizeof(Value) == 24);
+
+        Value empty;
+        assert(!empty.HasValue() && empty.GetKind() == ValueKind::Empty);
+        assert(Value(true).GetBool());
+        const Value integer(42);
+        assert(integer.GetKind() == ValueKind::Int && integer.Get<int>() == 42 && integer.To<double>() == 42.0);
+        assert(Value(2.5f).GetFloat() == 2.5);
+
+        // Strings up to the inline capacity and beyond
+        const Value short_string("hello");
+        assert(short_string.GetString() == "hello");
+        const std::string inline_text(Value::kInlineStringCapacity, 'a');
+        assert(Value(inline_text).GetString() == inline_text);
+        const std::string heap_text(100, 'x');
+        Value heap(heap_text);
+        Value copy = heap;
+        Value moved = std::move(copy);
+        assert(moved.GetString() == heap_text && !copy.HasValue() && heap.GetString() == heap_text);
+
+        const Value vector(FloatVector{1.0, 2.0, 3.0});
+        const Value vector_copy = vector;
+        assert(&vector_copy.GetVector() == &vector.GetVector()); // Shared, not copied
+        assert(Value(Buffer{}).GetKind() == ValueKind::Buffer);
+
+        const Value object(Point{7});
+        assert(object.GetKind() == ValueKind::Object && object.GetObject<Point>()->x == 7);
+        assert(object.Get<Point>().x == 7 && !object.GetObject<int>());
+
+        assert(Throws([&] { short_string.GetInt(); }, "Expected a value of kind Int, got String"));
+        assert(Throws([&] { integer.Get<Point>(); }));
+        assert(Throws([&] { short_string.To<double>(); }));
+    }
+
+    template <typename Kind> Value Evaluate(const Value &a, const Value &b)
+    {
+        Value out;
+        Kind::Evaluate(a, b, out);
+        return out;
+    }
+
+    void TestOperatorTables()
+    {
+        const BinaryOperatorTable &add = AddNode::GetTable();
+        assert(add.Find(ValueKind::Int, ValueKind::Int).result == ValueKind::Int);
+        assert(add.Find(ValueKind::Bool, ValueKind::Float).result == ValueKind::Float);
+        assert(add.Find(ValueKind::Vector, ValueKind::Int).result == ValueKind::Vector);
+        assert(add.Find(ValueKind::String, ValueKind::String).result == ValueKind::String);
+        assert(!add.Find(ValueKind::String, ValueKind::Int).apply);
+        assert(!add.Find(ValueKind::Buffer, ValueKind::Buffer).apply);
+        assert(!SubtractNode::GetTable().Find(ValueKind::String, ValueKind::String).apply);
+        assert(DivideNode::GetTable().Find(ValueKind::Int, ValueKind::Int).result == ValueKind::Float);
+
+        assert(Evaluate<AddNode>(2, 3).GetInt() == 5);
+        assert(Evaluate<AddNode>(true, true).GetInt() == 2);
+        assert(Evaluate<AddNode>(2, 0.5).GetFloat() == 2.5);
+        assert(Evaluate<AddNode>("ab", std::string(30, 'c')).GetString().size() == 32);
+        assert(Evaluate<DivideNode>(1, 2).GetFloat() == 0.5);
+        assert(Evaluate<MultiplyNode>(FloatVector{1, 2, 3}, 2).GetVector()[2] == 6.0);
+        assert(Evaluate<SubtractNode>(FloatVector{1, 2}, FloatVector{1, 1}).GetVector()[1] == 1.0);
+
+        assert(Throws([] { Evaluate<SubtractNode>("a", "b"); }, "Unsupported operands: String and String"));
+        assert(Throws([] { Evaluate<SubtractNode>(Value(), 1); }, "Operand 'a' has no value"));
+        assert(Throws([] { Evaluate<AddNode>(FloatVector{1}, FloatVector{1, 2}); }, "Vectors differ in length"));
+
+        // An entry called with kinds other than the planned ones falls back to a lookup
+        Value out;
+        add.Find(ValueKind::Int, ValueKind::Int).apply(Value(1.5), Value(1), out);
+        assert(out.GetFloat() == 2.5);
+    }
+
+    struct Planning
+    {
+        std::shared_ptr<KernelRegistry> registry = std::make_shared<KernelRegistry>();
+        Graph graph{"Planning"};
+
+        Planning()
+        {
+            RegisterBuiltinNodes(*registry);
+            registry->Register("Text", [](ExecutionContext &context) { context.SetOutput("value", "x"); });
+            registry->Register("Number", [](ExecutionContext &context) { context.SetOutput("value", 1.5); });
+            registry->Register("Object", [](ExecutionContext &context) { context.SetOutput("value", 2.0); });
+        }
+
+        std::shared_ptr<const Node> Source(const char *kind, PinType type)
+        {
+            auto node = graph.CreateNode(UUID::generate(), kind, NodeType::Function);
+            node->AddOutputPin("value", type);
+            graph.AddNode(node);
+            return node;
+        }
+
+        std::shared_ptr<const Node> Subtract(const Node *a, const Node *b)
+        {
+            auto node = InstantiateNode<SubtractNode>(graph.GetPool());
+            graph.AddNode(node);
+            auto connect = [&](const Node *from, const char *input)
+            {
+                if (!from)
+                    return;
+                for (const auto &pair : node->inputPins)
+                    if (pair.second->name == Symbol(input))
+                        graph.AddLink(graph.CreateLink(UUID::generate(), from->outputPins.begin()->first, pair.first));
+            };
+            connect(a, "a");
+            connect(b, "b");
+            return node;
+        }
+
+        ExecutionResult Run(const Node &target)
+        {
+            Executor executor(registry, 1);
+            ExecutionRequest request;
+            request.targetPins = {target.outputPins.begin()->first};
+            return executor.Run(graph.Snapshot(), request);
+        }
+    };
+
+    void TestPlanning()
+    {
+        Planning planning;
+        auto text = planning.Source("Text", PinType::String);
+        auto number = planning.Source("Number", PinType::Float);
+        auto object = planning.Source("Object", PinType::Class);
+
+        // Kinds known from the pins and unsupported: rejected before anything runs
+        auto invalid = planning.Subtract(text.get(), number.get());
+        ExecutionResult result = planning.Run(*invalid);
+        assert(!result.success && result.nodesExecuted == 0);
+        assert(result.error == "ExecutionPlan: node 'Subtract': Unsupported operands: String and Float");
+
+        // An Object operand is only known at run time; so is the result computed from it
+        auto dynamic = planning.Subtract(object.get(), number.get());
+        auto downstream = planning.Subtract(dynamic.get(), number.get());
+        result = planning.Run(*downstream);
+        assert(result.success);
+        assert(result.outputs.at(downstream->outputPins.begin()->first).GetFloat() == -1.0);
+
+        // An unconnected operand is reported when the node runs
+        auto unconnected = planning.Subtract(nullptr, number.get());
+        result = planning.Run(*unconnected);
+        assert(!result.success && result.error.find("is not connected") != std::string::npos);
+    }
+} // namespace
+
+int main()
+{
+    TestValue();
+    TestOperatorTables();
+    TestPlanning();
+    std::printf("OperatorTest passed\n");
+    return 0;
+}
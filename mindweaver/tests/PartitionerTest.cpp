@@ -0,0 +1,117 @@
+// Partitioning plans across worker processes: chains stay together, independent branches split.
+
+#undef NDEBUG
+#include "core/Graph.h"
+#include "runtime/BuiltinNodes.h"
+#include "runtime/ExecutionPlan.h"
+#include "runtime/GraphPartitioner.h"
+
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace MindWeaver;
+
+namespace
+{
+    struct Chains
+    {
+        KernelRegistry registry;
+        Graph graph{"Chains"};
+
+        Chains()
+        {
+            RegisterBuiltinNodes(registry);
+            registry.Register("Number", [](ExecutionContext &context) { context.SetOutput("value", 1.0); });
+        }
+
+        UUID Pin(const Node &node, const char *name)
+        {
+            for (const auto &pair : node.inputPins)
+                if (pair.second->name == Symbol(name))
+                    return pair.first;
+            for (const auto &pair : node.outputPins)
+                if (pair.second->name == Symbol(name))
+                    return pair.first;
+            assert(false && "no such pin");
+            return UUID();
+        }
+
+        UUID Number()
+        {
+            auto node = graph.CreateNode(UUID::generate(), "Number", NodeType::Function);
+            node->AddOutputPin("value", PinType::Float);
+            graph.AddNode(node);
+            return node->outputPins.begin()->first;
+        }
+
+        /// @brief Adds a constant length times, each sum feeding the next; returns the sums.
+        std::vector<std::shared_ptr<const Node>> Chain(size_t length)
+        {
+            std::vector<std::shared_ptr<const Node>> sums;
+            UUID previous = Number();
+            for (size_t i = 0; i < length; ++i)
+            {
+                auto sum = InstantiateNode<AddNode>(graph.GetPool());
+                graph.AddNode(sum);
+                graph.AddLink(graph.CreateLink(UUID::generate(), previous, Pin(*sum, "a")));
+                graph.AddLink(graph.CreateLink(UUID::generate(), Number(), Pin(*sum, "b")));
+                previous = Pin(*sum, "result");
+                sums.push_back(sum);
+            }
+            return sums;
+        }
+
+        ExecutionPlan Plan() { return BuildExecutionPlan(graph.Snapshot(), registry, ExecutionRequest{}); }
+    };
+
+    void TestChainStaysTogether()
+    {
+        Chains chains;
+        chains.Chain(8);
+        const ExecutionPlan plan = chains.Plan();
+        const PartitionResult result = PartitionExecutionPlan(plan, 8);
+        assert(result.partitionCount == 1 && result.cutBytes == 0.0);
+        assert(result.loads.size() == 1 && result.loads[0] == static_cast<double>(plan.nodes.size()));
+    }
+
+    void TestBranchesSplit()
+    {
+        Chains chains;
+        std::vector<std::vector<std::shared_ptr<const Node>>> branches;
+        for (int i = 0; i < 4; ++i)
+            branches.push_back(chains.Chain(3));
+        const ExecutionPlan plan = chains.Plan();
+
+        std::unordered_map<UUID, size_t> index;
+        for (size_t i = 0; i < plan.nodes.size(); ++i)
+            index[plan.nodes[i].node->id] = i;
+
+        // Asking for more partitions than there are branches gains nothing
+        const PartitionResult result = PartitionExecutionPlan(plan, 8);
+        assert(result.partitionCount == 4 && result.cutBytes == 0.0);
+        std::set<uint32_t> used;
+        for (const auto &branch : branches)
+        {
+            const uint32_t p = result.assignment[index.at(branch.front()->id)];
+            for (const auto &sum : branch)
+                assert(result.assignment[index.at(sum->id)] == p);
+            used.insert(p);
+        }
+        assert(used.size() == 4);
+
+        const PartitionResult pair = PartitionExecutionPlan(plan, 2);
+        assert(pair.partitionCount == 2 && pair.cutBytes == 0.0);
+    }
+} // namespace
+
+int main()
+{
+    TestChainStaysTogether();
+    TestBranchesSplit();
+    std::printf("PartitionerTest passed\n");
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Resources loaded by kernels through the execution context stay cached across runs.
+
+#undef NDEBUG
+#include "core/Graph.h"
+#include "runtime/BuiltinNodes.h"
+#include "runtime/Executor.h"
+#include "runtime/ResourceCache.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace MindWeaver;
+
+namespace
+{
+    struct Weights
+    {
+        std::vector<double> values;
+    };
+
+    std::atomic<int> g_Loads{0};
+
+    ExecutionResult Run(Executor &executor, const Graph &graph, const UUID &target)
+    {
+        ExecutionRequest request;
+        request.targetPins = {target};
+        ExecutionResult result = executor.Run(graph.Snapshot(), request);
+        assert(result.success);
+        return result;
+    }
+
+    void TestModelNode()
+    {
+        auto registry = std::make_shared<KernelRegistry>();
+        registry->Register("Model",
+                           [](ExecutionContext &context)
+                           {
+                               auto weights = context.GetResourceCache().Acquire<Weights>(
+                                   {context.GetParameter("path"), "fp64"},
+                                   [](size_t &out_bytes)
+                                   {
+                                       ++g_Loads;
+                                       auto loaded = std::make_shared<Weights>();
+                                       loaded->values = {0.5, 1.5};
+                                       out_bytes = loaded->values.size() * sizeof(double);
+                                       return loaded;
+                                   });
+                               context.SetOutput("score", weights->values[0] + weights->values[1]);
+                           });
+
+        Graph graph("Model");
+        auto node = graph.CreateNode(UUID::generate(), "Model", NodeType::Function);
+        node->AddOutputPin("score", PinType::Float);
+        node->SetParameter("path", "weights.bin");
+        graph.AddNode(node);
+        const UUID score = node->outputPins.begin()->first;
+
+        auto cache = std::make_shared<ResourceCache>();
+        Executor executor(registry, 1);
+        executor.SetResourceCache(cache);
+        executor.SetCollectStats(true);
+
+        ExecutionResult first = Run(executor, graph, score);
+        assert(first.outputs.at(score).GetFloat() == 2.0 && g_Loads == 1);
+        assert(first.stats.Find(node->id)->cacheHits == 0);
+
+        // The second run finds the weights resident: a hit, and the loader is not called again
+        ExecutionResult second = Run(executor, graph, score);
+        assert(second.outputs.at(score).GetFloat() == 2.0 && g_Loads == 1);
+        assert(second.stats.Find(node->id)->cacheHits == 1);
+        const ResourceCacheStats stats = cache->GetStats();
+        assert(stats.hits == 1 && stats.misses == 1 && stats.entryCount == 1 && stats.bytesPinned == 0);
+        assert(!ResourceCache::Instance().Contains({"weights.bin", "fp64"}));
+    }
+
+    void TestLoadFileNode()
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "mindweaver_load_file_test.bin").string();
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "weights";
+        }
+
+        auto registry = std::make_shared<KernelRegistry>();
+        RegisterBuiltinNodes(*registry);
+        Graph graph("Files");
+        auto node = InstantiateNode<LoadFileNode>(graph.GetPool());
+        node->SetParameter("path", path);
+        graph.AddNode(node);
+        const UUID data = node->outputPins.begin()->first;
+
+        auto cache = std::make_shared<ResourceCache>();
+        Executor executor(registry, 1);
+        executor.SetResourceCache(cache);
+        for (int run = 0; run < 2; ++run)
+        {
+            ExecutionResult result = Run(executor, graph, data);
+            const Buffer &buffer = result.outputs.at(data).GetBuffer();
+            assert(buffer.shape.size() == 1 && buffer.shape[0] == 7);
+            assert(std::string(buffer.Data<char>(), 7) == "weights");
+        }
+        const ResourceCacheStats stats = cache->GetStats();
+        assert(stats.misses == 1 && stats.hits == 1 && stats.bytesResident == 7);
+
+        std::remove(path.c_str());
+    }
+} // namespace
+
+int main()
+{
+    TestModelNode();
+    TestLoadFileNode();
+    std::printf("ResourceCacheTest passed\n");
+    return 0;
+}
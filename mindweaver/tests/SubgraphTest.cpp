@@ -0,0 +1,288 @@
+// Subgraphs: collapsing and expanding, flattening for execution, and how inlined nodes report.
+
+#undef NDEBUG
+#include "core/Graph.h"
+#include "core/Subgraph.h"
+#include "runtime/BuiltinNodes.h"
+#include "runtime/ExecutionEvents.h"
+#include "runtime/Executor.h"
+#include "runtime/GraphOptimizer.h"
+
+#include <cassert>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace MindWeaver;
+
+namespace
+{
+    std::shared_ptr<KernelRegistry> MakeRegistry()
+    {
+        auto registry = std::make_shared<KernelRegistry>();
+        RegisterBuiltinNodes(*registry);
+        registry->Register("Number", [](ExecutionContext &context)
+                           { context.SetOutput("value", std::stod(context.GetParameter("value", "0"))); });
+        registry->Register("Check",
+                           [](ExecutionContext &context)
+                           {
+                               if (context.GetParameter("fail", "0") == "1")
+                                   throw std::runtime_error("check failed");
+                               context.SetOutput("out", context.GetInput("in"));
+                           });
+        return registry;
+    }
+
+    UUID PinID(const Node &node, const char *name)
+    {
+        for (const auto &pair : node.inputPins)
+            if (pair.second->name == Symbol(name))
+                return pair.first;
+        for (const auto &pair : node.outputPins)
+            if (pair.second->name == Symbol(name))
+                return pair.first;
+        assert(false && "no such pin");
+        return UUID();
+    }
+
+    /// @brief (a + b) * c, then checked: the graph the tests collapse in various ways.
+    struct Sample
+    {
+        Graph graph{"Sample"};
+        std::shared_ptr<const Node> a, b, c, sum, product, check;
+
+        explicit Sample(bool fail = false)
+        {
+            a = Number("2");
+            b = Number("3");
+            c = Number("4");
+            sum = Operator<AddNode>();
+            product = Operator<MultiplyNode>();
+            auto node = graph.CreateNode(UUID::generate(), "Check", NodeType::Function);
+            node->AddInputPin("in", PinType::Float);
+            node->AddOutputPin("out", PinType::Float);
+            node->SetParameter("fail", fail ? "1" : "0");
+            graph.AddNode(node);
+            check = node;
+
+            Connect(*a, "value", *sum, "a");
+            Connect(*b, "value", *sum, "b");
+            Connect(*sum, "result", *product, "a");
+            Connect(*c, "value", *product, "b");
+            Connect(*product, "result", *check, "in");
+        }
+
+        std::shared_ptr<const Node> Number(const char *value)
+        {
+            auto node = graph.CreateNode(UUID::generate(), "Number", NodeType::Function);
+            node->AddOutputPin("value", PinType::Float);
+            node->SetParameter("value", value);
+            graph.AddNode(node);
+            return node;
+        }
+
+        template <typename Kind> std::shared_ptr<const Node> Operator()
+        {
+            auto node = InstantiateNode<Kind>(graph.GetPool());
+            graph.AddNode(node);
+            return node;
+        }
+
+        void Connect(const Node &from, const char *output, const Node &to, const char *input)
+        {
+            graph.AddLink(graph.CreateLink(UUID::generate(), PinID(from, output), PinID(to, input)));
+        }
+    };
+
+    double Evaluate(Executor &executor, const GraphSnapshot &snapshot, const UUID &pin_id)
+    {
+        ExecutionRequest request;
+        request.targetPins = {pin_id};
+        ExecutionResult result = executor.Run(snapshot, request);
+        assert(result.success);
+        return result.outputs.at(pin_id).GetFloat();
+    }
+
+    void TestCollapseAndExpand()
+    {
+        Sample sample;
+        Graph &graph = sample.graph;
+        Executor executor(MakeRegistry(), 2);
+        const UUID result = PinID(*sample.check, "out");
+        assert(Evaluate(executor, graph.Snapshot(), result) == 20.0);
+
+        // The body takes the two operators; the numbers feeding them become the instance's inputs
+        auto inner = CollapseToSubgraph(graph, {sample.sum->id, sample.product->id}, "SumTimes");
+        assert(inner && inner->subgraph);
+        assert(inner->inputPins.size() == 3 && inner->outputPins.size() == 1);
+        assert(graph.GetNodes().size() == 5 && graph.GetLinks().size() == 4);
+        assert(Evaluate(executor, graph.Snapshot(), result) == 20.0);
+        assert(Evaluate(executor, graph.Snapshot(), inner->outputPins.begin()->first) == 20.0);
+
+        // A definition is flattened once, however many instances use it
+        assert(&inner->subgraph->GetFlattened() == &inner->subgraph->GetFlattened());
+
+        // Nested: the instance and the check go into an outer subgraph
+        auto outer = CollapseToSubgraph(graph, {inner->id, sample.check->id}, "Outer");
+        assert(outer && graph.GetNodes().size() == 4);
+        const UUID outer_result = outer->outputPins.begin()->first;
+        assert(Evaluate(executor, graph.Snapshot(), outer_result) == 20.0);
+
+        // Expanding puts the body back, with IDs derived from the instance
+        const std::vector<UUID> added = ExpandSubgraph(graph, outer->id);
+        assert(added.size() == 2);
+        const UUID expanded_result = UUID::derive(outer->id, result);
+        assert(Evaluate(executor, graph.Snapshot(), expanded_result) == 20.0);
+        for (const UUID &id : added)
+        {
+            if (graph.ResolveNode(graph.GetNode(id))->subgraph)
+                assert(ExpandSubgraph(graph, id).size() == 2);
+        }
+        assert(graph.GetNodes().size() == 6 && graph.GetLinks().size() == 5);
+        assert(Evaluate(executor, graph.Snapshot(), expanded_result) == 20.0);
+    }
+
+    void TestFlattening()
+    {
+        Sample sample;
+        Graph &graph = sample.graph;
+        auto inner = CollapseToSubgraph(graph, {sample.sum->id, sample.product->id}, "SumTimes");
+        auto outer = CollapseToSubgraph(graph, {inner->id, sample.check->id}, "Outer");
+
+        std::unordered_map<UUID, UUID> pins, owners;
+        const GraphSnapshot flat = InlineSubgraphs(graph.Snapshot(), &pins, &owners);
+        assert(flat.nodes.size() == 6 && flat.links.size() == 5);
+        for (const auto &node : flat.nodes)
+            assert(!node->subgraph);
+
+        // Every body node belongs to the outermost instance, however deeply it was nested
+        assert(owners.size() == 3);
+        for (const auto &pair : owners)
+            assert(pair.second == outer->id);
+
+        // The instance's pins lead to body pins
+        for (const auto &pair : outer->inputPins)
+            assert(pins.count(pair.first));
+        assert(pins.count(outer->outputPins.begin()->first));
+
+        // An instance whose pins do not line up with the body's ports, here in reverse order
+        auto reversed = graph.CreateNode(UUID::generate(), "Reversed", NodeType::Function);
+        reversed->subgraph = inner->subgraph;
+        std::vector<std::pair<Symbol, PinType>> inputs;
+        for (const auto &pair : inner->inputPins)
+            inputs.emplace_back(pair.second->name, pair.second->type);
+        for (auto it = inputs.rbegin(); it != inputs.rend(); ++it)
+            reversed->AddInputPin(it->first, it->second);
+        for (const auto &pair : inner->outputPins)
+            reversed->AddOutputPin(pair.second->name, pair.second->type);
+        graph.AddNode(reversed);
+        bool threw = false;
+        try
+        {
+            InlineSubgraphs(graph.Snapshot());
+        }
+        catch (const std::runtime_error &e)
+        {
+            threw = std::string(e.what()).find("does not match the ports") != std::string::npos;
+        }
+        assert(threw);
+    }
+
+    struct Observed
+    {
+        std::unordered_map<UUID, NodeStatus> last;
+        size_t running = 0;
+        size_t done = 0;
+    };
+
+    Observed RunObserved(Sample &sample, const UUID &instance, ExecutionResult &result)
+    {
+        auto events = std::make_shared<ExecutionEventChannel>();
+        Executor executor(MakeRegistry(), 3);
+        executor.SetEventChannel(events);
+        executor.SetCollectStats(true);
+        result = executor.Run(sample.graph.Snapshot());
+
+        std::unordered_set<UUID> shown;
+        for (const auto &node : sample.graph.GetNodes())
+            shown.insert(node->id);
+        Observed observed;
+        events->Drain(
+            [&](const ExecutionEvent &event)
+            {
+                assert(shown.count(event.nodeID)); // Only nodes the editor has
+                if (event.kind != ExecutionEventKind::Status)
+                    return;
+                observed.last[event.nodeID] = event.status;
+                if (event.nodeID == instance && event.status == NodeStatus::Running)
+                    ++observed.running;
+                if (event.nodeID == instance && event.status == NodeStatus::Done)
+                    ++observed.done;
+            });
+        return observed;
+    }
+
+    void TestReporting()
+    {
+        {
+            Sample sample;
+            auto inner = CollapseToSubgraph(sample.graph, {sample.sum->id, sample.product->id}, "SumTimes");
+            auto outer = CollapseToSubgraph(sample.graph, {inner->id, sample.check->id}, "Outer");
+            ExecutionResult result;
+            const Observed observed = RunObserved(sample, outer->id, result);
+            assert(result.success);
+            assert(observed.running == 1 && observed.done == 1);
+            assert(observed.last.at(outer->id) == NodeStatus::Done);
+
+            // Samples of the three body nodes are folded into the instance's
+            const NodeStats *stats = result.stats.Find(outer->id);
+            assert(stats && stats->calls == 3 && stats->name == Symbol("Outer"));
+        }
+        {
+            Sample sample(true);
+            auto outer = CollapseToSubgraph(sample.graph, {sample.product->id, sample.check->id}, "Failing");
+            ExecutionResult result;
+            const Observed observed = RunObserved(sample, outer->id, result);
+            assert(!result.success);
+            assert(observed.last.at(outer->id) == NodeStatus::Error);
+        }
+    }
+
+    void TestMergedNodeStats()
+    {
+        // Two identical numbers: elimination keeps one, and the other shows its stats
+        Sample sample;
+        auto twin = sample.Number("4");
+        auto sum = sample.Operator<AddNode>();
+        sample.Connect(*sample.c, "value", *sum, "a");
+        sample.Connect(*twin, "value", *sum, "b");
+
+        Executor executor(MakeRegistry(), 2);
+        executor.SetCollectStats(true);
+        ExecutionResult result = executor.Run(sample.graph.Snapshot());
+        assert(result.success);
+        const NodeStats *kept = result.stats.Find(sample.c->id);
+        const NodeStats *merged = result.stats.Find(twin->id);
+        assert(kept && merged && merged->calls == 1);
+
+        uint64_t thread_calls = 0;
+        for (const auto &thread : result.stats.GetThreads())
+            thread_calls += thread.calls;
+        assert(thread_calls == result.nodesExecuted); // Merged nodes are not counted twice
+    }
+} // namespace
+
+int main()
+{
+    TestCollapseAndExpand();
+    TestFlattening();
+    TestReporting();
+    TestMergedNodeStats();
+    std::printf("SubgraphTest passed\n");
+    return 0;
+}